@@ -50,8 +50,11 @@ struct ZstdDecompressionContext {
 static constexpr uint8_t DELTA_MAGIC[4] = { 'G', 'D', 'D', 'L' };
 static constexpr uint8_t DELTA_VERSION_NUMBER = 1;
 static constexpr size_t DELTA_HEADER_SIZE = 5;
+static constexpr int DELTA_MIN_WINDOW_LOG = 10; // ZSTD_WINDOWLOG_MIN, only exposed to static builds of Zstandard.
+
+Error DeltaEncoding::encode_delta(Span<uint8_t> p_old_data, Span<uint8_t> p_new_data, Vector<uint8_t> &r_delta, int p_compression_level, int p_max_window_log) {
+	ERR_FAIL_COND_V(p_max_window_log < DELTA_MIN_WINDOW_LOG || p_max_window_log > MAX_WINDOW_LOG, ERR_INVALID_PARAMETER);
 
-Error DeltaEncoding::encode_delta(Span<uint8_t> p_old_data, Span<uint8_t> p_new_data, Vector<uint8_t> &r_delta, int p_compression_level) {
 	size_t zstd_result = ZSTD_compressBound(p_new_data.size());
 	ERR_FAIL_ZSTD_V_MSG(zstd_result, FAILED, "Failed to encode delta. Calculating compression bounds failed.");
 
@@ -66,6 +69,15 @@ Error DeltaEncoding::encode_delta(Span<uint8_t> p_old_data, Span<uint8_t> p_new_
 	zstd_result = ZSTD_CCtx_setParameter(zstd_context, ZSTD_c_compressionLevel, p_compression_level);
 	ERR_FAIL_ZSTD_V_MSG(zstd_result, FAILED, "Failed to encode delta. Setting compression level failed.");
 
+	// Matches into the old data reach back over all of it, so the window should cover both,
+	// but it is capped so decoding never has to buffer more than the maximum window.
+	int window_log = DELTA_MIN_WINDOW_LOG;
+	while (window_log < p_max_window_log && (1ULL << window_log) < (uint64_t)p_old_data.size() + p_new_data.size()) {
+		window_log++;
+	}
+	zstd_result = ZSTD_CCtx_setParameter(zstd_context, ZSTD_c_windowLog, window_log);
+	ERR_FAIL_ZSTD_V_MSG(zstd_result, FAILED, "Failed to encode delta. Setting window size failed.");
+
 	zstd_result = ZSTD_CCtx_setPledgedSrcSize(zstd_context, p_new_data.size());
 	ERR_FAIL_ZSTD_V_MSG(zstd_result, FAILED, "Failed to encode delta. Setting pledged source size failed.");
 
@@ -104,6 +116,9 @@ Error DeltaEncoding::decode_delta(Span<uint8_t> p_old_data, Span<uint8_t> p_delt
 
 	ZstdDecompressionContext zstd_context;
 
+	zstd_result = ZSTD_DCtx_setParameter(zstd_context, ZSTD_d_windowLogMax, DeltaEncoding::MAX_WINDOW_LOG);
+	ERR_FAIL_ZSTD_V_MSG(zstd_result, FAILED, "Failed to decode delta. Setting maximum window size failed.");
+
 	zstd_result = ZSTD_DCtx_refPrefix(zstd_context, p_old_data.ptr(), p_old_data.size());
 	ERR_FAIL_ZSTD_V_MSG(zstd_result, FAILED, "Failed to decode delta. Setting prefix dictionary failed.");
 
@@ -113,3 +128,173 @@ Error DeltaEncoding::decode_delta(Span<uint8_t> p_old_data, Span<uint8_t> p_delt
 
 	return OK;
 }
+
+bool DeltaStreamDecoder::_fill_input() {
+	uint64_t remaining = delta_size - delta_read;
+	if (remaining == 0) {
+		return false;
+	}
+
+	uint64_t chunk_size = MIN(remaining, (uint64_t)input.size());
+	input_size = delta_file->get_buffer(input.ptr(), chunk_size);
+	input_pos = 0;
+	delta_read += input_size;
+	return input_size > 0;
+}
+
+Error DeltaStreamDecoder::open(Span<uint8_t> p_old_data, const Ref<FileAccess> &p_delta_file, uint64_t p_delta_size) {
+	close();
+
+	ERR_FAIL_COND_V(p_delta_file.is_null(), ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V_MSG(p_delta_size < DELTA_HEADER_SIZE, ERR_INVALID_DATA, vformat("Failed to decode delta. File size (%d) is too small.", p_delta_size));
+
+	uint8_t header[DELTA_HEADER_SIZE];
+	ERR_FAIL_COND_V(p_delta_file->get_buffer(header, DELTA_HEADER_SIZE) != DELTA_HEADER_SIZE, ERR_FILE_CANT_READ);
+
+	ERR_FAIL_COND_V_MSG(memcmp(header, DELTA_MAGIC, 4) != 0, ERR_FILE_CORRUPT, "Failed to decode delta. Header is invalid.");
+	ERR_FAIL_COND_V_MSG(header[4] != DELTA_VERSION_NUMBER, ERR_FILE_UNRECOGNIZED, vformat("Failed to decode delta. Expected version %d but found %d.", DELTA_VERSION_NUMBER, header[4]));
+
+	old_data = p_old_data;
+	delta_file = p_delta_file;
+	delta_start = p_delta_file->get_position();
+	delta_size = p_delta_size - DELTA_HEADER_SIZE;
+	delta_read = 0;
+	input.resize(ZSTD_DStreamInSize());
+
+	if (!_fill_input()) {
+		close();
+		ERR_FAIL_V_MSG(ERR_FILE_CANT_READ, "Failed to decode delta. Unable to read the compressed data.");
+	}
+
+	// The encoder always writes the content size, so the length is known before decoding anything.
+	unsigned long long content_size = ZSTD_getFrameContentSize(input.ptr(), input_size);
+	if (content_size == ZSTD_CONTENTSIZE_ERROR || content_size == ZSTD_CONTENTSIZE_UNKNOWN) {
+		close();
+		ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, "Failed to decode delta. Unable to find decompressed size.");
+	}
+	new_size = content_size;
+
+	context = ZSTD_createDCtx();
+	ERR_FAIL_NULL_V(context, ERR_OUT_OF_MEMORY);
+
+	// Refuse deltas that would need more than the maximum window buffered while decoding.
+	size_t zstd_result = ZSTD_DCtx_setParameter(context, ZSTD_d_windowLogMax, DeltaEncoding::MAX_WINDOW_LOG);
+	if (ZSTD_isError(zstd_result)) {
+		close();
+		ERR_FAIL_ZSTD_V_MSG(zstd_result, FAILED, "Failed to decode delta. Setting maximum window size failed.");
+	}
+
+	zstd_result = ZSTD_DCtx_refPrefix(context, old_data.ptr(), old_data.size());
+	if (ZSTD_isError(zstd_result)) {
+		close();
+		ERR_FAIL_ZSTD_V_MSG(zstd_result, FAILED, "Failed to decode delta. Setting prefix dictionary failed.");
+	}
+
+	position = 0;
+	finished = false;
+	return OK;
+}
+
+Error DeltaStreamDecoder::rewind() {
+	ERR_FAIL_NULL_V(context, ERR_UNCONFIGURED);
+
+	// A prefix only applies to a single frame, so it has to be referenced again after a reset.
+	size_t zstd_result = ZSTD_DCtx_reset(context, ZSTD_reset_session_only);
+	ERR_FAIL_ZSTD_V_MSG(zstd_result, FAILED, "Failed to rewind delta. Resetting the decoder failed.");
+	zstd_result = ZSTD_DCtx_refPrefix(context, old_data.ptr(), old_data.size());
+	ERR_FAIL_ZSTD_V_MSG(zstd_result, FAILED, "Failed to rewind delta. Setting prefix dictionary failed.");
+
+	delta_file->seek(delta_start);
+	delta_read = 0;
+	input_pos = 0;
+	input_size = 0;
+	position = 0;
+	finished = false;
+	return OK;
+}
+
+void DeltaStreamDecoder::close() {
+	if (context) {
+		ZSTD_freeDCtx(context);
+		context = nullptr;
+	}
+
+	old_data = Span<uint8_t>();
+	delta_file.unref();
+	input.clear();
+	skip_buffer.clear();
+	input_pos = 0;
+	input_size = 0;
+	new_size = 0;
+	position = 0;
+	finished = false;
+}
+
+uint64_t DeltaStreamDecoder::read(uint8_t *p_dst, uint64_t p_length, Error *r_error) {
+	if (r_error) {
+		*r_error = OK;
+	}
+	ERR_FAIL_NULL_V(context, 0);
+
+	uint64_t produced = 0;
+	while (produced < p_length && !finished) {
+		if (input_pos == input_size && !_fill_input() && position == new_size) {
+			break;
+		}
+
+		ZSTD_inBuffer in = { input.ptr(), (size_t)input_size, (size_t)input_pos };
+		ZSTD_outBuffer out = { p_dst + produced, (size_t)(p_length - produced), 0 };
+
+		size_t zstd_result = ZSTD_decompressStream(context, &out, &in);
+		if (ZSTD_isError(zstd_result)) {
+			if (r_error) {
+				*r_error = ERR_FILE_CORRUPT;
+			}
+			ERR_FAIL_ZSTD_V_MSG(zstd_result, produced, "Failed to decode delta. Decompression failed.");
+		}
+
+		input_pos = in.pos;
+		produced += out.pos;
+		position += out.pos;
+
+		if (zstd_result == 0) {
+			finished = true;
+		} else if (out.pos == 0 && input_pos == input_size && delta_read == delta_size) {
+			// No input left and nothing was produced, so the frame was cut short.
+			if (r_error) {
+				*r_error = ERR_FILE_CORRUPT;
+			}
+			ERR_FAIL_V_MSG(produced, "Failed to decode delta. Compressed data is truncated.");
+		}
+	}
+
+	if (finished && position != new_size) {
+		if (r_error) {
+			*r_error = ERR_FILE_CORRUPT;
+		}
+		ERR_FAIL_V_MSG(produced, vformat("Failed to decode delta. Expected %d bytes but decoded %d.", new_size, position));
+	}
+
+	return produced;
+}
+
+Error DeltaStreamDecoder::skip(uint64_t p_length) {
+	if (skip_buffer.is_empty()) {
+		skip_buffer.resize(ZSTD_DStreamOutSize());
+	}
+
+	while (p_length > 0) {
+		uint64_t chunk_size = MIN(p_length, (uint64_t)skip_buffer.size());
+		Error err = OK;
+		uint64_t skipped = read(skip_buffer.ptr(), chunk_size, &err);
+		if (err != OK) {
+			return err;
+		}
+		if (skipped < chunk_size) {
+			return ERR_FILE_EOF;
+		}
+		p_length -= skipped;
+	}
+
+	return OK;
+}
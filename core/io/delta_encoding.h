@@ -31,9 +31,54 @@
 #pragma once
 
 #include "core/io/file_access.h"
+#include "core/templates/local_vector.h"
+
+struct ZSTD_DCtx_s;
 
 class DeltaEncoding {
 public:
-	static Error encode_delta(Span<uint8_t> p_old_data, Span<uint8_t> p_new_data, Vector<uint8_t> &r_delta, int p_compression_level = 19);
+	// Decoders keep at most this much of the new data buffered, and reject deltas with a larger window.
+	static constexpr int MAX_WINDOW_LOG = 27;
+
+	static Error encode_delta(Span<uint8_t> p_old_data, Span<uint8_t> p_new_data, Vector<uint8_t> &r_delta, int p_compression_level = 19, int p_max_window_log = MAX_WINDOW_LOG);
 	static Error decode_delta(Span<uint8_t> p_old_data, Span<uint8_t> p_delta, Vector<uint8_t> &r_new_data);
 };
+
+// Decodes a delta read from a file in chunks, producing the new data in order. Only the
+// last window of new data is kept, so memory use is bounded by the delta's window size
+// (at most 2^MAX_WINDOW_LOG bytes), not by the size of the new data. The old data must
+// outlive the decoder.
+class DeltaStreamDecoder {
+	ZSTD_DCtx_s *context = nullptr;
+	Span<uint8_t> old_data;
+
+	Ref<FileAccess> delta_file;
+	uint64_t delta_start = 0;
+	uint64_t delta_size = 0;
+	uint64_t delta_read = 0;
+
+	LocalVector<uint8_t> input;
+	uint64_t input_pos = 0;
+	uint64_t input_size = 0;
+	LocalVector<uint8_t> skip_buffer;
+
+	uint64_t new_size = 0;
+	uint64_t position = 0;
+	bool finished = false;
+
+	bool _fill_input();
+
+public:
+	Error open(Span<uint8_t> p_old_data, const Ref<FileAccess> &p_delta_file, uint64_t p_delta_size);
+	Error rewind();
+	void close();
+
+	uint64_t read(uint8_t *p_dst, uint64_t p_length, Error *r_error = nullptr);
+	Error skip(uint64_t p_length);
+
+	bool is_open() const { return context != nullptr; }
+	uint64_t get_new_size() const { return new_size; }
+	uint64_t get_position() const { return position; }
+
+	~DeltaStreamDecoder() { close(); }
+};
@@ -191,6 +191,16 @@ public:
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const = 0; ///< get an array of bytes, needs to be overwritten by children.
 	Vector<uint8_t> get_buffer(int64_t p_length) const;
+	// Returns a pointer to the next p_length bytes and advances the position past them, without copying.
+	// The pointer stays valid until the file is closed. Returns nullptr if the implementation can't
+	// expose its contents directly or fewer bytes are left, in which case the position is unchanged.
+	virtual const uint8_t *get_buffer_view(uint64_t p_length) const { return nullptr; }
+	// Restricts buffer views to a range of the file, so only that range needs to be mapped,
+	// e.g. a single entry of a pack. Must be called before the first view is requested.
+	virtual void set_buffer_view_range(uint64_t p_offset, uint64_t p_length) {}
+	// Hints that the given byte range will be read soon, so the OS can start fetching it in the background.
+	// Doesn't read anything itself, and does nothing if the implementation has no such hint.
+	virtual void advise_will_need(uint64_t p_offset, uint64_t p_length) const {}
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
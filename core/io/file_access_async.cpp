@@ -0,0 +1,335 @@
+/**************************************************************************/
+/*  file_access_async.cpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "file_access_async.h"
+
+#include "core/io/file_access.h"
+#include "core/io/file_access_pack.h"
+#include "core/io/resource_importer.h"
+#include "core/io/resource_loader.h"
+#include "core/templates/local_vector.h"
+
+BinaryMutex FileAccessAsync::mutex;
+ConditionVariable FileAccessAsync::request_completed;
+Semaphore FileAccessAsync::semaphore;
+Thread FileAccessAsync::threads[IO_THREAD_COUNT];
+bool FileAccessAsync::threads_started = false;
+bool FileAccessAsync::exit_threads = false;
+
+List<FileAccessAsync::Request *> FileAccessAsync::queue;
+HashMap<FileAccessAsync::RequestID, FileAccessAsync::Request *> FileAccessAsync::requests;
+HashSet<String> FileAccessAsync::queued_prefetches;
+FileAccessAsync::RequestID FileAccessAsync::last_request_id = 0;
+
+FileAccessAsync::Request *FileAccessAsync::_create_prefetch(const String &p_path, bool p_resource_path) {
+	Request *request = memnew(Request);
+	request->prefetch = true;
+	request->prefetch_path = p_path;
+
+	String path = p_path;
+	if (p_resource_path) {
+		path = ResourceLoader::path_remap(path);
+		if (ResourceFormatImporter::get_singleton() && FileAccess::exists(path + ".import")) {
+			String internal_path = ResourceFormatImporter::get_singleton()->get_internal_resource_path(path);
+			if (!internal_path.is_empty()) {
+				path = internal_path;
+			}
+		}
+	}
+
+	// Only the raw bytes are hinted to the OS, opening a packed file could decrypt or decompress it.
+	PackedData *packed_data = PackedData::get_singleton();
+	PackedData::PackedFile pf;
+	if (packed_data && !packed_data->is_disabled() && packed_data->get_packed_file(path, pf) && pf.offset != 0) {
+		request->skip_pack = true;
+		request->read.length = pf.size;
+		if (pf.bundle) {
+			request->read.path = path.simplify_path();
+		} else {
+			request->read.path = pf.pack;
+			request->read.offset = pf.offset;
+			request->compressed = pf.compressed && !pf.encrypted;
+		}
+		return request;
+	}
+
+	// Files from a directory pack or the file system are opened as they are.
+	request->read.path = path;
+	return request;
+}
+
+void FileAccessAsync::_prefetch_file(const Request *p_request) {
+	Ref<FileAccess> f = FileAccess::open(p_request->read.path, FileAccess::READ | (p_request->skip_pack ? FileAccess::SKIP_PACK : 0));
+	if (f.is_null()) {
+		return;
+	}
+
+	uint64_t length = p_request->read.length >= 0 ? (uint64_t)p_request->read.length : f->get_length();
+	if (p_request->compressed) {
+		// Skip the magic, then add up the block sizes that follow the block header.
+		f->seek(p_request->read.offset + 4);
+		f->get_32(); // Compression mode.
+		uint32_t block_size = f->get_32();
+		uint32_t total = f->get_32();
+		if (block_size == 0 || f->eof_reached()) {
+			return;
+		}
+		uint32_t block_count = total / block_size + 1;
+		length = 4 + 3 * 4 + block_count * 4;
+		for (uint32_t i = 0; i < block_count && !f->eof_reached(); i++) {
+			length += f->get_32();
+		}
+	}
+	f->advise_will_need(p_request->read.offset, MIN(length, PREFETCH_MAX_SIZE));
+}
+
+void FileAccessAsync::_process_request(Request *p_request) {
+	if (p_request->prefetch) {
+		_prefetch_file(p_request);
+		return;
+	}
+
+	Ref<FileAccess> f = FileAccess::open(p_request->read.path, FileAccess::READ, &p_request->error);
+	if (f.is_null()) {
+		return;
+	}
+	uint64_t file_length = f->get_length();
+
+	if (p_request->read.offset > file_length) {
+		p_request->error = ERR_INVALID_PARAMETER;
+		return;
+	}
+	uint64_t length = file_length - p_request->read.offset;
+	if (p_request->read.length >= 0) {
+		length = MIN(length, (uint64_t)p_request->read.length);
+	}
+
+	p_request->data.resize(length);
+	f->seek(p_request->read.offset);
+	uint64_t read = f->get_buffer(p_request->data.ptrw(), length);
+	if (read != length) {
+		p_request->data.clear();
+		p_request->error = ERR_FILE_CANT_READ;
+	}
+}
+
+void FileAccessAsync::_thread_function(void *p_userdata) {
+	while (true) {
+		semaphore.wait();
+
+		MutexLock lock(mutex);
+		if (exit_threads) {
+			break;
+		}
+		if (queue.is_empty()) {
+			continue;
+		}
+		Request *request = queue.front()->get();
+		queue.pop_front();
+
+		// Only the queue needs the lock, the read itself runs unlocked.
+		lock.temp_unlock();
+		_process_request(request);
+		lock.temp_relock();
+
+		if (request->prefetch) {
+			queued_prefetches.erase(request->prefetch_path);
+			memdelete(request);
+		} else {
+			request->completed = true;
+			request_completed.notify_all();
+		}
+	}
+}
+
+void FileAccessAsync::_start_threads() {
+	if (threads_started) {
+		return;
+	}
+	for (int i = 0; i < IO_THREAD_COUNT; i++) {
+		threads[i].start(_thread_function, nullptr);
+	}
+	threads_started = true;
+}
+
+Vector<FileAccessAsync::RequestID> FileAccessAsync::submit_reads(const Vector<ReadRequest> &p_reads) {
+	Vector<RequestID> ids;
+	ids.resize(p_reads.size());
+	LocalVector<Request *> synchronous_requests;
+
+	{
+		MutexLock lock(mutex);
+#ifdef THREADS_ENABLED
+		// Once finalized, reads are still honored, just synchronously.
+		const bool synchronous = exit_threads;
+#else
+		const bool synchronous = true;
+#endif
+
+		for (int i = 0; i < p_reads.size(); i++) {
+			Request *request = memnew(Request);
+			request->read = p_reads[i];
+			ids.write[i] = ++last_request_id;
+			requests.insert(ids[i], request);
+			if (synchronous) {
+				synchronous_requests.push_back(request);
+			} else {
+				queue.push_back(request);
+			}
+		}
+
+		if (!synchronous) {
+			_start_threads();
+			for (int i = 0; i < p_reads.size(); i++) {
+				semaphore.post();
+			}
+			return ids;
+		}
+	}
+
+	// Read without the lock, like the I/O threads do, so other callers aren't held up.
+	for (Request *request : synchronous_requests) {
+		_process_request(request);
+	}
+
+	MutexLock lock(mutex);
+	for (Request *request : synchronous_requests) {
+		request->completed = true;
+	}
+	request_completed.notify_all();
+	return ids;
+}
+
+FileAccessAsync::RequestID FileAccessAsync::submit_read(const String &p_path, uint64_t p_offset, int64_t p_length) {
+	ReadRequest read;
+	read.path = p_path;
+	read.offset = p_offset;
+	read.length = p_length;
+	return submit_reads({ read })[0];
+}
+
+bool FileAccessAsync::is_read_completed(RequestID p_id) {
+	MutexLock lock(mutex);
+	HashMap<RequestID, Request *>::Iterator E = requests.find(p_id);
+	ERR_FAIL_COND_V_MSG(!E, false, vformat("Invalid asynchronous read request ID: %d.", p_id));
+	return E->value->completed;
+}
+
+Vector<uint8_t> FileAccessAsync::complete_read(RequestID p_id, Error *r_error) {
+	MutexLock lock(mutex);
+	HashMap<RequestID, Request *>::Iterator E = requests.find(p_id);
+	if (!E) {
+		if (r_error) {
+			*r_error = ERR_INVALID_PARAMETER;
+		}
+		ERR_FAIL_V_MSG(Vector<uint8_t>(), vformat("Invalid asynchronous read request ID: %d.", p_id));
+	}
+
+	Request *request = E->value;
+	while (!request->completed) {
+		request_completed.wait(lock);
+	}
+	requests.erase(p_id);
+
+	Vector<uint8_t> data = request->data;
+	if (r_error) {
+		*r_error = request->error;
+	}
+	memdelete(request);
+	return data;
+}
+
+void FileAccessAsync::_enqueue_prefetches(const Vector<String> &p_paths, bool p_resource_paths) {
+#ifdef THREADS_ENABLED
+	LocalVector<Request *> prefetches;
+	for (const String &path : p_paths) {
+		prefetches.push_back(_create_prefetch(path, p_resource_paths));
+	}
+
+	MutexLock lock(mutex);
+	int queued = 0;
+	for (Request *request : prefetches) {
+		if (exit_threads || queued_prefetches.has(request->prefetch_path)) {
+			memdelete(request);
+			continue;
+		}
+		queued_prefetches.insert(request->prefetch_path);
+		queue.push_back(request);
+		queued++;
+	}
+
+	if (queued > 0) {
+		_start_threads();
+		for (int i = 0; i < queued; i++) {
+			semaphore.post();
+		}
+	}
+#endif
+}
+
+void FileAccessAsync::prefetch(const Vector<String> &p_paths) {
+	_enqueue_prefetches(p_paths, false);
+}
+
+void FileAccessAsync::prefetch_resources(const Vector<String> &p_paths) {
+	_enqueue_prefetches(p_paths, true);
+}
+
+void FileAccessAsync::finalize() {
+	{
+		MutexLock lock(mutex);
+		exit_threads = true;
+	}
+
+	if (threads_started) {
+		for (int i = 0; i < IO_THREAD_COUNT; i++) {
+			semaphore.post();
+		}
+		for (int i = 0; i < IO_THREAD_COUNT; i++) {
+			threads[i].wait_to_finish();
+		}
+		threads_started = false;
+	}
+
+	// Anything still queued will never run. Reads fail so callers waiting in complete_read()
+	// wake up, and stay registered until collected, as their IDs may still be in use.
+	MutexLock lock(mutex);
+	for (Request *request : queue) {
+		if (request->prefetch) {
+			memdelete(request);
+		} else {
+			request->error = ERR_UNAVAILABLE;
+			request->completed = true;
+		}
+	}
+	queue.clear();
+	queued_prefetches.clear();
+	request_completed.notify_all();
+}
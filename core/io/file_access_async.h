@@ -0,0 +1,104 @@
+/**************************************************************************/
+/*  file_access_async.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/condition_variable.h"
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
+#include "core/string/ustring.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/list.h"
+#include "core/templates/vector.h"
+
+// Reads files on a small pool of dedicated I/O threads, so worker threads can
+// keep doing CPU work while the disk seeks. Reads are submitted in batches and
+// completed later; prefetches only ask the OS to start caching files that are
+// about to be opened and don't read any data themselves.
+class FileAccessAsync {
+public:
+	typedef int64_t RequestID;
+	static constexpr RequestID INVALID_REQUEST_ID = -1;
+
+	struct ReadRequest {
+		String path;
+		uint64_t offset = 0;
+		int64_t length = -1; // Until the end of the file.
+	};
+
+private:
+	// Paths are resolved by the submitting thread, the I/O threads only open final paths.
+	struct Request {
+		ReadRequest read; // For prefetches, the range of the file to hint.
+		String prefetch_path; // As passed to prefetch(), to skip prefetches already queued.
+		bool prefetch = false;
+		bool skip_pack = false;
+		bool compressed = false; // The length is the uncompressed size, read the stored size from the header.
+		bool completed = false;
+		Error error = OK;
+		Vector<uint8_t> data;
+	};
+
+	static constexpr int IO_THREAD_COUNT = 2;
+	static constexpr uint64_t PREFETCH_MAX_SIZE = 64 * 1024 * 1024;
+
+	static BinaryMutex mutex;
+	static ConditionVariable request_completed;
+	static Semaphore semaphore;
+	static Thread threads[IO_THREAD_COUNT];
+	static bool threads_started;
+	static bool exit_threads;
+
+	static List<Request *> queue;
+	static HashMap<RequestID, Request *> requests;
+	static HashSet<String> queued_prefetches;
+	static RequestID last_request_id;
+
+	static void _thread_function(void *p_userdata);
+	static void _start_threads();
+	static Request *_create_prefetch(const String &p_path, bool p_resource_path);
+	static void _prefetch_file(const Request *p_request);
+	static void _process_request(Request *p_request);
+	static void _enqueue_prefetches(const Vector<String> &p_paths, bool p_resource_paths);
+
+public:
+	static Vector<RequestID> submit_reads(const Vector<ReadRequest> &p_reads);
+	static RequestID submit_read(const String &p_path, uint64_t p_offset = 0, int64_t p_length = -1);
+	static bool is_read_completed(RequestID p_id);
+	static Vector<uint8_t> complete_read(RequestID p_id, Error *r_error = nullptr);
+
+	static void prefetch(const Vector<String> &p_paths);
+	// Like prefetch(), but maps resource paths to the files actually loaded, e.g. imported data.
+	static void prefetch_resources(const Vector<String> &p_paths);
+
+	static void finalize();
+};
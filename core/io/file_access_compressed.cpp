@@ -30,6 +30,8 @@
 
 #include "file_access_compressed.h"
 
+#include "core/io/marshalls.h"
+
 void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_mode, uint32_t p_block_size) {
 	magic = p_magic.ascii().get_data();
 	magic = (magic + "    ").substr(0, 4);
@@ -38,6 +40,50 @@ void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_
 	block_size = p_block_size;
 }
 
+Vector<uint8_t> FileAccessCompressed::compress_buffer(const uint8_t *p_data, uint64_t p_length, const String &p_magic, Compression::Mode p_mode, uint32_t p_block_size) {
+	ERR_FAIL_COND_V(p_block_size == 0, Vector<uint8_t>());
+	ERR_FAIL_COND_V_MSG(p_length > UINT32_MAX, Vector<uint8_t>(), "FileAccessCompressed: Data is too large to be stored compressed.");
+
+	CharString mgc = (String(p_magic.ascii().get_data()) + "    ").substr(0, 4).ascii();
+	const uint32_t bc = (p_length / p_block_size) + 1;
+	const uint32_t last_block_size = p_length % p_block_size;
+
+	// Header: magic, compression mode, block size, uncompressed size, then the size of every compressed block.
+	LocalVector<uint8_t> out;
+	out.resize(16 + bc * 4);
+	memcpy(out.ptr(), mgc.get_data(), 4);
+	encode_uint32(p_mode, &out[4]);
+	encode_uint32(p_block_size, &out[8]);
+	encode_uint32(uint32_t(p_length), &out[12]);
+
+	// Temporary buffer for compressed data blocks.
+	LocalVector<uint8_t> temp_cblock;
+	temp_cblock.resize(Compression::get_max_compressed_buffer_size(bc == 1 ? last_block_size : p_block_size, p_mode));
+	uint8_t *temp_cblock_ptr = temp_cblock.ptr();
+
+	// Compress and append the blocks, the block table is filled in as we go.
+	for (uint32_t i = 0; i < bc; i++) {
+		uint32_t bl = i == (bc - 1) ? last_block_size : p_block_size;
+		const int64_t compressed_size = Compression::compress(temp_cblock_ptr, p_data + uint64_t(i) * p_block_size, bl, p_mode);
+		ERR_FAIL_COND_V(compressed_size < 0, Vector<uint8_t>());
+
+		encode_uint32(uint32_t(compressed_size), &out[16 + i * 4]);
+		uint32_t ofs = out.size();
+		out.resize(ofs + compressed_size);
+		memcpy(out.ptr() + ofs, temp_cblock_ptr, compressed_size);
+	}
+
+	// Magic at the end too.
+	uint32_t ofs = out.size();
+	out.resize(ofs + 4);
+	memcpy(out.ptr() + ofs, mgc.get_data(), 4);
+
+	Vector<uint8_t> ret;
+	ret.resize(out.size());
+	memcpy(ret.ptrw(), out.ptr(), out.size());
+	return ret;
+}
+
 Error FileAccessCompressed::open_after_magic(Ref<FileAccess> p_base) {
 	f = p_base;
 	cmode = (Compression::Mode)f->get_32();
@@ -118,44 +164,12 @@ void FileAccessCompressed::_close() {
 
 	if (writing) {
 		//save block table and all compressed blocks
-
-		CharString mgc = magic.utf8();
-		f->store_buffer((const uint8_t *)mgc.get_data(), mgc.length()); //write header 4
-		f->store_32(cmode); //write compression mode 4
-		f->store_32(block_size); //write block size 4
-		f->store_32(uint32_t(write_max)); //max amount of data written 4
-		uint32_t bc = (write_max / block_size) + 1;
-
-		for (uint32_t i = 0; i < bc; i++) {
-			f->store_32(0); //compressed sizes, will update later
-		}
-
-		uint32_t last_block_size = write_max % block_size;
-
-		// Temporary buffer for compressed data blocks.
-		LocalVector<uint8_t> temp_cblock;
-		temp_cblock.resize(Compression::get_max_compressed_buffer_size(bc == 1 ? last_block_size : block_size, cmode));
-		uint8_t *temp_cblock_ptr = temp_cblock.ptr();
-
-		// Compress and store the blocks.
-		LocalVector<uint32_t> block_sizes;
-		for (uint32_t i = 0; i < bc; i++) {
-			uint32_t bl = i == (bc - 1) ? last_block_size : block_size;
-			uint8_t *bp = &write_ptr[i * block_size];
-
-			const int64_t compressed_size = Compression::compress(temp_cblock_ptr, bp, bl, cmode);
-			ERR_FAIL_COND_MSG(compressed_size < 0, "FileAccessCompressed: Error compressing data.");
-
-			f->store_buffer(temp_cblock_ptr, (uint64_t)compressed_size);
-			block_sizes.push_back(compressed_size);
-		}
-
-		f->seek(16); //ok write block sizes
-		for (uint32_t i = 0; i < bc; i++) {
-			f->store_32(block_sizes[i]);
+		Vector<uint8_t> data = compress_buffer(write_ptr, write_max, magic, cmode, block_size);
+		if (data.is_empty()) {
+			ERR_PRINT("FileAccessCompressed: Error compressing data.");
+		} else {
+			f->store_buffer(data);
 		}
-		f->seek_end();
-		f->store_buffer((const uint8_t *)mgc.get_data(), mgc.length()); //magic at the end too
 	} else {
 		comp_buffer.clear();
 		read_blocks.clear();
@@ -55,8 +55,13 @@ enum PackFileFlags {
 	PACK_FILE_ENCRYPTED = 1 << 0,
 	PACK_FILE_REMOVAL = 1 << 1,
 	PACK_FILE_DELTA = 1 << 2,
+	PACK_FILE_COMPRESSED = 1 << 3,
 };
 
+// Compressed entries are stored in the FileAccessCompressed block format, so they stay seekable.
+#define PACK_FILE_COMPRESSED_MAGIC "GCPK"
+#define PACK_FILE_COMPRESSION_BLOCK_SIZE (64 * 1024)
+
 class PackSource;
 
 class PackedData {
@@ -74,6 +79,7 @@ public:
 		bool encrypted;
 		bool bundle;
 		bool delta;
+		bool compressed;
 	};
 
 private:
@@ -119,7 +125,7 @@ private:
 
 public:
 	void add_pack_source(PackSource *p_source);
-	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_bundle = false, bool p_delta = false); // for PackSource
+	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_bundle = false, bool p_delta = false, bool p_compressed = false); // for PackSource
 	void remove_path(const String &p_path);
 	uint8_t *get_file_hash(const String &p_path);
 	Vector<PackedFile> get_delta_patches(const String &p_path) const;
@@ -136,6 +142,8 @@ public:
 
 	_FORCE_INLINE_ Ref<FileAccess> try_open_path(const String &p_path);
 	_FORCE_INLINE_ bool has_path(const String &p_path);
+	// Looks up where a packed file is stored, without opening it.
+	_FORCE_INLINE_ bool get_packed_file(const String &p_path, PackedFile &r_file);
 
 	_FORCE_INLINE_ int64_t get_size(const String &p_path);
 
@@ -203,6 +211,7 @@ public:
 	virtual bool eof_reached() const override;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_buffer_view(uint64_t p_length) const override;
 
 	virtual void set_big_endian(bool p_big_endian) override;
 
@@ -247,6 +256,15 @@ bool PackedData::has_path(const String &p_path) {
 	return files.has(PathMD5(p_path.simplify_path().trim_prefix("res://").md5_buffer()));
 }
 
+bool PackedData::get_packed_file(const String &p_path, PackedFile &r_file) {
+	HashMap<PathMD5, PackedFile, PathMD5>::Iterator E = files.find(PathMD5(p_path.simplify_path().trim_prefix("res://").md5_buffer()));
+	if (!E) {
+		return false;
+	}
+	r_file = E->value;
+	return true;
+}
+
 bool PackedData::has_directory(const String &p_path) {
 	Ref<DirAccess> da = try_open_directory(p_path);
 	if (da.is_valid()) {
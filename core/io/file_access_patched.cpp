@@ -32,53 +32,89 @@
 
 #include "file_access_pack.h"
 
-#include "core/io/delta_encoding.h"
 #include "core/os/os.h"
 
+static Ref<FileAccess> _open_delta_patch(const String &p_path, const PackedData::PackedFile &p_delta_patch, Error &r_error) {
+	// Going through the pack takes care of patches that were stored encrypted.
+	Ref<FileAccess> patch_file = memnew(FileAccessPack(p_path, p_delta_patch));
+	r_error = patch_file->is_open() ? OK : ERR_FILE_CANT_OPEN;
+	return patch_file;
+}
+
 Error FileAccessPatched::_apply_patch() const {
 	ERR_FAIL_COND_V(!is_open(), FAILED);
 
 	String path = old_file->get_path();
 	Vector<PackedData::PackedFile> delta_patches = PackedData::get_singleton()->get_delta_patches(path);
-	Vector<uint8_t> old_file_data = old_file->get_buffer(old_file->get_length());
+	ERR_FAIL_COND_V(delta_patches.is_empty(), FAILED);
+
+	uint64_t total_usec_start = OS::get_singleton()->get_ticks_usec();
+
+	// With a single patch the old data can be taken straight from a memory-mapped pack.
+	Span<uint8_t> old_data;
+	bool old_data_viewed = false;
+	if (delta_patches.size() == 1) {
+		uint64_t old_length = old_file->get_length();
+		old_file->seek(0);
+		const uint8_t *view = old_file->get_buffer_view(old_length);
+		if (view) {
+			old_data = Span<uint8_t>(view, old_length);
+			old_data_viewed = true;
+		}
+	}
 
-	for (int i = 0; i < delta_patches.size(); ++i) {
-		const PackedData::PackedFile &delta_patch = delta_patches[i];
-		ERR_FAIL_COND_V(delta_patch.bundle, FAILED);
+	if (!old_data_viewed) {
+		old_file->seek(0);
+		old_file_data = old_file->get_buffer(old_file->get_length());
 
-		Error err = OK;
+		// Every patch but the last one is needed in full, since it's what the next one refers to.
+		for (int i = 0; i < delta_patches.size() - 1; ++i) {
+			const PackedData::PackedFile &delta_patch = delta_patches[i];
+			ERR_FAIL_COND_V(delta_patch.bundle, FAILED);
 
-		uint64_t total_usec_start = OS::get_singleton()->get_ticks_usec();
-		uint64_t io_usec_start = OS::get_singleton()->get_ticks_usec();
+			Error err = OK;
 
-		Ref<FileAccess> patch_file = FileAccess::open(delta_patch.pack, FileAccess::READ, &err);
-		ERR_FAIL_COND_V(err != OK, err);
+			uint64_t io_usec_start = OS::get_singleton()->get_ticks_usec();
 
-		patch_file->seek(delta_patch.offset);
-		ERR_FAIL_COND_V(patch_file->get_error() != OK, patch_file->get_error());
+			Ref<FileAccess> intermediate_patch_file = _open_delta_patch(path, delta_patch, err);
+			ERR_FAIL_COND_V(err != OK, err);
 
-		Vector<uint8_t> patch_data = patch_file->get_buffer(delta_patch.size);
-		ERR_FAIL_COND_V(patch_data.is_empty(), ERR_FILE_CANT_READ);
+			Vector<uint8_t> patch_data = intermediate_patch_file->get_buffer(delta_patch.size);
+			ERR_FAIL_COND_V(patch_data.is_empty(), ERR_FILE_CANT_READ);
 
-		uint64_t io_usec_end = OS::get_singleton()->get_ticks_usec();
-		uint64_t decode_usec_start = OS::get_singleton()->get_ticks_usec();
+			uint64_t io_usec_end = OS::get_singleton()->get_ticks_usec();
+			uint64_t decode_usec_start = OS::get_singleton()->get_ticks_usec();
 
-		Vector<uint8_t> new_file_data;
-		err = DeltaEncoding::decode_delta(old_file_data, patch_data, new_file_data);
-		ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Failed to apply delta patch (%d of %d) to \"%s\".", i + 1, delta_patches.size(), path));
+			Vector<uint8_t> new_file_data;
+			err = DeltaEncoding::decode_delta(old_file_data, patch_data, new_file_data);
+			ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Failed to apply delta patch (%d of %d) to \"%s\".", i + 1, delta_patches.size(), path));
 
-		uint64_t decode_usec_end = OS::get_singleton()->get_ticks_usec();
+			uint64_t decode_usec_end = OS::get_singleton()->get_ticks_usec();
 
-		old_file_data = new_file_data;
+			old_file_data = new_file_data;
 
-		uint64_t total_usec_end = OS::get_singleton()->get_ticks_usec();
+			print_verbose(vformat(U"Applied delta patch to \"%s\" from \"%s\" in %d μs (%d μs I/O, %d μs decoding).", path, delta_patch.pack.get_file(), decode_usec_end - io_usec_start, io_usec_end - io_usec_start, decode_usec_end - decode_usec_start));
+		}
 
-		print_verbose(vformat(U"Applied delta patch to \"%s\" from \"%s\" in %d μs (%d μs I/O, %d μs decoding).", path, delta_patch.pack.get_file(), total_usec_end - total_usec_start, io_usec_end - io_usec_start, decode_usec_end - decode_usec_start));
+		old_data = old_file_data;
 	}
 
-	patched_file_data = old_file_data;
-	patched_file.instantiate();
-	return patched_file->open_custom(patched_file_data.ptr(), patched_file_data.size());
+	const PackedData::PackedFile &last_patch = delta_patches[delta_patches.size() - 1];
+	ERR_FAIL_COND_V(last_patch.bundle, FAILED);
+
+	Error err = OK;
+	patch_file = _open_delta_patch(path, last_patch, err);
+	ERR_FAIL_COND_V(err != OK, err);
+
+	err = patch_decoder.open(old_data, patch_file, last_patch.size);
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Failed to apply delta patch (%d of %d) to \"%s\".", delta_patches.size(), delta_patches.size(), path));
+
+	uint64_t total_usec_end = OS::get_singleton()->get_ticks_usec();
+
+	print_verbose(vformat(U"Streaming delta patch to \"%s\" from \"%s\", set up in %d μs.", path, last_patch.pack.get_file(), total_usec_end - total_usec_start));
+
+	patch_eof = false;
+	return OK;
 }
 
 bool FileAccessPatched::_try_apply_patch() const {
@@ -86,7 +122,7 @@ bool FileAccessPatched::_try_apply_patch() const {
 		return false;
 	}
 
-	if (patched_file.is_valid()) {
+	if (patched_file.is_valid() || patch_decoder.is_open()) {
 		return true;
 	}
 
@@ -94,6 +130,34 @@ bool FileAccessPatched::_try_apply_patch() const {
 	return last_error == OK;
 }
 
+Error FileAccessPatched::_decode_fully() const {
+	if (patched_file.is_valid()) {
+		return OK;
+	}
+
+	uint64_t position = patch_decoder.get_position();
+
+	Error err = patch_decoder.rewind();
+	ERR_FAIL_COND_V(err != OK, err);
+
+	patched_file_data.resize(patch_decoder.get_new_size());
+	uint64_t decoded = patch_decoder.read(patched_file_data.ptrw(), patched_file_data.size(), &err);
+	ERR_FAIL_COND_V(err != OK, err);
+	ERR_FAIL_COND_V(decoded != (uint64_t)patched_file_data.size(), ERR_FILE_CORRUPT);
+
+	// The old data and the patch aren't needed anymore once the result is in memory.
+	patch_decoder.close();
+	patch_file.unref();
+	old_file_data.clear();
+
+	patched_file.instantiate();
+	err = patched_file->open_custom(patched_file_data.ptr(), patched_file_data.size());
+	ERR_FAIL_COND_V(err != OK, err);
+
+	patched_file->seek(position);
+	return OK;
+}
+
 Error FileAccessPatched::open_custom(const Ref<FileAccess> &p_old_file) {
 	close();
 
@@ -116,6 +180,21 @@ void FileAccessPatched::seek(uint64_t p_position) {
 		return;
 	}
 
+	if (patched_file.is_null()) {
+		ERR_FAIL_COND(p_position > patch_decoder.get_new_size());
+
+		if (p_position >= patch_decoder.get_position()) {
+			patch_eof = false;
+			last_error = patch_decoder.skip(p_position - patch_decoder.get_position());
+			return;
+		}
+
+		last_error = _decode_fully();
+		if (last_error != OK) {
+			return;
+		}
+	}
+
 	patched_file->seek(p_position);
 }
 
@@ -124,6 +203,11 @@ void FileAccessPatched::seek_end(int64_t p_position) {
 		return;
 	}
 
+	if (patched_file.is_null()) {
+		seek(patch_decoder.get_new_size() + p_position);
+		return;
+	}
+
 	patched_file->seek_end(p_position);
 }
 
@@ -132,6 +216,10 @@ uint64_t FileAccessPatched::get_position() const {
 		return 0;
 	}
 
+	if (patched_file.is_null()) {
+		return patch_decoder.get_position();
+	}
+
 	return patched_file->get_position();
 }
 
@@ -140,6 +228,10 @@ uint64_t FileAccessPatched::get_length() const {
 		return 0;
 	}
 
+	if (patched_file.is_null()) {
+		return patch_decoder.get_new_size();
+	}
+
 	return patched_file->get_length();
 }
 
@@ -148,6 +240,10 @@ bool FileAccessPatched::eof_reached() const {
 		return true;
 	}
 
+	if (patched_file.is_null()) {
+		return patch_eof;
+	}
+
 	return patched_file->eof_reached();
 }
 
@@ -161,6 +257,8 @@ Error FileAccessPatched::get_error() const {
 		if (inner_error != OK) {
 			return inner_error;
 		}
+	} else if (patch_eof) {
+		return ERR_FILE_EOF;
 	}
 
 	return last_error;
@@ -171,6 +269,13 @@ bool FileAccessPatched::store_buffer(const uint8_t *p_src, uint64_t p_length) {
 		return false;
 	}
 
+	if (patched_file.is_null()) {
+		last_error = _decode_fully();
+		if (last_error != OK) {
+			return false;
+		}
+	}
+
 	return patched_file->store_buffer(p_src, p_length);
 }
 
@@ -179,11 +284,23 @@ uint64_t FileAccessPatched::get_buffer(uint8_t *p_dst, uint64_t p_length) const
 		return 0;
 	}
 
+	if (patched_file.is_null()) {
+		Error err = OK;
+		uint64_t read_bytes = patch_decoder.read(p_dst, p_length, &err);
+		if (err != OK) {
+			last_error = err;
+		}
+		if (read_bytes < p_length) {
+			patch_eof = true;
+		}
+		return read_bytes;
+	}
+
 	return patched_file->get_buffer(p_dst, p_length);
 }
 
 void FileAccessPatched::flush() {
-	if (!_try_apply_patch()) {
+	if (!_try_apply_patch() || patched_file.is_null()) {
 		return;
 	}
 
@@ -192,6 +309,10 @@ void FileAccessPatched::flush() {
 
 void FileAccessPatched::close() {
 	old_file = Ref<FileAccess>();
+	patch_decoder.close();
+	patch_file = Ref<FileAccess>();
+	old_file_data.clear();
+	patch_eof = false;
 	patched_file = Ref<FileAccessMemory>();
 	patched_file_data.clear();
 	last_error = OK;
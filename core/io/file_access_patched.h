@@ -33,16 +33,26 @@
 #include "file_access.h"
 #include "file_access_memory.h"
 
+#include "core/io/delta_encoding.h"
+
+// Serves a file with its delta patches applied. The last patch is decoded on the fly while the
+// file is read forwards; seeking backwards or writing falls back to decoding it fully in memory.
 class FileAccessPatched : public FileAccess {
 	GDSOFTCLASS(FileAccessPatched, FileAccess);
 
 	Ref<FileAccess> old_file;
+	mutable Vector<uint8_t> old_file_data;
+	mutable Ref<FileAccess> patch_file;
+	mutable DeltaStreamDecoder patch_decoder;
+	mutable bool patch_eof = false;
+
 	mutable Vector<uint8_t> patched_file_data;
 	mutable Ref<FileAccessMemory> patched_file;
 	mutable Error last_error = OK;
 
 	Error _apply_patch() const;
 	bool _try_apply_patch() const;
+	Error _decode_fully() const;
 
 protected:
 	virtual BitField<UnixPermissionFlags> _get_unix_permissions(const String &p_file) override { return 0; }
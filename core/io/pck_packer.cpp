@@ -31,7 +31,7 @@
 #include "pck_packer.h"
 
 #include "core/crypto/crypto_core.h"
-#include "core/io/file_access.h"
+#include "core/io/file_access_compressed.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
 #include "core/version.h"
@@ -49,6 +49,7 @@ static int _get_pad(int p_alignment, int p_n) {
 void PCKPacker::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("pck_start", "pck_path", "alignment", "key", "encrypt_directory"), &PCKPacker::pck_start, DEFVAL(32), DEFVAL("0000000000000000000000000000000000000000000000000000000000000000"), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("add_file", "target_path", "source_path", "encrypt"), &PCKPacker::add_file, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("add_file_compressed", "target_path", "source_path", "compression_mode", "encrypt"), &PCKPacker::add_file_compressed, DEFVAL(FileAccess::COMPRESSION_ZSTD), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("add_file_removal", "target_path"), &PCKPacker::add_file_removal);
 	ClassDB::bind_method(D_METHOD("flush", "verbose"), &PCKPacker::flush, DEFVAL(false));
 }
@@ -146,6 +147,15 @@ Error PCKPacker::add_file_removal(const String &p_target_path) {
 }
 
 Error PCKPacker::add_file(const String &p_target_path, const String &p_source_path, bool p_encrypt) {
+	return _add_file(p_target_path, p_source_path, p_encrypt, -1);
+}
+
+Error PCKPacker::add_file_compressed(const String &p_target_path, const String &p_source_path, FileAccess::CompressionMode p_compression_mode, bool p_encrypt) {
+	ERR_FAIL_COND_V_MSG(p_compression_mode == FileAccess::COMPRESSION_BROTLI, ERR_INVALID_PARAMETER, "Brotli can only be used for decompression.");
+	return _add_file(p_target_path, p_source_path, p_encrypt, p_compression_mode);
+}
+
+Error PCKPacker::_add_file(const String &p_target_path, const String &p_source_path, bool p_encrypt, int p_compression_mode) {
 	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
 
 	Ref<FileAccess> f = FileAccess::open(p_source_path, FileAccess::READ);
@@ -172,6 +182,15 @@ Error PCKPacker::add_file(const String &p_target_path, const String &p_source_pa
 	}
 	pf.encrypted = p_encrypt;
 
+	if (p_compression_mode >= 0) {
+		// Keep the file raw if compressing it doesn't pay off (e.g. it's already compressed).
+		Vector<uint8_t> compressed = FileAccessCompressed::compress_buffer(data.ptr(), data.size(), PACK_FILE_COMPRESSED_MAGIC, (Compression::Mode)p_compression_mode, PACK_FILE_COMPRESSION_BLOCK_SIZE);
+		if (!compressed.is_empty() && compressed.size() < data.size()) {
+			data = compressed;
+			pf.compressed = true;
+		}
+	}
+
 	Ref<FileAccess> ftmp = file;
 
 	Ref<FileAccessEncrypted> fae;
@@ -253,6 +272,9 @@ Error PCKPacker::flush(bool p_verbose) {
 		if (files[i].removal) {
 			flags |= PACK_FILE_REMOVAL;
 		}
+		if (files[i].compressed) {
+			flags |= PACK_FILE_COMPRESSED;
+		}
 		fhead->store_32(flags);
 
 		if (p_verbose) {
@@ -761,12 +761,69 @@ void Resource::_bind_methods() {
 	GDVIRTUAL_BIND(_set_path_cache, "path");
 }
 
+bool Resource::set_lazy_property(const StringName &p_name, const Callable &p_loader) {
+	ERR_FAIL_COND_V(!p_loader.is_valid(), false);
+	if (!can_load_property_lazily(p_name)) {
+		return false;
+	}
+
+	{
+		MutexLock lock(lazy_properties_mutex);
+		if (!lazy_properties) {
+			lazy_properties = memnew(LazyProperties);
+		}
+	}
+
+	MutexLock lock(lazy_properties->mutex);
+	lazy_properties->loaders.insert(p_name, p_loader);
+	lazy_properties_pending.set();
+	return true;
+}
+
+bool Resource::_take_lazy_property(const StringName &p_name, Variant &r_value) const {
+	if (!lazy_properties) {
+		return false;
+	}
+
+	HashMap<StringName, Callable>::Iterator E = lazy_properties->loaders.find(p_name);
+	if (!E) {
+		return false;
+	}
+
+	Callable loader = E->value;
+	lazy_properties->loaders.remove(E);
+	r_value = loader.call();
+	return true;
+}
+
+void Resource::_lazy_property_loaded() const {
+	// Only cleared once the value was applied, so other threads keep waiting on the lock until then.
+	if (lazy_properties->loaders.is_empty()) {
+		lazy_properties_pending.clear();
+	}
+}
+
+void Resource::_discard_lazy_property(const StringName &p_name) {
+	if (likely(!lazy_properties_pending.is_set())) {
+		return;
+	}
+
+	MutexLock lock(lazy_properties->mutex);
+	if (lazy_properties->loaders.erase(p_name) && lazy_properties->loaders.is_empty()) {
+		lazy_properties_pending.clear();
+	}
+}
+
 Resource::Resource() :
 		remapped_list(this) {
 	_define_ancestry(AncestralClass::RESOURCE);
 }
 
 Resource::~Resource() {
+	if (unlikely(lazy_properties)) {
+		memdelete(lazy_properties);
+	}
+
 	if (unlikely(path_cache.is_empty())) {
 		return;
 	}
@@ -786,6 +843,7 @@ HashMap<String, HashMap<String, String>> ResourceCache::resource_path_cache;
 #endif
 
 Mutex ResourceCache::lock;
+Mutex Resource::lazy_properties_mutex;
 #ifdef TOOLS_ENABLED
 RWLock ResourceCache::path_cache_lock;
 #endif
@@ -92,6 +92,19 @@ private:
 
 	SelfList<Resource> remapped_list;
 
+	// Property values a loader left in the file, with the callables that read them. Each resource has its
+	// own lock, so reading the properties of one resource doesn't hold up the others.
+	struct LazyProperties {
+		Mutex mutex;
+		HashMap<StringName, Callable> loaders;
+	};
+	LazyProperties *lazy_properties = nullptr;
+	mutable SafeFlag lazy_properties_pending;
+	static Mutex lazy_properties_mutex; // Only guards creating lazy_properties.
+
+	bool _take_lazy_property(const StringName &p_name, Variant &r_value) const;
+	void _lazy_property_loaded() const;
+
 	using DuplicateRemapCacheT = HashMap<Ref<Resource>, Ref<Resource>>;
 	static thread_local inline DuplicateRemapCacheT *thread_duplicate_remap_cache = nullptr;
 
@@ -124,6 +137,22 @@ protected:
 	virtual Ref<Resource> _duplicate(const DuplicateParams &p_params) const;
 	virtual String _to_string() override;
 
+	// Reads a property left in the file by the loader, at most once, and passes it to p_apply while
+	// other threads needing it wait. Classes allowing lazy properties call this before using the value.
+	template <typename F>
+	void _load_lazy_property(const StringName &p_name, F p_apply) const {
+		if (likely(!lazy_properties_pending.is_set())) {
+			return;
+		}
+		MutexLock lock(lazy_properties->mutex);
+		Variant value;
+		if (_take_lazy_property(p_name, value)) {
+			p_apply(value);
+			_lazy_property_loaded();
+		}
+	}
+	void _discard_lazy_property(const StringName &p_name);
+
 public:
 	static Node *(*_get_local_scene_func)(); // Used by the editor.
 	static void (*_update_configuration_warning)(); // Used by the editor.
@@ -183,6 +212,15 @@ public:
 
 	virtual RID get_rid() const; // Some resources may offer conversion to RID.
 
+	// Large values of these properties may be left in the file by the loader and read on first use.
+	virtual bool can_load_property_lazily(const StringName &p_name) const { return false; }
+	bool set_lazy_property(const StringName &p_name, const Callable &p_loader);
+	bool has_lazy_properties() const { return lazy_properties_pending.is_set(); }
+
+	// Whether the loader may set properties of different instances from several threads at once.
+	// Only classes whose setters touch nothing but the resource itself should return true.
+	virtual bool has_thread_safe_setters() const { return false; }
+
 	// Helps keep IDs the same when loading/saving scenes. An empty ID clears the entry, and an empty ID is returned when not found.
 	static void set_resource_id_for_path(const String &p_referrer_path, const String &p_resource_path, const String &p_id);
 	void set_id_for_path(const String &p_referrer_path, const String &p_id) { set_resource_id_for_path(p_referrer_path, get_path(), p_id); }
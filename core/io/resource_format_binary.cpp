@@ -30,11 +30,14 @@
 
 #include "resource_format_binary.h"
 
+#include "core/config/engine.h"
 #include "core/config/project_settings.h"
 #include "core/io/dir_access.h"
+#include "core/io/file_access_async.h"
 #include "core/io/file_access_compressed.h"
 #include "core/io/missing_resource.h"
 #include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/version.h"
 #include "scene/property_utils.h"
 #include "scene/resources/packed_scene.h"
@@ -163,6 +166,10 @@ StringName ResourceLoaderBinary::_get_string() {
 		if (len == 0) {
 			return StringName();
 		}
+		const uint8_t *view = f->get_buffer_view(len);
+		if (view) {
+			return String::utf8((const char *)view, len);
+		}
 		f->get_buffer((uint8_t *)&str_buf[0], len);
 		return String::utf8(&str_buf[0], len);
 	}
@@ -407,6 +414,10 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 						path += res_path + "::" + itos(index);
 					}
 
+					if (current_dependencies) {
+						current_dependencies->push_back(path);
+					}
+
 					//always use internal cache for loading internal resources
 					if (!internal_index_cache.has(path)) {
 						WARN_PRINT(vformat("Couldn't load resource (no cache): %s.", path));
@@ -674,6 +685,71 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 	return OK; //never reach anyway
 }
 
+bool ResourceLoaderBinary::_defer_lazy_property(Resource *p_resource, const StringName &p_name) {
+	uint64_t value_offset = f->get_position();
+	uint32_t prop_type = f->get_32();
+
+	uint64_t real_size = f->real_is_double ? sizeof(double) : sizeof(float);
+	uint64_t element_size = 0;
+	switch (prop_type) {
+		case VARIANT_PACKED_BYTE_ARRAY:
+			element_size = 1;
+			break;
+		case VARIANT_PACKED_INT32_ARRAY:
+		case VARIANT_PACKED_FLOAT32_ARRAY:
+			element_size = 4;
+			break;
+		case VARIANT_PACKED_INT64_ARRAY:
+		case VARIANT_PACKED_FLOAT64_ARRAY:
+			element_size = 8;
+			break;
+		case VARIANT_PACKED_COLOR_ARRAY:
+			element_size = 4 * sizeof(float);
+			break;
+		case VARIANT_PACKED_VECTOR2_ARRAY:
+			element_size = 2 * real_size;
+			break;
+		case VARIANT_PACKED_VECTOR3_ARRAY:
+			element_size = 3 * real_size;
+			break;
+		case VARIANT_PACKED_VECTOR4_ARRAY:
+			element_size = 4 * real_size;
+			break;
+		default:
+			break;
+	}
+
+	if (element_size > 0) {
+		uint64_t size = f->get_32() * element_size;
+		if (size >= lazy_min_size) {
+			if (prop_type == VARIANT_PACKED_BYTE_ARRAY) {
+				size = (size + 3) & ~3ULL; // Padded to 32 bits.
+			}
+			f->seek(f->get_position() + size);
+			return p_resource->set_lazy_property(p_name, callable_mp_static(&ResourceLoaderBinary::_load_lazy_property).bind(lazy_file_path, value_offset));
+		}
+	}
+
+	f->seek(value_offset);
+	return false;
+}
+
+Variant ResourceLoaderBinary::_load_lazy_property(const String &p_path, uint64_t p_offset) {
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::READ);
+	ERR_FAIL_COND_V_MSG(file.is_null(), Variant(), vformat("Cannot open file '%s' to read a lazily loaded property.", p_path));
+
+	ResourceLoaderBinary loader;
+	loader.local_path = ProjectSettings::get_singleton()->localize_path(p_path);
+	loader.open(file, true);
+	ERR_FAIL_COND_V(loader.error != OK, Variant());
+
+	loader.f->seek(p_offset);
+	Variant value;
+	Error err = loader.parse_variant(value);
+	ERR_FAIL_COND_V_MSG(err != OK, Variant(), vformat("Failed to read a lazily loaded property from '%s'.", p_path));
+	return value;
+}
+
 Ref<Resource> ResourceLoaderBinary::get_resource() {
 	return resource;
 }
@@ -683,6 +759,7 @@ Error ResourceLoaderBinary::load() {
 		return error;
 	}
 
+	Vector<String> prefetch_paths;
 	for (int i = 0; i < external_resources.size(); i++) {
 		String path = external_resources[i].path;
 
@@ -696,6 +773,18 @@ Error ResourceLoaderBinary::load() {
 		}
 
 		external_resources.write[i].path = path; //remap happens here, not on load because on load it can actually be used for filesystem dock resource remap
+		if (!ResourceCache::has(path)) {
+			prefetch_paths.push_back(path);
+		}
+	}
+
+	// Dependencies are loaded one after another, get all of them from disk in the background meanwhile.
+	if (prefetch_paths.size() > 1) {
+		FileAccessAsync::prefetch_resources(prefetch_paths);
+	}
+
+	for (int i = 0; i < external_resources.size(); i++) {
+		String path = external_resources[i].path;
 		external_resources.write[i].load_token = ResourceLoader::_load_start(path, external_resources[i].type, use_sub_threads ? ResourceLoader::LOAD_THREAD_DISTRIBUTE : ResourceLoader::LOAD_THREAD_FROM_CURRENT, cache_mode_for_external);
 		if (external_resources[i].load_token.is_null()) {
 			if (!ResourceLoader::get_abort_on_missing_resources()) {
@@ -707,6 +796,14 @@ Error ResourceLoaderBinary::load() {
 		}
 	}
 
+	// With sub-threads, sub-resources are only read here and their properties set
+	// afterwards level by level, so that anything a sub-resource refers to is complete
+	// before its own properties are set. Classes with thread-safe setters run in parallel.
+	const bool parallel = use_sub_threads && internal_resources.size() > 2 && WorkerThreadPool::get_singleton()->get_thread_count() > 1;
+	LocalVector<PendingResource> pending;
+	LocalVector<String> dependencies;
+	HashMap<String, uint32_t> pending_levels;
+
 	for (int i = 0; i < internal_resources.size(); i++) {
 		bool main = i == (internal_resources.size() - 1);
 
@@ -811,79 +908,65 @@ Error ResourceLoaderBinary::load() {
 
 		int pc = f->get_32();
 
-		//set properties
+		PendingResource entry;
+		entry.resource = res;
+		entry.missing_resource = missing_resource;
+		entry.properties.reserve(pc);
+		// Extension classes may override setters of an allowed class.
+		entry.serial = !res->has_thread_safe_setters() || ClassDB::get_api_type(res->get_class_name()) == ClassDB::API_EXTENSION;
 
-		Dictionary missing_resource_properties;
+		dependencies.clear();
+		current_dependencies = parallel ? &dependencies : nullptr;
 
 		for (int j = 0; j < pc; j++) {
 			StringName name = _get_string();
 
 			if (name == StringName()) {
+				current_dependencies = nullptr;
 				error = ERR_FILE_CORRUPT;
 				ERR_FAIL_V(ERR_FILE_CORRUPT);
 			}
 
+			if (lazy_min_size > 0 && r && r->can_load_property_lazily(name) && _defer_lazy_property(r, name)) {
+				continue;
+			}
+
 			Variant value;
 
 			error = parse_variant(value);
 			if (error) {
+				current_dependencies = nullptr;
 				return error;
 			}
 
-			bool set_valid = true;
-			if (value.get_type() == Variant::OBJECT && missing_resource == nullptr && ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
-				// If the property being set is a missing resource (and the parent is not),
-				// then setting it will most likely not work.
-				// Instead, save it as metadata.
-
-				Ref<MissingResource> mr = value;
-				if (mr.is_valid()) {
-					missing_resource_properties[name] = mr;
-					set_valid = false;
-				}
-			}
-
-			if (value.get_type() == Variant::ARRAY) {
-				Array set_array = value;
-				bool is_get_valid = false;
-				Variant get_value = res->get(name, &is_get_valid);
-				if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
-					Array get_array = get_value;
-					if (!set_array.is_same_typed(get_array)) {
-						value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
-					}
-				}
+			if (name == CoreStringName(script) && value.get_type() == Variant::OBJECT) {
+				entry.serial = true;
 			}
+			entry.properties.push_back(Pair<StringName, Variant>(name, value));
+		}
+		current_dependencies = nullptr;
 
-			if (value.get_type() == Variant::DICTIONARY) {
-				Dictionary set_dict = value;
-				bool is_get_valid = false;
-				Variant get_value = res->get(name, &is_get_valid);
-				if (is_get_valid && get_value.get_type() == Variant::DICTIONARY) {
-					Dictionary get_dict = get_value;
-					if (!set_dict.is_same_typed(get_dict)) {
-						value = Dictionary(set_dict, get_dict.get_typed_key_builtin(), get_dict.get_typed_key_class_name(), get_dict.get_typed_key_script(),
-								get_dict.get_typed_value_builtin(), get_dict.get_typed_value_class_name(), get_dict.get_typed_value_script());
-					}
+		if (parallel && !main) {
+			for (const String &dependency : dependencies) {
+				const uint32_t *dependency_level = pending_levels.getptr(dependency);
+				if (dependency_level) {
+					entry.level = MAX(entry.level, *dependency_level + 1);
 				}
 			}
+			pending_levels[path] = entry.level;
+			pending.push_back(std::move(entry));
+			resource_cache.push_back(res);
 
-			if (set_valid) {
-				res->set(name, value);
+			if (progress) {
+				*progress = (i + 1) / float(internal_resources.size()) * 0.5;
 			}
+			continue;
 		}
 
-		if (missing_resource) {
-			missing_resource->set_recording_properties(false);
-		}
-
-		if (!missing_resource_properties.is_empty()) {
-			res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
+		if (main && !pending.is_empty()) {
+			_set_pending_resources_properties(pending);
 		}
-
-#ifdef TOOLS_ENABLED
-		res->set_edited(false);
-#endif
+		_set_resource_properties(entry);
 
 		if (progress) {
 			*progress = (i + 1) / float(internal_resources.size());
@@ -903,6 +986,121 @@ Error ResourceLoaderBinary::load() {
 	return ERR_FILE_EOF;
 }
 
+void ResourceLoaderBinary::_set_resource_properties(PendingResource &p_pending) {
+	Ref<Resource> &res = p_pending.resource;
+	MissingResource *missing_resource = p_pending.missing_resource;
+
+	//set properties
+
+	Dictionary missing_resource_properties;
+
+	for (Pair<StringName, Variant> &property : p_pending.properties) {
+		const StringName &name = property.first;
+		Variant &value = property.second;
+
+		bool set_valid = true;
+		if (value.get_type() == Variant::OBJECT && missing_resource == nullptr && ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
+			// If the property being set is a missing resource (and the parent is not),
+			// then setting it will most likely not work.
+			// Instead, save it as metadata.
+
+			Ref<MissingResource> mr = value;
+			if (mr.is_valid()) {
+				missing_resource_properties[name] = mr;
+				set_valid = false;
+			}
+		}
+
+		if (value.get_type() == Variant::ARRAY) {
+			Array set_array = value;
+			bool is_get_valid = false;
+			Variant get_value = res->get(name, &is_get_valid);
+			if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
+				Array get_array = get_value;
+				if (!set_array.is_same_typed(get_array)) {
+					value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
+				}
+			}
+		}
+
+		if (value.get_type() == Variant::DICTIONARY) {
+			Dictionary set_dict = value;
+			bool is_get_valid = false;
+			Variant get_value = res->get(name, &is_get_valid);
+			if (is_get_valid && get_value.get_type() == Variant::DICTIONARY) {
+				Dictionary get_dict = get_value;
+				if (!set_dict.is_same_typed(get_dict)) {
+					value = Dictionary(set_dict, get_dict.get_typed_key_builtin(), get_dict.get_typed_key_class_name(), get_dict.get_typed_key_script(),
+							get_dict.get_typed_value_builtin(), get_dict.get_typed_value_class_name(), get_dict.get_typed_value_script());
+				}
+			}
+		}
+
+		if (set_valid) {
+			res->set(name, value);
+		}
+	}
+
+	if (missing_resource) {
+		missing_resource->set_recording_properties(false);
+	}
+
+	if (!missing_resource_properties.is_empty()) {
+		res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
+	}
+
+#ifdef TOOLS_ENABLED
+	res->set_edited(false);
+#endif
+
+	p_pending.properties.clear();
+}
+
+void ResourceLoaderBinary::_set_pending_resource_properties_task(uint32_t p_index, const uint32_t *p_indices) {
+	_set_resource_properties((*pending_resources)[p_indices[p_index]]);
+}
+
+void ResourceLoaderBinary::_set_pending_resources_properties(LocalVector<PendingResource> &p_pending) {
+	uint32_t level_count = 0;
+	for (const PendingResource &E : p_pending) {
+		level_count = MAX(level_count, E.level + 1);
+	}
+	LocalVector<LocalVector<uint32_t>> levels;
+	levels.resize(level_count);
+	for (uint32_t i = 0; i < p_pending.size(); i++) {
+		levels[p_pending[i].level].push_back(i);
+	}
+
+	pending_resources = &p_pending;
+	uint32_t done = 0;
+	LocalVector<uint32_t> threaded;
+	for (const LocalVector<uint32_t> &level : levels) {
+		threaded.clear();
+		for (uint32_t index : level) {
+			if (!p_pending[index].serial) {
+				threaded.push_back(index);
+			}
+		}
+
+		if (threaded.size() > 1) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &ResourceLoaderBinary::_set_pending_resource_properties_task, threaded.ptr(), threaded.size(), -1, true, SNAME("ResourceLoaderBinarySetProperties"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		}
+		for (uint32_t index : level) {
+			if (p_pending[index].serial || threaded.size() == 1) {
+				_set_resource_properties(p_pending[index]);
+			}
+		}
+
+		done += level.size();
+		if (progress) {
+			*progress = 0.5 + done / float(internal_resources.size()) * 0.5;
+		}
+	}
+	pending_resources = nullptr;
+	p_pending.clear();
+}
+
 void ResourceLoaderBinary::set_translation_remapped(bool p_remapped) {
 	translation_remapped = p_remapped;
 }
@@ -929,6 +1127,10 @@ String ResourceLoaderBinary::get_unicode_string() {
 	if (len == 0) {
 		return String();
 	}
+	const uint8_t *view = f->get_buffer_view(len);
+	if (view) {
+		return String::utf8((const char *)view, len);
+	}
 	f->get_buffer((uint8_t *)&str_buf[0], len);
 	return String::utf8(&str_buf[0], len);
 }
@@ -1241,6 +1443,11 @@ Ref<Resource> ResourceFormatLoaderBinary::load(const String &p_path, const Strin
 	String path = !p_original_path.is_empty() ? p_original_path : p_path;
 	loader.local_path = ProjectSettings::get_singleton()->localize_path(path);
 	loader.res_path = loader.local_path;
+	if (!Engine::get_singleton()->is_editor_hint()) {
+		// The editor may reimport the file while resources from it are alive, so it always loads everything.
+		loader.lazy_min_size = MAX(0, (int64_t)ProjectSettings::get_singleton()->get_setting("resource_loader/lazy_load_min_size", 0));
+		loader.lazy_file_path = p_path;
+	}
 	loader.open(f);
 
 	err = loader.load();
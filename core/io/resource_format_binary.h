@@ -33,8 +33,12 @@
 #include "core/io/file_access.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/pair.h"
 #include "core/templates/rb_map.h"
 
+class MissingResource;
+
 class ResourceLoaderBinary {
 	bool translation_remapped = false;
 	String local_path;
@@ -78,6 +82,22 @@ class ResourceLoaderBinary {
 	Vector<IntResource> internal_resources;
 	HashMap<String, Ref<Resource>> internal_index_cache;
 
+	// An internal resource whose properties were read but not set yet.
+	struct PendingResource {
+		Ref<Resource> resource;
+		MissingResource *missing_resource = nullptr;
+		LocalVector<Pair<StringName, Variant>> properties;
+		uint32_t level = 0; // Applied after all lower levels, which hold the internal resources it refers to.
+		bool serial = false; // Set on the loading thread, unless the class has thread-safe setters and no script.
+	};
+
+	LocalVector<String> *current_dependencies = nullptr;
+	LocalVector<PendingResource> *pending_resources = nullptr;
+
+	void _set_resource_properties(PendingResource &p_pending);
+	void _set_pending_resource_properties_task(uint32_t p_index, const uint32_t *p_indices);
+	void _set_pending_resources_properties(LocalVector<PendingResource> &p_pending);
+
 	String get_unicode_string();
 	void _advance_padding(uint32_t p_len);
 
@@ -91,6 +111,13 @@ class ResourceLoaderBinary {
 
 	Error parse_variant(Variant &r_v);
 
+	// Large packed arrays of resources allowing it are left in the file and read when first used.
+	String lazy_file_path;
+	uint64_t lazy_min_size = 0;
+
+	bool _defer_lazy_property(Resource *p_resource, const StringName &p_name);
+	static Variant _load_lazy_property(const String &p_path, uint64_t p_offset);
+
 	HashMap<String, Ref<Resource>> dependency_cache;
 
 public:
@@ -662,6 +662,22 @@ Object *ClassDB::instantiate(const StringName &p_class) {
 	return _instantiate_internal(p_class);
 }
 
+Object *(*ClassDB::get_native_creation_func(const StringName &p_class))(bool) {
+	Locker::Lock lock(Locker::STATE_READ);
+	ClassInfo *ti = classes.getptr(p_class);
+	// Only hand out constructors that _instantiate_internal() would call directly, without
+	// compatibility remaps, extension instances or editor placeholders getting involved.
+	if (!ti || ti->disabled || !ti->exposed || ti->gdextension || ti->is_runtime || !ti->creation_func) {
+		return nullptr;
+	}
+#ifdef TOOLS_ENABLED
+	if (ti->api == API_EDITOR || ti->api == API_EDITOR_EXTENSION) {
+		return nullptr;
+	}
+#endif
+	return ti->creation_func;
+}
+
 Object *ClassDB::instantiate_no_placeholders(const StringName &p_class) {
 	return _instantiate_internal(p_class, true);
 }
@@ -1795,6 +1811,25 @@ StringName ClassDB::get_property_setter(const StringName &p_class, const StringN
 	return StringName();
 }
 
+MethodBind *ClassDB::get_property_setter_method(const StringName &p_class, const StringName &p_property, int *r_index) {
+	Locker::Lock lock(Locker::STATE_READ);
+	ClassInfo *type = classes.getptr(p_class);
+	ClassInfo *check = type;
+	while (check) {
+		const PropertySetGet *psg = check->property_setget.getptr(p_property);
+		if (psg) {
+			if (r_index) {
+				*r_index = psg->index;
+			}
+			return psg->setter ? psg->_setptr : nullptr;
+		}
+
+		check = check->inherits_ptr;
+	}
+
+	return nullptr;
+}
+
 StringName ClassDB::get_property_getter(const StringName &p_class, const StringName &p_property) {
 	ClassInfo *type = classes.getptr(p_class);
 	ClassInfo *check = type;
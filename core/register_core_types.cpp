@@ -46,6 +46,7 @@
 #include "core/io/config_file.h"
 #include "core/io/dir_access.h"
 #include "core/io/dtls_server.h"
+#include "core/io/file_access_async.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/http_client.h"
 #include "core/io/image_loader.h"
@@ -350,6 +351,8 @@ void register_core_settings() {
 	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "network/limits/packet_peer_stream/max_buffer_po2", PROPERTY_HINT_RANGE, "8,64,1,or_greater"), (16));
 	GLOBAL_DEF(PropertyInfo(Variant::STRING, "network/tls/certificate_bundle_override", PROPERTY_HINT_FILE, "*.crt"), "");
 
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "resource_loader/lazy_load_min_size", PROPERTY_HINT_RANGE, "0,67108864,1,or_greater,suffix:B"), 0);
+
 	GLOBAL_DEF("threading/worker_pool/max_threads", -1);
 	GLOBAL_DEF("threading/worker_pool/low_priority_thread_ratio", 0.3);
 }
@@ -410,6 +413,9 @@ void unregister_core_types() {
 
 	// Destroy singletons in reverse order to ensure dependencies are not broken.
 
+	// Normally already stopped by Main::cleanup(), but not when only core was set up.
+	FileAccessAsync::finalize();
+
 	memdelete(worker_thread_pool);
 
 	memdelete(_engine_debugger);
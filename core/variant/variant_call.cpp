@@ -1167,6 +1167,79 @@ struct _VariantCall {
 		return ret;
 	}
 
+	// Whole-array math for packed float arrays. The loops are kept branch-free over raw
+	// pointers so the compiler can vectorize them; reductions use independent partial
+	// sums to break the dependency chain on the accumulator.
+	template <typename T>
+	static double func_PackedFloatArray_sum(Vector<T> *p_instance) {
+		const int64_t size = p_instance->size();
+		const T *r = p_instance->ptr();
+		double partial[4] = {};
+		int64_t i = 0;
+		for (; i + 4 <= size; i += 4) {
+			partial[0] += r[i];
+			partial[1] += r[i + 1];
+			partial[2] += r[i + 2];
+			partial[3] += r[i + 3];
+		}
+		for (; i < size; i++) {
+			partial[0] += r[i];
+		}
+		return (partial[0] + partial[1]) + (partial[2] + partial[3]);
+	}
+
+	template <typename T>
+	static double func_PackedFloatArray_dot(Vector<T> *p_instance, const Vector<T> &p_with) {
+		const int64_t size = p_instance->size();
+		ERR_FAIL_COND_V_MSG(size != p_with.size(), 0.0, vformat("Cannot compute the dot product of arrays of different sizes (%d and %d).", size, p_with.size()));
+		const T *a = p_instance->ptr();
+		const T *b = p_with.ptr();
+		double partial[4] = {};
+		int64_t i = 0;
+		for (; i + 4 <= size; i += 4) {
+			partial[0] += double(a[i]) * b[i];
+			partial[1] += double(a[i + 1]) * b[i + 1];
+			partial[2] += double(a[i + 2]) * b[i + 2];
+			partial[3] += double(a[i + 3]) * b[i + 3];
+		}
+		for (; i < size; i++) {
+			partial[0] += double(a[i]) * b[i];
+		}
+		return (partial[0] + partial[1]) + (partial[2] + partial[3]);
+	}
+
+	template <typename T>
+	static void func_PackedFloatArray_scale(Vector<T> *p_instance, double p_factor) {
+		const int64_t size = p_instance->size();
+		if (size == 0) {
+			return;
+		}
+		const T factor = T(p_factor);
+		T *w = p_instance->ptrw();
+		for (int64_t i = 0; i < size; i++) {
+			w[i] *= factor;
+		}
+	}
+
+	template <typename T>
+	static Vector<T> func_PackedFloatArray_lerp(Vector<T> *p_instance, const Vector<T> &p_to, double p_weight) {
+		const int64_t size = p_instance->size();
+		ERR_FAIL_COND_V_MSG(size != p_to.size(), Vector<T>(), vformat("Cannot interpolate between arrays of different sizes (%d and %d).", size, p_to.size()));
+		Vector<T> ret;
+		ret.resize(size);
+		if (size == 0) {
+			return ret;
+		}
+		const T weight = T(p_weight);
+		const T *from = p_instance->ptr();
+		const T *to = p_to.ptr();
+		T *w = ret.ptrw();
+		for (int64_t i = 0; i < size; i++) {
+			w[i] = from[i] + (to[i] - from[i]) * weight;
+		}
+		return ret;
+	}
+
 	static void func_Callable_call(Variant *v, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error) {
 		Callable *callable = &VariantInternalAccessor<Callable>::get(v);
 		callable->callp(p_args, p_argcount, r_ret, r_error);
@@ -2909,6 +2982,10 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedFloat32Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedFloat32Array, count, sarray("value"), varray());
 	bind_method(PackedFloat32Array, erase, sarray("value"), varray());
+	bind_function(PackedFloat32Array, sum, _VariantCall::func_PackedFloatArray_sum<float>, sarray(), varray());
+	bind_function(PackedFloat32Array, dot, _VariantCall::func_PackedFloatArray_dot<float>, sarray("with"), varray());
+	bind_functionnc(PackedFloat32Array, scale, _VariantCall::func_PackedFloatArray_scale<float>, sarray("factor"), varray());
+	bind_function(PackedFloat32Array, lerp, _VariantCall::func_PackedFloatArray_lerp<float>, sarray("to", "weight"), varray());
 
 	/* Float64 Array */
 
@@ -2937,6 +3014,10 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedFloat64Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedFloat64Array, count, sarray("value"), varray());
 	bind_method(PackedFloat64Array, erase, sarray("value"), varray());
+	bind_function(PackedFloat64Array, sum, _VariantCall::func_PackedFloatArray_sum<double>, sarray(), varray());
+	bind_function(PackedFloat64Array, dot, _VariantCall::func_PackedFloatArray_dot<double>, sarray("with"), varray());
+	bind_functionnc(PackedFloat64Array, scale, _VariantCall::func_PackedFloatArray_scale<double>, sarray("factor"), varray());
+	bind_function(PackedFloat64Array, lerp, _VariantCall::func_PackedFloatArray_lerp<double>, sarray("to", "weight"), varray());
 
 	/* String Array */
 
@@ -36,12 +36,7 @@
 #include "core/object/script_language.h"
 #include "core/string/string_buffer.h"
 
-char32_t VariantParser::Stream::get_char() {
-	// is within buffer?
-	if (readahead_pointer < readahead_filled) {
-		return readahead_buffer[readahead_pointer++];
-	}
-
+char32_t VariantParser::Stream::_fill_readahead() {
 	// attempt to readahead
 	readahead_filled = _read_buffer(readahead_buffer, readahead_enabled ? READAHEAD_SIZE : 1);
 	if (readahead_filled) {
@@ -52,7 +47,7 @@ char32_t VariantParser::Stream::get_char() {
 		eof = true;
 		return 0;
 	}
-	return get_char();
+	return readahead_buffer[readahead_pointer++];
 }
 
 bool VariantParser::Stream::is_eof() const {
@@ -158,6 +153,125 @@ static double stor_fix(const String &p_str) {
 	return -1;
 }
 
+#define READING_SIGN 0
+#define READING_INT 1
+#define READING_DEC 2
+#define READING_EXP 3
+#define READING_DONE 4
+
+// Reads the rest of a number starting with p_first, leaving the character after it in `saved`.
+static void _scan_number(VariantParser::Stream *p_stream, char32_t p_first, StringBuffer<> &r_text, bool &r_is_float) {
+	int reading = READING_INT;
+
+	char32_t c = p_first;
+	bool exp_sign = false;
+	bool exp_beg = false;
+	r_is_float = false;
+
+	while (true) {
+		switch (reading) {
+			case READING_INT: {
+				if (is_digit(c)) {
+					//pass
+				} else if (c == '.') {
+					reading = READING_DEC;
+					r_is_float = true;
+				} else if (c == 'e' || c == 'E') {
+					reading = READING_EXP;
+					r_is_float = true;
+				} else {
+					reading = READING_DONE;
+				}
+
+			} break;
+			case READING_DEC: {
+				if (is_digit(c)) {
+				} else if (c == 'e' || c == 'E') {
+					reading = READING_EXP;
+				} else {
+					reading = READING_DONE;
+				}
+
+			} break;
+			case READING_EXP: {
+				if (is_digit(c)) {
+					exp_beg = true;
+
+				} else if ((c == '-' || c == '+') && !exp_sign && !exp_beg) {
+					exp_sign = true;
+
+				} else {
+					reading = READING_DONE;
+				}
+			} break;
+		}
+
+		if (reading == READING_DONE) {
+			break;
+		}
+		r_text += c;
+		c = p_stream->get_char();
+	}
+
+	p_stream->saved = c;
+}
+
+// Reads a number in a constructor directly, skipping the token and Variant round trip, which adds up
+// for large packed arrays. Sets r_found to false without consuming anything meaningful if what
+// follows isn't a plain number, leaving it to the regular tokenizer.
+static Error _read_construct_number(VariantParser::Stream *p_stream, int &line, double &r_float, int64_t &r_int, bool &r_is_float, bool &r_found) {
+	r_found = false;
+
+	char32_t c;
+	if (p_stream->saved) {
+		c = p_stream->saved;
+		p_stream->saved = 0;
+	} else {
+		c = p_stream->get_char();
+	}
+
+	while (c != 0 && c <= 32) {
+		if (c == '\n') {
+			line++;
+		}
+		c = p_stream->get_char();
+	}
+
+	StringBuffer<> text;
+	if (c == '-') {
+		text += '-';
+		c = p_stream->get_char();
+		if (!is_digit(c)) {
+			// Only "-inf" is valid here, let the tokenizer see it as an identifier.
+			while (is_ascii_alphabet_char(c) || is_underscore(c) || is_digit(c)) {
+				text += c;
+				c = p_stream->get_char();
+			}
+			p_stream->saved = c;
+			double real = stor_fix(text.as_string());
+			if (real == -1) {
+				return ERR_PARSE_ERROR;
+			}
+			r_float = real;
+			r_is_float = true;
+			r_found = true;
+			return OK;
+		}
+	} else if (!is_digit(c)) {
+		p_stream->saved = c;
+		return OK;
+	}
+
+	_scan_number(p_stream, c, text, r_is_float);
+	if (r_is_float) {
+		r_float = text.as_double();
+	} else {
+		r_int = text.as_int();
+	}
+	r_found = true;
+	return OK;
+}
+
 Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, String &r_err_str) {
 	bool string_name = false;
 
@@ -274,9 +388,34 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 				[[fallthrough]];
 			}
 			case '"': {
+				// UTF-8 streams return the raw bytes, which are collected and decoded once at the end.
+				const bool utf8 = p_stream->is_utf8();
+				LocalVector<char> utf8_str;
 				String str;
 				char32_t prev = 0;
 				while (true) {
+					if (prev == 0) {
+						// Copy runs of plain characters straight out of the stream's buffer.
+						uint32_t buffered = 0;
+						const char32_t *run = p_stream->get_buffered(buffered);
+						uint32_t run_length = 0;
+						while (run_length < buffered && run[run_length] != '"' && run[run_length] != '\\' && run[run_length] != '\n' && run[run_length] != 0) {
+							run_length++;
+						}
+						if (run_length > 0) {
+							if (utf8) {
+								uint32_t offset = utf8_str.size();
+								utf8_str.resize(offset + run_length);
+								for (uint32_t i = 0; i < run_length; i++) {
+									utf8_str[offset + i] = char(run[i]);
+								}
+							} else {
+								str.append_utf32(Span(run, run_length));
+							}
+							p_stream->skip_buffered(run_length);
+						}
+					}
+
 					char32_t ch = p_stream->get_char();
 
 					if (ch == 0) {
@@ -377,7 +516,15 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 							r_token.type = TK_ERROR;
 							return ERR_PARSE_ERROR;
 						}
-						str += res;
+						if (utf8) {
+							// Escaped characters are code points, not bytes.
+							CharString res_utf8 = String::chr(res).utf8();
+							for (int i = 0; i < res_utf8.length(); i++) {
+								utf8_str.push_back(res_utf8[i]);
+							}
+						} else {
+							str += res;
+						}
 					} else {
 						if (prev != 0) {
 							r_err_str = "Invalid UTF-16 sequence in string, unpaired lead surrogate";
@@ -387,7 +534,11 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 						if (ch == '\n') {
 							line++;
 						}
-						str += ch;
+						if (utf8) {
+							utf8_str.push_back(char(ch));
+						} else {
+							str += ch;
+						}
 					}
 				}
 				if (prev != 0) {
@@ -396,11 +547,8 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 					return ERR_PARSE_ERROR;
 				}
 
-				if (p_stream->is_utf8()) {
-					// Re-interpret the string we built as ascii.
-					CharString string_as_ascii = str.ascii(true);
-					str.clear();
-					str.append_utf8(string_as_ascii);
+				if (utf8 && !utf8_str.is_empty()) {
+					str.append_utf8(utf8_str.ptr(), utf8_str.size());
 				}
 				if (string_name) {
 					r_token.type = TK_STRING_NAME;
@@ -423,64 +571,8 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 				}
 				if (cchar >= '0' && cchar <= '9') {
 					//a number
-#define READING_SIGN 0
-#define READING_INT 1
-#define READING_DEC 2
-#define READING_EXP 3
-#define READING_DONE 4
-					int reading = READING_INT;
-
-					char32_t c = cchar;
-					bool exp_sign = false;
-					bool exp_beg = false;
 					bool is_float = false;
-
-					while (true) {
-						switch (reading) {
-							case READING_INT: {
-								if (is_digit(c)) {
-									//pass
-								} else if (c == '.') {
-									reading = READING_DEC;
-									is_float = true;
-								} else if (c == 'e' || c == 'E') {
-									reading = READING_EXP;
-									is_float = true;
-								} else {
-									reading = READING_DONE;
-								}
-
-							} break;
-							case READING_DEC: {
-								if (is_digit(c)) {
-								} else if (c == 'e' || c == 'E') {
-									reading = READING_EXP;
-								} else {
-									reading = READING_DONE;
-								}
-
-							} break;
-							case READING_EXP: {
-								if (is_digit(c)) {
-									exp_beg = true;
-
-								} else if ((c == '-' || c == '+') && !exp_sign && !exp_beg) {
-									exp_sign = true;
-
-								} else {
-									reading = READING_DONE;
-								}
-							} break;
-						}
-
-						if (reading == READING_DONE) {
-							break;
-						}
-						token_text += c;
-						c = p_stream->get_char();
-					}
-
-					p_stream->saved = c;
+					_scan_number(p_stream, cchar, token_text, is_float);
 
 					r_token.type = TK_NUMBER;
 
@@ -557,6 +649,7 @@ Error VariantParser::_parse_construct(Stream *p_stream, Vector<T> &r_construct,
 		return ERR_PARSE_ERROR;
 	}
 
+	LocalVector<T> values;
 	bool first = true;
 	while (true) {
 		if (!first) {
@@ -570,6 +663,21 @@ Error VariantParser::_parse_construct(Stream *p_stream, Vector<T> &r_construct,
 				return ERR_PARSE_ERROR;
 			}
 		}
+
+		double number_float = 0;
+		int64_t number_int = 0;
+		bool is_float = false;
+		bool found = false;
+		if (_read_construct_number(p_stream, line, number_float, number_int, is_float, found) != OK) {
+			r_err_str = "Expected float in constructor";
+			return ERR_PARSE_ERROR;
+		}
+		if (found) {
+			values.push_back(is_float ? T(number_float) : T(number_int));
+			first = false;
+			continue;
+		}
+
 		get_token(p_stream, token, line, r_err_str);
 
 		if (first && token.type == TK_PARENTHESIS_CLOSE) {
@@ -590,10 +698,15 @@ Error VariantParser::_parse_construct(Stream *p_stream, Vector<T> &r_construct,
 			}
 		}
 
-		r_construct.push_back(token.value);
+		values.push_back(token.value);
 		first = false;
 	}
 
+	r_construct.resize(values.size());
+	if (!values.is_empty()) {
+		memcpy(r_construct.ptrw(), values.ptr(), values.size() * sizeof(T));
+	}
+
 	return OK;
 }
 
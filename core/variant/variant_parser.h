@@ -44,6 +44,8 @@ public:
 		uint32_t readahead_filled = 0;
 		bool eof = false;
 
+		char32_t _fill_readahead();
+
 	protected:
 		bool readahead_enabled = true;
 		virtual uint32_t _read_buffer(char32_t *p_buffer, uint32_t p_num_chars) = 0;
@@ -52,7 +54,21 @@ public:
 	public:
 		char32_t saved = 0;
 
-		char32_t get_char();
+		_FORCE_INLINE_ char32_t get_char() {
+			// is within buffer?
+			if (likely(readahead_pointer < readahead_filled)) {
+				return readahead_buffer[readahead_pointer++];
+			}
+			return _fill_readahead();
+		}
+
+		// The characters already read ahead past the current position, so they can be scanned in bulk.
+		_FORCE_INLINE_ const char32_t *get_buffered(uint32_t &r_count) const {
+			r_count = readahead_pointer < readahead_filled ? readahead_filled - readahead_pointer : 0;
+			return readahead_buffer + readahead_pointer;
+		}
+		_FORCE_INLINE_ void skip_buffered(uint32_t p_count) { readahead_pointer += p_count; }
+
 		virtual bool is_utf8() const = 0;
 		bool is_eof() const;
 
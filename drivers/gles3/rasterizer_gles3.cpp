@@ -350,6 +350,12 @@ RasterizerGLES3::RasterizerGLES3() {
 
 				if (!shader_cache_dir.is_empty()) {
 					ShaderGLES3::set_shader_cache_dir(shader_cache_dir);
+
+					// Parsed and generated shader code is cached next to the compiled shaders.
+					String compile_cache_dir = shader_cache_dir.path_join("shader_compiler");
+					if (da->make_dir_recursive(compile_cache_dir) == OK) {
+						ShaderCompiler::set_compile_cache_dir(compile_cache_dir);
+					}
 				}
 			}
 		}
@@ -380,6 +386,7 @@ RasterizerGLES3::RasterizerGLES3() {
 }
 
 RasterizerGLES3::~RasterizerGLES3() {
+	ShaderCompiler::set_compile_cache_dir(String());
 }
 
 void RasterizerGLES3::_blit_render_target_to_screen(DisplayServer::WindowID p_screen, const BlitToScreen &p_blit, bool p_first) {
@@ -36,8 +36,15 @@
 #include "core/string/print_string.h"
 
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#if defined(__linux__)
+#include <sys/vfs.h>
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__NetBSD__)
+#include <sys/mount.h>
+#include <sys/param.h>
+#endif
 #if !defined(__FreeBSD__) && !defined(__OpenBSD__) && !defined(__NetBSD__) && !defined(WEB_ENABLED)
 #include <sys/xattr.h>
 #endif
@@ -199,11 +206,82 @@ Error FileAccessUnix::open_internal(const String &p_path, int p_mode_flags) {
 	return OK;
 }
 
+// Mappings of files on network or FUSE file systems can fault on any access, so those are read instead.
+static bool _is_local_file(int p_fd) {
+#if defined(__linux__)
+	struct statfs sfs = {};
+	if (fstatfs(p_fd, &sfs) != 0) {
+		return false;
+	}
+	switch ((uint32_t)sfs.f_type) {
+		case 0x6969: // NFS
+		case 0x517b: // SMB
+		case 0xfe534d42: // SMB2
+		case 0xff534d42: // CIFS
+		case 0x65735546: // FUSE
+		case 0x01021997: // 9P
+			return false;
+		default:
+			return true;
+	}
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__NetBSD__)
+	struct statfs sfs = {};
+	return fstatfs(p_fd, &sfs) == 0 && (sfs.f_flags & MNT_LOCAL);
+#else
+	return true;
+#endif
+}
+
+bool FileAccessUnix::_map() const {
+	if (mapped) {
+		return true;
+	}
+	// Writes go through the stream, so only files opened for reading are mapped.
+	if (flags & WRITE) {
+		return false;
+	}
+
+	int fd = fileno(f);
+	struct stat st = {};
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0 || !_is_local_file(fd)) {
+		return false;
+	}
+
+	const uint64_t file_size = st.st_size;
+	const uint64_t begin = MIN(view_range_offset, file_size);
+	const uint64_t end = view_range_length > file_size - begin ? file_size : begin + view_range_length;
+	if (end <= begin) {
+		return false;
+	}
+
+	const uint64_t page_size = sysconf(_SC_PAGESIZE);
+	const uint64_t map_offset = begin - begin % page_size;
+	void *ptr = mmap(nullptr, end - map_offset, PROT_READ, MAP_PRIVATE, fd, map_offset);
+	if (ptr == MAP_FAILED) {
+		return false;
+	}
+	map_base = ptr;
+	map_base_length = end - map_offset;
+	mapped = (const uint8_t *)ptr + (begin - map_offset);
+	mapped_offset = begin;
+	mapped_length = end - begin;
+	return true;
+}
+
 void FileAccessUnix::_close() {
 	if (!f) {
 		return;
 	}
 
+	if (map_base) {
+		munmap(map_base, map_base_length);
+		map_base = nullptr;
+		map_base_length = 0;
+		mapped = nullptr;
+		mapped_offset = 0;
+		mapped_length = 0;
+	}
+
 	fclose(f);
 	f = nullptr;
 
@@ -309,6 +387,51 @@ uint64_t FileAccessUnix::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return read;
 }
 
+const uint8_t *FileAccessUnix::get_buffer_view(uint64_t p_length) const {
+	ERR_FAIL_NULL_V_MSG(f, nullptr, "File must be opened before use.");
+
+	if (!_map()) {
+		return nullptr;
+	}
+
+	int64_t pos = ftello(f);
+	if (pos < 0 || (uint64_t)pos < mapped_offset || (uint64_t)pos - mapped_offset > mapped_length || p_length > mapped_length - (pos - mapped_offset)) {
+		return nullptr;
+	}
+
+	// Touching pages past the end of a file truncated after mapping raises SIGBUS,
+	// so check the file still covers the view and let get_buffer() report the error.
+	struct stat st = {};
+	if (fstat(fileno(f), &st) != 0 || (uint64_t)st.st_size < (uint64_t)pos + p_length) {
+		return nullptr;
+	}
+
+	if (fseeko(f, pos + p_length, SEEK_SET)) {
+		check_errors();
+		return nullptr;
+	}
+	return mapped + (pos - mapped_offset);
+}
+
+void FileAccessUnix::set_buffer_view_range(uint64_t p_offset, uint64_t p_length) {
+	ERR_FAIL_COND_MSG(mapped, "The view range must be set before the first view is requested.");
+	view_range_offset = p_offset;
+	view_range_length = p_length;
+}
+
+void FileAccessUnix::advise_will_need(uint64_t p_offset, uint64_t p_length) const {
+	ERR_FAIL_NULL_MSG(f, "File must be opened before use.");
+
+#if defined(POSIX_FADV_WILLNEED)
+	posix_fadvise(fileno(f), p_offset, p_length, POSIX_FADV_WILLNEED);
+#elif defined(F_RDADVISE)
+	struct radvisory advice = {};
+	advice.ra_offset = p_offset;
+	advice.ra_count = (int)MIN(p_length, (uint64_t)INT_MAX);
+	fcntl(fileno(f), F_RDADVISE, &advice);
+#endif
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
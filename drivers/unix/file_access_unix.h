@@ -47,6 +47,17 @@ class FileAccessUnix : public FileAccess {
 	String path;
 	String path_src;
 
+	// Read-only mapping of the view range, created by the first get_buffer_view() call.
+	// The mapping itself starts at a page boundary, before the range.
+	uint64_t view_range_offset = 0;
+	uint64_t view_range_length = UINT64_MAX;
+	mutable void *map_base = nullptr;
+	mutable uint64_t map_base_length = 0;
+	mutable const uint8_t *mapped = nullptr;
+	mutable uint64_t mapped_offset = 0;
+	mutable uint64_t mapped_length = 0;
+
+	bool _map() const;
 	void _close();
 
 #if defined(TOOLS_ENABLED)
@@ -71,6 +82,9 @@ public:
 	virtual bool eof_reached() const override; ///< reading passed EOF
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_buffer_view(uint64_t p_length) const override;
+	virtual void set_buffer_view_range(uint64_t p_offset, uint64_t p_length) override;
+	virtual void advise_will_need(uint64_t p_offset, uint64_t p_length) const override;
 
 	virtual Error get_error() const override; ///< get last error
 
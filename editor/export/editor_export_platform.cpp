@@ -37,6 +37,7 @@
 #include "core/extension/gdextension.h"
 #include "core/io/delta_encoding.h"
 #include "core/io/dir_access.h"
+#include "core/io/file_access_compressed.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
 #include "core/io/image.h"
@@ -237,21 +238,26 @@ void EditorExportPlatform::_unload_patches() {
 	PackedData::get_singleton()->clear();
 }
 
-Error EditorExportPlatform::_encrypt_and_store_data(Ref<FileAccess> p_fd, const String &p_path, const Vector<uint8_t> &p_data, const Vector<String> &p_enc_in_filters, const Vector<String> &p_enc_ex_filters, const Vector<uint8_t> &p_key, uint64_t p_seed, bool &r_encrypt) {
-	r_encrypt = false;
+bool EditorExportPlatform::_should_encrypt_file(const String &p_path, const Vector<String> &p_enc_in_filters, const Vector<String> &p_enc_ex_filters) {
+	bool encrypt = false;
 	for (int i = 0; i < p_enc_in_filters.size(); ++i) {
 		if (p_path.matchn(p_enc_in_filters[i]) || p_path.trim_prefix("res://").matchn(p_enc_in_filters[i])) {
-			r_encrypt = true;
+			encrypt = true;
 			break;
 		}
 	}
 
 	for (int i = 0; i < p_enc_ex_filters.size(); ++i) {
 		if (p_path.matchn(p_enc_ex_filters[i]) || p_path.trim_prefix("res://").matchn(p_enc_ex_filters[i])) {
-			r_encrypt = false;
+			encrypt = false;
 			break;
 		}
 	}
+	return encrypt;
+}
+
+Error EditorExportPlatform::_encrypt_and_store_data(Ref<FileAccess> p_fd, const String &p_path, const Vector<uint8_t> &p_data, const Vector<String> &p_enc_in_filters, const Vector<String> &p_enc_ex_filters, const Vector<uint8_t> &p_key, uint64_t p_seed, bool &r_encrypt) {
+	r_encrypt = _should_encrypt_file(p_path, p_enc_in_filters, p_enc_ex_filters);
 
 	Ref<FileAccessEncrypted> fae;
 	Ref<FileAccess> ftmp = p_fd;
@@ -291,6 +297,19 @@ Error EditorExportPlatform::_encrypt_and_store_data(Ref<FileAccess> p_fd, const
 	return OK;
 }
 
+bool EditorExportPlatform::_should_compress_pack_file(const String &p_path) {
+	// Formats that are already compressed won't shrink any further, so don't spend export time on them.
+	static const char *compressed_extensions[] = { "png", "jpg", "jpeg", "webp", "ogg", "oggvorbisstr", "mp3", "mp3str", "ogv", "zip", "pck", nullptr };
+
+	const String extension = p_path.get_extension().to_lower();
+	for (int i = 0; compressed_extensions[i]; i++) {
+		if (extension == compressed_extensions[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
 Error EditorExportPlatform::_save_pack_file(const Ref<EditorExportPreset> &p_preset, void *p_userdata, const String &p_path, const Vector<uint8_t> &p_data, int p_file, int p_total, const Vector<String> &p_enc_in_filters, const Vector<String> &p_enc_ex_filters, const Vector<uint8_t> &p_key, uint64_t p_seed, bool p_delta) {
 	ERR_FAIL_COND_V_MSG(p_total < 1, ERR_PARAMETER_RANGE_ERROR, "Must select at least one file to export.");
 
@@ -310,18 +329,49 @@ Error EditorExportPlatform::_save_pack_file(const Ref<EditorExportPreset> &p_pre
 	sd.ofs = (pd->use_sparse_pck) ? 0 : pd->f->get_position();
 	sd.size = p_data.size();
 	sd.delta = p_delta;
-	Error err = _encrypt_and_store_data(ftmp, simplified_path, p_data, p_enc_in_filters, p_enc_ex_filters, p_key, p_seed, sd.encrypted);
-	if (err != OK) {
-		return err;
+
+	// Sparse PCKs keep every file as-is next to the pack, and delta patches are already compressed.
+	Vector<uint8_t> stored_data = p_data;
+	if (pd->compression_mode >= 0 && !pd->use_sparse_pck && !p_delta && _should_compress_pack_file(simplified_path)) {
+		Vector<uint8_t> compressed = FileAccessCompressed::compress_buffer(p_data.ptr(), p_data.size(), PACK_FILE_COMPRESSED_MAGIC, (Compression::Mode)pd->compression_mode, pd->compression_block_size);
+		// Only keep the compressed version if it saves enough to be worth decompressing at load time.
+		if (!compressed.is_empty() && compressed.size() <= p_data.size() * 0.9) {
+			stored_data = compressed;
+			sd.compressed = true;
+		}
 	}
+
+	// Files with the same stored bytes point to a single copy of them in the pack.
+	String payload_key;
+	bool already_stored = false;
 	if (!pd->use_sparse_pck) {
-		ERR_FAIL_COND_V(pd->f->get_position() - sd.ofs < (uint64_t)p_data.size(), ERR_FILE_CANT_WRITE);
+		unsigned char hash[32];
+		CryptoCore::sha256(stored_data.ptr(), stored_data.size(), hash);
+		const bool encrypt = _should_encrypt_file(simplified_path, p_enc_in_filters, p_enc_ex_filters);
+		payload_key = vformat("%s:%d:%d:%d", String::hex_encode_buffer(hash, 32), stored_data.size(), encrypt, sd.compressed);
+
+		const uint64_t *stored_ofs = pd->stored_payloads.getptr(payload_key);
+		if (stored_ofs) {
+			sd.ofs = *stored_ofs;
+			sd.encrypted = encrypt;
+			already_stored = true;
+		}
 	}
 
-	if (!pd->use_sparse_pck) {
-		int pad = _get_pad(PCK_PADDING, pd->f->get_position());
-		for (int i = 0; i < pad; i++) {
-			pd->f->store_8(0);
+	if (!already_stored) {
+		Error err = _encrypt_and_store_data(ftmp, simplified_path, stored_data, p_enc_in_filters, p_enc_ex_filters, p_key, p_seed, sd.encrypted);
+		if (err != OK) {
+			return err;
+		}
+
+		if (!pd->use_sparse_pck) {
+			ERR_FAIL_COND_V(pd->f->get_position() - sd.ofs < (uint64_t)stored_data.size(), ERR_FILE_CANT_WRITE);
+			pd->stored_payloads[payload_key] = sd.ofs;
+
+			int pad = _get_pad(PCK_PADDING, pd->f->get_position());
+			for (int i = 0; i < pad; i++) {
+				pd->f->store_8(0);
+			}
 		}
 	}
 
@@ -2038,6 +2088,9 @@ bool EditorExportPlatform::_encrypt_and_store_directory(Ref<FileAccess> p_fd, Pa
 		if (p_pack_data.file_ofs[i].delta) {
 			flags |= PACK_FILE_DELTA;
 		}
+		if (p_pack_data.file_ofs[i].compressed) {
+			flags |= PACK_FILE_COMPRESSED;
+		}
 		fhead->store_32(flags);
 	}
 
@@ -2113,6 +2166,8 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 	pd.f = f;
 	pd.so_files = p_so_files;
 	pd.path = p_path;
+	pd.compression_mode = get_project_setting(p_preset, "editor/export/pck_compression/mode");
+	pd.compression_block_size = CLAMP((int)get_project_setting(p_preset, "editor/export/pck_compression/block_size"), 4096, 16 * 1024 * 1024);
 
 	Error err = export_project_files(p_preset, p_debug, p_save_func, p_remove_func, &pd, _pack_add_shared_object);
 
@@ -296,6 +296,8 @@ void register_editor_types() {
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "editor/import/atlas_max_width", PROPERTY_HINT_RANGE, "128,8192,1,or_greater"), 2048);
 
 	GLOBAL_DEF("editor/export/convert_text_resources_to_binary", true);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "editor/export/pck_compression/mode", PROPERTY_HINT_ENUM, "Disabled:-1,FastLZ:0,Deflate:1,Zstd:2"), -1);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "editor/export/pck_compression/block_size", PROPERTY_HINT_RANGE, "4096,16777216,1,suffix:B"), 65536);
 
 	GLOBAL_DEF("editor/version_control/plugin_name", "");
 	GLOBAL_DEF("editor/version_control/autoload_on_startup", false);
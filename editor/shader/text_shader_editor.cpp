@@ -443,7 +443,6 @@ void ShaderTextEditor::_code_complete_script(const String &p_code, List<ScriptLa
 		r_options->push_back(E);
 	}
 
-	ShaderLanguage sl;
 	String calltip;
 	ShaderLanguage::ShaderCompileInfo comp_info;
 	comp_info.global_shader_uniform_type_func = _get_global_shader_uniform_type;
@@ -451,7 +450,7 @@ void ShaderTextEditor::_code_complete_script(const String &p_code, List<ScriptLa
 	if (shader.is_null()) {
 		comp_info.is_include = true;
 
-		sl.complete(code, comp_info, r_options, calltip);
+		completion_parser.complete(code, comp_info, r_options, calltip);
 		get_text_editor()->set_code_hint(calltip);
 		return;
 	}
@@ -461,7 +460,7 @@ void ShaderTextEditor::_code_complete_script(const String &p_code, List<ScriptLa
 	comp_info.stencil_modes = ShaderTypes::get_singleton()->get_stencil_modes(RenderingServer::ShaderMode(shader->get_mode()));
 	comp_info.shader_types = ShaderTypes::get_singleton()->get_types();
 
-	sl.complete(code, comp_info, r_options, calltip);
+	completion_parser.complete(code, comp_info, r_options, calltip);
 	get_text_editor()->set_code_hint(calltip);
 }
 
@@ -538,9 +537,7 @@ void ShaderTextEditor::_validate_script() {
 
 		set_warning_count(0);
 	} else {
-		ShaderLanguage sl;
-
-		sl.enable_warning_checking(saved_warnings_enabled);
+		validation_parser.enable_warning_checking(saved_warnings_enabled);
 		uint32_t flags = saved_warning_flags;
 		if (shader.is_null()) {
 			if (flags & ShaderWarning::UNUSED_CONSTANT) {
@@ -559,7 +556,7 @@ void ShaderTextEditor::_validate_script() {
 				flags &= ~(ShaderWarning::UNUSED_VARYING);
 			}
 		}
-		sl.set_warning_flags(flags);
+		validation_parser.set_warning_flags(flags);
 
 		ShaderLanguage::ShaderCompileInfo comp_info;
 		comp_info.global_shader_uniform_type_func = _get_global_shader_uniform_type;
@@ -576,10 +573,10 @@ void ShaderTextEditor::_validate_script() {
 
 		code = code_pp;
 		//compiler error
-		last_compile_result = sl.compile(code, comp_info);
+		last_compile_result = validation_parser.compile(code, comp_info);
 
 		if (last_compile_result != OK) {
-			Vector<ShaderLanguage::FilePosition> include_positions = sl.get_include_positions();
+			Vector<ShaderLanguage::FilePosition> include_positions = validation_parser.get_include_positions();
 
 			String err_text;
 			int err_line;
@@ -589,15 +586,15 @@ void ShaderTextEditor::_validate_script() {
 
 				const String inc_file = include_positions[include_positions.size() - 1].file;
 				const int inc_line = include_positions[include_positions.size() - 1].line;
-				const String message = sl.get_error_text().replace("[", "[lb]");
+				const String message = validation_parser.get_error_text().replace("[", "[lb]");
 
 				err_text = vformat(TTR("Error at line %d in include %s:%d:"), err_line, inc_file, inc_line) + " " + message;
 				set_error_count(include_positions.size() - 1);
 			} else {
 				// Error in the main file.
-				err_line = sl.get_error_line();
+				err_line = validation_parser.get_error_line();
 
-				const String message = sl.get_error_text().replace("[", "[lb]");
+				const String message = validation_parser.get_error_text().replace("[", "[lb]");
 
 				err_text = vformat(TTR("Error at line %d:"), err_line) + " " + message;
 				set_error_count(0);
@@ -615,7 +612,7 @@ void ShaderTextEditor::_validate_script() {
 			warnings_panel->clear();
 		}
 		warnings.clear();
-		for (List<ShaderWarning>::Element *E = sl.get_warnings_ptr(); E; E = E->next()) {
+		for (List<ShaderWarning>::Element *E = validation_parser.get_warnings_ptr(); E; E = E->next()) {
 			warnings.push_back(E->get());
 		}
 		if (warnings.size() > 0 && last_compile_result == OK) {
@@ -34,6 +34,7 @@
 #include "editor/shader/shader_editor.h"
 #include "scene/gui/menu_button.h"
 #include "scene/gui/rich_text_label.h"
+#include "servers/rendering/shader_language.h"
 #include "servers/rendering/shader_warnings.h"
 
 class GDShaderSyntaxHighlighter : public CodeHighlighter {
@@ -67,6 +68,10 @@ class ShaderTextEditor : public CodeTextEditor {
 	List<ShaderWarning> warnings;
 	Error last_compile_result = Error::OK;
 
+	// Kept between edits, so only the edited part of the code is tokenized again.
+	ShaderLanguage validation_parser;
+	ShaderLanguage completion_parser;
+
 	void _check_shader_mode();
 	void _update_warning_panel();
 
@@ -41,6 +41,7 @@
 #include "core/input/input.h"
 #include "core/input/input_map.h"
 #include "core/io/dir_access.h"
+#include "core/io/file_access_async.h"
 #include "core/io/file_access_pack.h"
 #include "core/io/file_access_zip.h"
 #include "core/io/image.h"
@@ -640,6 +641,10 @@ void Main::print_help(const char *p_binary) {
 	print_help_option("-b, --breakpoints", "Breakpoint list as source::line comma-separated pairs, no spaces (use %%20 instead).\n");
 	print_help_option("--ignore-error-breaks", "If debugger is connected, prevents sending error breakpoints.\n");
 	print_help_option("--profiling", "Enable profiling in the script debugger.\n");
+#if defined(DEBUG_ENABLED) && defined(MODULE_GDSCRIPT_ENABLED)
+	print_help_option("--gdscript-sample-profile <path>", "Sample running GDScript call stacks and save them to <path> in folded flamegraph format on exit. Per-line counts are saved next to it as CSV.\n", CLI_OPTION_AVAILABILITY_TEMPLATE_DEBUG);
+	print_help_option("--gdscript-sample-interval <usec>", "Interval between GDScript samples in microseconds (used with --gdscript-sample-profile, defaults to 1000).\n", CLI_OPTION_AVAILABILITY_TEMPLATE_DEBUG);
+#endif
 	print_help_option("--gpu-profile", "Show a GPU profile of the tasks that took the most time during frame rendering.\n");
 	print_help_option("--gpu-validation", "Enable graphics API validation layers for debugging.\n");
 #ifdef DEBUG_ENABLED
@@ -5067,6 +5072,8 @@ void Main::cleanup(bool p_force) {
 	}
 
 	ResourceLoader::clear_thread_load_tasks();
+	// I/O threads resolve paths through the pack, project settings and importer, which are freed below.
+	FileAccessAsync::finalize();
 
 	ResourceLoader::remove_custom_loaders();
 	ResourceSaver::remove_custom_savers();
@@ -35,6 +35,7 @@
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
 #include "gdscript_rpc_callable.h"
+#include "gdscript_sampling_profiler.h"
 #include "gdscript_tokenizer_buffer.h"
 #include "gdscript_warning.h"
 
@@ -2289,6 +2290,21 @@ void GDScriptLanguage::init() {
 	if (!ProjectSettings::get_singleton()->is_connected("settings_changed", callable_mp_static(&GDScriptParser::update_project_settings))) {
 		ProjectSettings::get_singleton()->connect("settings_changed", callable_mp_static(&GDScriptParser::update_project_settings));
 	}
+
+	String sample_profile_path;
+	uint64_t sample_interval_usec = 1000;
+	const List<String> cmdline_args = OS::get_singleton()->get_cmdline_args();
+	for (const List<String>::Element *E = cmdline_args.front(); E && E->next(); E = E->next()) {
+		if (E->get() == "--gdscript-sample-profile") {
+			sample_profile_path = E->next()->get();
+		} else if (E->get() == "--gdscript-sample-interval") {
+			sample_interval_usec = E->next()->get().to_int();
+		}
+	}
+	if (!sample_profile_path.is_empty()) {
+		sampling_profiler->set_output_path(sample_profile_path);
+		sampling_profiler->start(sample_interval_usec);
+	}
 #endif // DEBUG_ENABLED
 
 #ifdef TESTS_ENABLED
@@ -2332,6 +2348,18 @@ void GDScriptLanguage::finish() {
 	}
 	finishing = true;
 
+#ifdef DEBUG_ENABLED
+	if (sampling_profiler->is_running()) {
+		sampling_profiler->stop();
+		const String output_path = sampling_profiler->get_output_path();
+		if (!output_path.is_empty()) {
+			print_line(vformat("GDScript sampling profiler: %d samples saved to \"%s\".", sampling_profiler->get_total_samples(), output_path));
+			sampling_profiler->save_folded(output_path);
+			sampling_profiler->save_line_report(output_path.get_basename() + ".lines.csv");
+		}
+	}
+#endif // DEBUG_ENABLED
+
 	// Clear the cache before parsing the script_list
 	GDScriptCache::clear();
 
@@ -2957,6 +2985,7 @@ GDScriptLanguage::GDScriptLanguage() {
 	profiling = false;
 	profile_native_calls = false;
 	script_frame_time = 0;
+	sampling_profiler = memnew(GDScriptSamplingProfiler);
 #endif // DEBUG_ENABLED
 
 	_debug_max_call_stack = GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "debug/settings/gdscript/max_call_stack", PROPERTY_HINT_RANGE, "512," + itos(GDScriptFunction::MAX_CALL_DEPTH - 1) + ",1"), 1024);
@@ -2995,6 +3024,9 @@ GDScriptLanguage::GDScriptLanguage() {
 }
 
 GDScriptLanguage::~GDScriptLanguage() {
+#ifdef DEBUG_ENABLED
+	memdelete(sampling_profiler);
+#endif // DEBUG_ENABLED
 	singleton = nullptr;
 }
 
@@ -40,6 +40,8 @@
 #include "core/object/script_language.h"
 #include "core/templates/rb_set.h"
 
+class GDScriptSamplingProfiler;
+
 class GDScriptNativeClass : public RefCounted {
 	GDCLASS(GDScriptNativeClass, RefCounted);
 
@@ -467,6 +469,9 @@ class GDScriptLanguage : public ScriptLanguage {
 	bool profiling;
 	bool profile_native_calls;
 	uint64_t script_frame_time;
+
+	friend class GDScriptSamplingProfiler;
+	GDScriptSamplingProfiler *sampling_profiler = nullptr;
 #endif
 
 	HashMap<String, ObjectID> orphan_subclasses;
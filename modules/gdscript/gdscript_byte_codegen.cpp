@@ -406,6 +406,7 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 	function->constructors_names = constructors_names;
 	function->utilities_names = utilities_names;
 	function->gds_utilities_names = gds_utilities_names;
+	function->inlined_calls = inlined_calls;
 #endif
 
 	ended = true;
@@ -416,6 +417,10 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 void GDScriptByteCodeGenerator::set_signature(const String &p_signature) {
 	function->profile.signature = p_signature;
 }
+
+void GDScriptByteCodeGenerator::mark_inlined_call(const StringName &p_function_name) {
+	inlined_calls.push_back(Pair<int, StringName>(opcodes.size(), p_function_name));
+}
 #endif
 
 void GDScriptByteCodeGenerator::set_initial_line(int p_line) {
@@ -786,8 +791,44 @@ void GDScriptByteCodeGenerator::write_end_ternary() {
 	ternary_result.pop_back();
 }
 
+// Packed arrays of plain values get dedicated opcodes that access the element storage directly.
+// Returns `OPCODE_END` for types without such an opcode.
+static GDScriptFunction::Opcode _get_packed_array_indexed_opcode(Variant::Type p_type, bool p_set) {
+	switch (p_type) {
+		case Variant::PACKED_BYTE_ARRAY:
+			return p_set ? GDScriptFunction::OPCODE_SET_INDEXED_PACKED_BYTE_ARRAY : GDScriptFunction::OPCODE_GET_INDEXED_PACKED_BYTE_ARRAY;
+		case Variant::PACKED_INT32_ARRAY:
+			return p_set ? GDScriptFunction::OPCODE_SET_INDEXED_PACKED_INT32_ARRAY : GDScriptFunction::OPCODE_GET_INDEXED_PACKED_INT32_ARRAY;
+		case Variant::PACKED_INT64_ARRAY:
+			return p_set ? GDScriptFunction::OPCODE_SET_INDEXED_PACKED_INT64_ARRAY : GDScriptFunction::OPCODE_GET_INDEXED_PACKED_INT64_ARRAY;
+		case Variant::PACKED_FLOAT32_ARRAY:
+			return p_set ? GDScriptFunction::OPCODE_SET_INDEXED_PACKED_FLOAT32_ARRAY : GDScriptFunction::OPCODE_GET_INDEXED_PACKED_FLOAT32_ARRAY;
+		case Variant::PACKED_FLOAT64_ARRAY:
+			return p_set ? GDScriptFunction::OPCODE_SET_INDEXED_PACKED_FLOAT64_ARRAY : GDScriptFunction::OPCODE_GET_INDEXED_PACKED_FLOAT64_ARRAY;
+		case Variant::PACKED_VECTOR2_ARRAY:
+			return p_set ? GDScriptFunction::OPCODE_SET_INDEXED_PACKED_VECTOR2_ARRAY : GDScriptFunction::OPCODE_GET_INDEXED_PACKED_VECTOR2_ARRAY;
+		case Variant::PACKED_VECTOR3_ARRAY:
+			return p_set ? GDScriptFunction::OPCODE_SET_INDEXED_PACKED_VECTOR3_ARRAY : GDScriptFunction::OPCODE_GET_INDEXED_PACKED_VECTOR3_ARRAY;
+		case Variant::PACKED_COLOR_ARRAY:
+			return p_set ? GDScriptFunction::OPCODE_SET_INDEXED_PACKED_COLOR_ARRAY : GDScriptFunction::OPCODE_GET_INDEXED_PACKED_COLOR_ARRAY;
+		case Variant::PACKED_VECTOR4_ARRAY:
+			return p_set ? GDScriptFunction::OPCODE_SET_INDEXED_PACKED_VECTOR4_ARRAY : GDScriptFunction::OPCODE_GET_INDEXED_PACKED_VECTOR4_ARRAY;
+		default:
+			return GDScriptFunction::OPCODE_END;
+	}
+}
+
 void GDScriptByteCodeGenerator::write_set(const Address &p_target, const Address &p_index, const Address &p_source) {
 	if (HAS_BUILTIN_TYPE(p_target)) {
+		const GDScriptFunction::Opcode packed_opcode = _get_packed_array_indexed_opcode(p_target.type.builtin_type, true);
+		if (packed_opcode != GDScriptFunction::OPCODE_END && IS_BUILTIN_TYPE(p_index, Variant::INT) &&
+				IS_BUILTIN_TYPE(p_source, Variant::get_indexed_element_type(p_target.type.builtin_type))) {
+			append_opcode(packed_opcode);
+			append(p_target);
+			append(p_index);
+			append(p_source);
+			return;
+		}
 		if (IS_BUILTIN_TYPE(p_index, Variant::INT) && Variant::get_member_validated_indexed_setter(p_target.type.builtin_type) &&
 				IS_BUILTIN_TYPE(p_source, Variant::get_indexed_element_type(p_target.type.builtin_type))) {
 			// Use indexed setter instead.
@@ -817,6 +858,14 @@ void GDScriptByteCodeGenerator::write_set(const Address &p_target, const Address
 
 void GDScriptByteCodeGenerator::write_get(const Address &p_target, const Address &p_index, const Address &p_source) {
 	if (HAS_BUILTIN_TYPE(p_source)) {
+		const GDScriptFunction::Opcode packed_opcode = _get_packed_array_indexed_opcode(p_source.type.builtin_type, false);
+		if (packed_opcode != GDScriptFunction::OPCODE_END && IS_BUILTIN_TYPE(p_index, Variant::INT)) {
+			append_opcode(packed_opcode);
+			append(p_source);
+			append(p_index);
+			append(p_target);
+			return;
+		}
 		if (IS_BUILTIN_TYPE(p_index, Variant::INT) && Variant::get_member_validated_indexed_getter(p_source.type.builtin_type)) {
 			// Use indexed getter instead.
 			Variant::ValidatedIndexedGetter getter = Variant::get_member_validated_indexed_getter(p_source.type.builtin_type);
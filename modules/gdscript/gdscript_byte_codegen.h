@@ -133,6 +133,7 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	Vector<String> constructors_names;
 	Vector<String> utilities_names;
 	Vector<String> gds_utilities_names;
+	Vector<Pair<int, StringName>> inlined_calls;
 	void add_debug_name(Vector<String> &vector, int index, const String &name) {
 		if (index >= vector.size()) {
 			vector.resize(index + 1);
@@ -478,6 +479,7 @@ public:
 
 #ifdef DEBUG_ENABLED
 	virtual void set_signature(const String &p_signature) override;
+	virtual void mark_inlined_call(const StringName &p_function_name) override;
 #endif
 	virtual void set_initial_line(int p_line) override;
 
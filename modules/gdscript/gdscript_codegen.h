@@ -87,6 +87,7 @@ public:
 
 #ifdef DEBUG_ENABLED
 	virtual void set_signature(const String &p_signature) = 0;
+	virtual void mark_inlined_call(const StringName &p_function_name) = 0;
 #endif
 	virtual void set_initial_line(int p_line) = 0;
 
@@ -87,6 +87,82 @@ void GDScriptCompiler::_set_error(const String &p_error, const GDScriptParser::N
 	}
 }
 
+// Upper bound on the number of expression nodes a function body may have to be inlined.
+#define INLINE_EXPRESSION_MAX_NODES 24
+
+// Whether the expression reads (part of) a callee parameter, which is bound to the caller's own storage once inlined.
+static bool _is_parameter_access(const GDScriptParser::ExpressionNode *p_expression) {
+	while (p_expression->type == GDScriptParser::Node::SUBSCRIPT) {
+		p_expression = static_cast<const GDScriptParser::SubscriptNode *>(p_expression)->base;
+	}
+	return p_expression->type == GDScriptParser::Node::IDENTIFIER && static_cast<const GDScriptParser::IdentifierNode *>(p_expression)->source == GDScriptParser::IdentifierNode::FUNCTION_PARAMETER;
+}
+
+static bool _is_inlinable_expression(const GDScriptParser::ExpressionNode *p_expression, int &r_budget) {
+	if (p_expression == nullptr || --r_budget < 0) {
+		return false;
+	}
+	if (p_expression->is_constant) {
+		return true;
+	}
+
+	switch (p_expression->type) {
+		case GDScriptParser::Node::LITERAL:
+			return true;
+		case GDScriptParser::Node::IDENTIFIER:
+			return static_cast<const GDScriptParser::IdentifierNode *>(p_expression)->source == GDScriptParser::IdentifierNode::FUNCTION_PARAMETER;
+		case GDScriptParser::Node::UNARY_OPERATOR:
+			return _is_inlinable_expression(static_cast<const GDScriptParser::UnaryOpNode *>(p_expression)->operand, r_budget);
+		case GDScriptParser::Node::BINARY_OPERATOR: {
+			const GDScriptParser::BinaryOpNode *binary = static_cast<const GDScriptParser::BinaryOpNode *>(p_expression);
+			return _is_inlinable_expression(binary->left_operand, r_budget) && _is_inlinable_expression(binary->right_operand, r_budget);
+		}
+		case GDScriptParser::Node::TERNARY_OPERATOR: {
+			const GDScriptParser::TernaryOpNode *ternary = static_cast<const GDScriptParser::TernaryOpNode *>(p_expression);
+			return _is_inlinable_expression(ternary->condition, r_budget) && _is_inlinable_expression(ternary->true_expr, r_budget) && _is_inlinable_expression(ternary->false_expr, r_budget);
+		}
+		case GDScriptParser::Node::SUBSCRIPT: {
+			const GDScriptParser::SubscriptNode *subscript = static_cast<const GDScriptParser::SubscriptNode *>(p_expression);
+			if (subscript->is_attribute) {
+				return _is_inlinable_expression(subscript->base, r_budget);
+			}
+			return _is_inlinable_expression(subscript->base, r_budget) && _is_inlinable_expression(subscript->index, r_budget);
+		}
+		case GDScriptParser::Node::CALL: {
+			// Only calls that can't reach script code, so inlining never recurses.
+			const GDScriptParser::CallNode *call = static_cast<const GDScriptParser::CallNode *>(p_expression);
+			if (call->is_super || call->callee == nullptr) {
+				return false;
+			}
+			if (call->callee->type == GDScriptParser::Node::IDENTIFIER) {
+				if (GDScriptParser::get_builtin_type(call->function_name) >= Variant::VARIANT_MAX && !Variant::has_utility_function(call->function_name) && !GDScriptUtilityFunctions::function_exists(call->function_name)) {
+					return false;
+				}
+			} else if (call->callee->type == GDScriptParser::Node::SUBSCRIPT) {
+				const GDScriptParser::SubscriptNode *subscript = static_cast<const GDScriptParser::SubscriptNode *>(call->callee);
+				const GDScriptParser::DataType base_type = subscript->base->get_datatype();
+				if (!subscript->is_attribute || !base_type.is_hard_type() || base_type.kind != GDScriptParser::DataType::BUILTIN || !_is_inlinable_expression(subscript->base, r_budget)) {
+					return false;
+				}
+				// Arguments are passed by value, so a mutating method must not reach the caller's variable through the parameter.
+				if (_is_parameter_access(subscript->base) && !(Variant::has_builtin_method(base_type.builtin_type, call->function_name) && Variant::is_builtin_method_const(base_type.builtin_type, call->function_name))) {
+					return false;
+				}
+			} else {
+				return false;
+			}
+			for (const GDScriptParser::ExpressionNode *argument : call->arguments) {
+				if (!_is_inlinable_expression(argument, r_budget)) {
+					return false;
+				}
+			}
+			return true;
+		}
+		default:
+			return false;
+	}
+}
+
 GDScriptDataType GDScriptCompiler::_gdtype_from_datatype(const GDScriptParser::DataType &p_datatype, GDScript *p_owner, bool p_handle_metatype) {
 	if (!p_datatype.is_set() || !p_datatype.is_hard_type() || p_datatype.is_coroutine) {
 		return GDScriptDataType();
@@ -251,6 +327,94 @@ static bool _can_use_validate_call(const MethodBind *p_method, const Vector<GDSc
 	return true;
 }
 
+const GDScriptParser::FunctionNode *GDScriptCompiler::_get_inlinable_function(CodeGen &codegen, const GDScriptParser::CallNode *p_call, const Vector<GDScriptCodeGenerator::Address> &p_arguments) {
+#ifdef DEBUG_ENABLED
+	// Inlined code has no stack frame of its own, so breakpoints inside the callee would never be hit.
+	if (EngineDebugger::is_active()) {
+		return nullptr;
+	}
+#endif
+
+	// Static functions of the same class are always called through the class, so they can't be overridden.
+	if (p_call->is_super || !p_call->is_static || codegen.class_node == nullptr || !codegen.class_node->has_function(p_call->function_name)) {
+		return nullptr;
+	}
+	const GDScriptParser::FunctionNode *function = codegen.class_node->get_member(p_call->function_name).function;
+	if (function == nullptr || !function->is_static || function->is_coroutine || function->is_vararg() || function->is_abstract || function == codegen.function_node) {
+		return nullptr;
+	}
+	if (function->body == nullptr || function->body->statements.size() != 1 || function->body->statements[0]->type != GDScriptParser::Node::RETURN) {
+		return nullptr;
+	}
+	const GDScriptParser::ReturnNode *return_node = static_cast<const GDScriptParser::ReturnNode *>(function->body->statements[0]);
+	if (return_node->return_value == nullptr) {
+		return nullptr;
+	}
+
+	// Default arguments and implicit conversions would need the callee's prologue, so arguments must match exactly.
+	if (function->parameters.size() != p_arguments.size()) {
+		return nullptr;
+	}
+	for (int i = 0; i < function->parameters.size(); i++) {
+		GDScriptDataType parameter_type = _gdtype_from_datatype(function->parameters[i]->get_datatype(), codegen.script);
+		if (parameter_type.kind != GDScriptDataType::BUILTIN || parameter_type.has_container_element_types() || !(parameter_type == p_arguments[i].type)) {
+			return nullptr;
+		}
+	}
+	GDScriptDataType return_type = _gdtype_from_datatype(function->get_datatype(), codegen.script);
+	if (return_type.kind != GDScriptDataType::BUILTIN || return_type.has_container_element_types() || !(return_type == _gdtype_from_datatype(return_node->return_value->get_datatype(), codegen.script))) {
+		return nullptr;
+	}
+
+	int budget = INLINE_EXPRESSION_MAX_NODES;
+	if (!_is_inlinable_expression(return_node->return_value, budget)) {
+		return nullptr;
+	}
+	return function;
+}
+
+bool GDScriptCompiler::_try_inline_call(CodeGen &codegen, Error &r_error, const GDScriptParser::CallNode *p_call, const Vector<GDScriptCodeGenerator::Address> &p_arguments, const GDScriptCodeGenerator::Address &p_result) {
+	const GDScriptParser::FunctionNode *function = _get_inlinable_function(codegen, p_call, p_arguments);
+	if (function == nullptr) {
+		return false;
+	}
+	const GDScriptParser::ReturnNode *return_node = static_cast<const GDScriptParser::ReturnNode *>(function->body->statements[0]);
+
+	// The returned expression only refers to the callee parameters, so bind them to the already evaluated arguments.
+	HashMap<StringName, GDScriptCodeGenerator::Address> caller_parameters = codegen.parameters;
+	codegen.parameters.clear();
+	for (int i = 0; i < function->parameters.size(); i++) {
+		codegen.parameters[function->parameters[i]->identifier->name] = p_arguments[i];
+	}
+
+#ifdef DEBUG_ENABLED
+	codegen.generator->mark_inlined_call(p_call->function_name);
+#endif
+	GDScriptCodeGenerator::Address value = _parse_expression(codegen, r_error, return_node->return_value);
+	codegen.parameters = caller_parameters;
+	if (r_error) {
+		return true;
+	}
+
+	if (p_result.mode != GDScriptCodeGenerator::Address::NIL) {
+		codegen.generator->write_assign(p_result, value);
+	}
+	if (value.mode == GDScriptCodeGenerator::Address::TEMPORARY) {
+		// A bare parameter resolves to the argument temporary itself, which the caller pops.
+		bool is_argument = false;
+		for (const GDScriptCodeGenerator::Address &argument : p_arguments) {
+			if (argument.mode == GDScriptCodeGenerator::Address::TEMPORARY && argument.address == value.address) {
+				is_argument = true;
+				break;
+			}
+		}
+		if (!is_argument) {
+			codegen.generator->pop_temporary();
+		}
+	}
+	return true;
+}
+
 GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &codegen, Error &r_error, const GDScriptParser::ExpressionNode *p_expression, bool p_root, bool p_initializer) {
 	if (p_expression->is_constant && !(p_expression->get_datatype().is_meta_type && p_expression->get_datatype().kind == GDScriptParser::DataType::CLASS)) {
 		return codegen.add_constant(p_expression->reduced_value);
@@ -651,6 +815,11 @@ GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &code
 								// Not exact arguments, but still can use method bind call.
 								gen->write_call_method_bind(result, self, method, arguments);
 							}
+						} else if (!is_awaited && _try_inline_call(codegen, r_error, call, arguments, result)) {
+							// Small static helper, compiled in place.
+							if (r_error) {
+								return GDScriptCodeGenerator::Address();
+							}
 						} else if (call->is_static || codegen.is_static || (codegen.function_node && codegen.function_node->is_static) || call->function_name == "new") {
 							GDScriptCodeGenerator::Address self;
 							self.mode = GDScriptCodeGenerator::Address::CLASS;
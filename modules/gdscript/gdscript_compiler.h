@@ -149,6 +149,8 @@ class GDScriptCompiler {
 
 	GDScriptDataType _gdtype_from_datatype(const GDScriptParser::DataType &p_datatype, GDScript *p_owner, bool p_handle_metatype = true);
 
+	const GDScriptParser::FunctionNode *_get_inlinable_function(CodeGen &codegen, const GDScriptParser::CallNode *p_call, const Vector<GDScriptCodeGenerator::Address> &p_arguments);
+	bool _try_inline_call(CodeGen &codegen, Error &r_error, const GDScriptParser::CallNode *p_call, const Vector<GDScriptCodeGenerator::Address> &p_arguments, const GDScriptCodeGenerator::Address &p_result);
 	GDScriptCodeGenerator::Address _parse_expression(CodeGen &codegen, Error &r_error, const GDScriptParser::ExpressionNode *p_expression, bool p_root = false, bool p_initializer = false);
 	GDScriptCodeGenerator::Address _parse_match_pattern(CodeGen &codegen, Error &r_error, const GDScriptParser::PatternNode *p_pattern, const GDScriptCodeGenerator::Address &p_value_addr, const GDScriptCodeGenerator::Address &p_type_addr, const GDScriptCodeGenerator::Address &p_previous_test, bool p_is_first, bool p_is_nested);
 	List<GDScriptCodeGenerator::Address> _add_block_locals(CodeGen &codegen, const GDScriptParser::SuiteNode *p_block);
@@ -104,6 +104,12 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 		StringBuilder text;
 		int incr = 0;
 
+		for (const Pair<int, StringName> &inlined_call : inlined_calls) {
+			if (inlined_call.first == ip) {
+				print_line(vformat(" %d: ; inlined call to %s()", ip, inlined_call.second));
+			}
+		}
+
 		text += " ";
 		text += itos(ip);
 		text += ": ";
@@ -300,6 +306,48 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+
+#define DISASSEMBLE_GET_INDEXED_PACKED(m_type)         \
+	case OPCODE_GET_INDEXED_PACKED_##m_type##_ARRAY: { \
+		text += "get indexed (packed ";                \
+		text += #m_type;                               \
+		text += ") ";                                  \
+		text += DADDR(3);                              \
+		text += " = ";                                 \
+		text += DADDR(1);                              \
+		text += "[";                                   \
+		text += DADDR(2);                              \
+		text += "]";                                   \
+		incr += 4;                                     \
+	} break
+
+#define DISASSEMBLE_SET_INDEXED_PACKED(m_type)         \
+	case OPCODE_SET_INDEXED_PACKED_##m_type##_ARRAY: { \
+		text += "set indexed (packed ";                \
+		text += #m_type;                               \
+		text += ") ";                                  \
+		text += DADDR(1);                              \
+		text += "[";                                   \
+		text += DADDR(2);                              \
+		text += "] = ";                                \
+		text += DADDR(3);                              \
+		incr += 4;                                     \
+	} break
+
+#define DISASSEMBLE_INDEXED_PACKED_TYPES(m_macro) \
+	m_macro(BYTE);                                \
+	m_macro(INT32);                               \
+	m_macro(INT64);                               \
+	m_macro(FLOAT32);                             \
+	m_macro(FLOAT64);                             \
+	m_macro(VECTOR2);                             \
+	m_macro(VECTOR3);                             \
+	m_macro(COLOR);                               \
+	m_macro(VECTOR4)
+
+			DISASSEMBLE_INDEXED_PACKED_TYPES(DISASSEMBLE_GET_INDEXED_PACKED);
+			DISASSEMBLE_INDEXED_PACKED_TYPES(DISASSEMBLE_SET_INDEXED_PACKED);
+
 			case OPCODE_SET_NAMED: {
 				text += "set_named ";
 				text += DADDR(1);
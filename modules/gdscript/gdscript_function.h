@@ -276,6 +276,24 @@ public:
 		OPCODE_GET_KEYED,
 		OPCODE_GET_KEYED_VALIDATED,
 		OPCODE_GET_INDEXED_VALIDATED,
+		OPCODE_GET_INDEXED_PACKED_BYTE_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_INT32_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_INT64_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_FLOAT32_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_FLOAT64_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_VECTOR2_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_VECTOR3_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_COLOR_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_VECTOR4_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_BYTE_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_INT32_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_INT64_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_FLOAT32_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_FLOAT64_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_VECTOR2_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_VECTOR3_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_COLOR_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_VECTOR4_ARRAY,
 		OPCODE_SET_NAMED,
 		OPCODE_SET_NAMED_VALIDATED,
 		OPCODE_GET_NAMED,
@@ -541,6 +559,8 @@ private:
 	Vector<String> constructors_names;
 	Vector<String> utilities_names;
 	Vector<String> gds_utilities_names;
+	// Bytecode position and callee name of each call inlined by the compiler.
+	Vector<Pair<int, StringName>> inlined_calls;
 
 	struct Profile {
 		StringName signature;
@@ -0,0 +1,210 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_sampling_profiler.h"
+
+#ifdef DEBUG_ENABLED
+
+#include "gdscript.h"
+#include "gdscript_function.h"
+
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/sort_array.h"
+
+GDScriptSamplingProfiler *GDScriptSamplingProfiler::singleton = nullptr;
+SafeNumeric<uint32_t> GDScriptSamplingProfiler::sample_tick;
+thread_local uint32_t GDScriptSamplingProfiler::last_sample_tick = 0;
+
+struct _GDScriptSampleSort {
+	const HashMap<String, uint64_t> *samples = nullptr;
+
+	_FORCE_INLINE_ bool operator()(const String &p_a, const String &p_b) const {
+		const uint64_t a = (*samples)[p_a];
+		const uint64_t b = (*samples)[p_b];
+		if (a != b) {
+			return a > b;
+		}
+		return p_a < p_b;
+	}
+};
+
+void GDScriptSamplingProfiler::_thread_func(void *p_userdata) {
+	GDScriptSamplingProfiler *self = static_cast<GDScriptSamplingProfiler *>(p_userdata);
+	while (self->running.is_set()) {
+		OS::get_singleton()->delay_usec(self->interval_usec);
+		sample_tick.increment();
+	}
+}
+
+void GDScriptSamplingProfiler::take_sample() {
+	last_sample_tick = sample_tick.get();
+	if (singleton && singleton->running.is_set()) {
+		singleton->_record_sample();
+	}
+}
+
+void GDScriptSamplingProfiler::_record_sample() {
+	const GDScriptLanguage::CallLevel *cl = GDScriptLanguage::_call_stack;
+	if (!cl) {
+		return;
+	}
+
+	// The call stack is a reverse linked list, innermost frame first.
+	LocalVector<String> frames;
+	frames.reserve(GDScriptLanguage::_call_stack_size);
+	while (cl) {
+		String source;
+		String function_name;
+		if (cl->function) {
+			source = cl->function->get_source();
+			function_name = cl->function->get_name();
+		}
+		if (source.is_empty()) {
+			source = "<built-in>";
+		}
+		frames.push_back(vformat("%s (%s:%d)", function_name, source, cl->line ? *cl->line : 0));
+		cl = cl->prev;
+	}
+
+	String path;
+	for (int64_t i = (int64_t)frames.size() - 1; i >= 0; i--) {
+		if (!path.is_empty()) {
+			path += ";";
+		}
+		// Folded stacks use ';' as the frame separator.
+		path += frames[i].replace(";", ":");
+	}
+
+	const GDScriptLanguage::CallLevel *leaf = GDScriptLanguage::_call_stack;
+	String line_key = (leaf->function ? String(leaf->function->get_source()) : String("<built-in>")) + ":" + itos(leaf->line ? *leaf->line : 0);
+
+	MutexLock lock(mutex);
+	path_samples[path]++;
+	line_samples[line_key]++;
+	total_samples++;
+}
+
+void GDScriptSamplingProfiler::start(uint64_t p_interval_usec) {
+	if (running.is_set()) {
+		return;
+	}
+	interval_usec = MAX<uint64_t>(p_interval_usec, 10);
+	running.set();
+	thread.start(_thread_func, this);
+}
+
+void GDScriptSamplingProfiler::stop() {
+	if (!running.is_set()) {
+		return;
+	}
+	running.clear();
+	thread.wait_to_finish();
+}
+
+void GDScriptSamplingProfiler::clear() {
+	MutexLock lock(mutex);
+	path_samples.clear();
+	line_samples.clear();
+	total_samples = 0;
+}
+
+uint64_t GDScriptSamplingProfiler::get_total_samples() {
+	MutexLock lock(mutex);
+	return total_samples;
+}
+
+HashMap<String, uint64_t> GDScriptSamplingProfiler::get_path_samples() {
+	MutexLock lock(mutex);
+	return path_samples;
+}
+
+HashMap<String, uint64_t> GDScriptSamplingProfiler::get_line_samples() {
+	MutexLock lock(mutex);
+	return line_samples;
+}
+
+Error GDScriptSamplingProfiler::save_folded(const String &p_path) {
+	const HashMap<String, uint64_t> samples = get_path_samples();
+
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(f.is_null(), err, vformat("Cannot open file '%s' to save GDScript samples.", p_path));
+
+	LocalVector<String> keys;
+	keys.reserve(samples.size());
+	for (const KeyValue<String, uint64_t> &E : samples) {
+		keys.push_back(E.key);
+	}
+	keys.sort();
+
+	for (const String &key : keys) {
+		f->store_line(key + " " + itos(samples[key]));
+	}
+	return OK;
+}
+
+Error GDScriptSamplingProfiler::save_line_report(const String &p_path) {
+	const HashMap<String, uint64_t> samples = get_line_samples();
+	const uint64_t total = MAX<uint64_t>(get_total_samples(), 1);
+
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(f.is_null(), err, vformat("Cannot open file '%s' to save GDScript line samples.", p_path));
+
+	LocalVector<String> keys;
+	keys.reserve(samples.size());
+	for (const KeyValue<String, uint64_t> &E : samples) {
+		keys.push_back(E.key);
+	}
+	SortArray<String, _GDScriptSampleSort> sorter;
+	sorter.compare.samples = &samples;
+	sorter.sort(keys.ptr(), keys.size());
+
+	f->store_line("line,samples,percent");
+	for (const String &key : keys) {
+		const uint64_t count = samples[key];
+		f->store_line(vformat("%s,%d,%.2f", key, count, 100.0 * count / total));
+	}
+	return OK;
+}
+
+GDScriptSamplingProfiler::GDScriptSamplingProfiler() {
+	ERR_FAIL_COND(singleton);
+	singleton = this;
+}
+
+GDScriptSamplingProfiler::~GDScriptSamplingProfiler() {
+	stop();
+	singleton = nullptr;
+}
+
+#endif // DEBUG_ENABLED
@@ -0,0 +1,93 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG_ENABLED
+
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/string/ustring.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/safe_refcount.h"
+
+// Statistical profiler for GDScript. A background thread periodically bumps a
+// global tick; each thread running GDScript notices the change at its next
+// `OPCODE_LINE` and records its own call stack (function and current line of
+// every frame). Sampling at line boundaries keeps the interpreter loop free of
+// timing calls and avoids reading another thread's stack while it changes.
+class GDScriptSamplingProfiler {
+	static GDScriptSamplingProfiler *singleton;
+
+	static SafeNumeric<uint32_t> sample_tick;
+	static thread_local uint32_t last_sample_tick;
+
+	Thread thread;
+	SafeFlag running;
+	uint64_t interval_usec = 1000;
+	String output_path;
+
+	Mutex mutex;
+	HashMap<String, uint64_t> path_samples; // Folded call path -> sample count.
+	HashMap<String, uint64_t> line_samples; // "source:line" of the innermost frame -> sample count.
+	uint64_t total_samples = 0;
+
+	static void _thread_func(void *p_userdata);
+	void _record_sample();
+
+public:
+	_FORCE_INLINE_ static GDScriptSamplingProfiler *get_singleton() { return singleton; }
+
+	// Cheap enough to be checked on every line: the tick only changes while sampling is running.
+	_FORCE_INLINE_ static bool is_sample_pending() { return unlikely(sample_tick.get() != last_sample_tick); }
+	static void take_sample();
+
+	void start(uint64_t p_interval_usec);
+	void stop();
+	bool is_running() const { return running.is_set(); }
+	void clear();
+
+	void set_output_path(const String &p_path) { output_path = p_path; }
+	String get_output_path() const { return output_path; }
+
+	uint64_t get_total_samples();
+	HashMap<String, uint64_t> get_path_samples();
+	HashMap<String, uint64_t> get_line_samples();
+
+	// Writes call paths in the "folded stacks" format understood by flamegraph.pl, speedscope and similar tools.
+	Error save_folded(const String &p_path);
+	// Writes per-line sample counts as CSV, sorted by descending count.
+	Error save_line_report(const String &p_path);
+
+	GDScriptSamplingProfiler();
+	~GDScriptSamplingProfiler();
+};
+
+#endif // DEBUG_ENABLED
@@ -31,6 +31,7 @@
 #include "gdscript.h"
 #include "gdscript_function.h"
 #include "gdscript_lambda_callable.h"
+#include "gdscript_sampling_profiler.h"
 
 #include "core/os/os.h"
 
@@ -265,6 +266,24 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_GET_KEYED,                              \
 		&&OPCODE_GET_KEYED_VALIDATED,                    \
 		&&OPCODE_GET_INDEXED_VALIDATED,                  \
+		&&OPCODE_GET_INDEXED_PACKED_BYTE_ARRAY,          \
+		&&OPCODE_GET_INDEXED_PACKED_INT32_ARRAY,         \
+		&&OPCODE_GET_INDEXED_PACKED_INT64_ARRAY,         \
+		&&OPCODE_GET_INDEXED_PACKED_FLOAT32_ARRAY,       \
+		&&OPCODE_GET_INDEXED_PACKED_FLOAT64_ARRAY,       \
+		&&OPCODE_GET_INDEXED_PACKED_VECTOR2_ARRAY,       \
+		&&OPCODE_GET_INDEXED_PACKED_VECTOR3_ARRAY,       \
+		&&OPCODE_GET_INDEXED_PACKED_COLOR_ARRAY,         \
+		&&OPCODE_GET_INDEXED_PACKED_VECTOR4_ARRAY,       \
+		&&OPCODE_SET_INDEXED_PACKED_BYTE_ARRAY,          \
+		&&OPCODE_SET_INDEXED_PACKED_INT32_ARRAY,         \
+		&&OPCODE_SET_INDEXED_PACKED_INT64_ARRAY,         \
+		&&OPCODE_SET_INDEXED_PACKED_FLOAT32_ARRAY,       \
+		&&OPCODE_SET_INDEXED_PACKED_FLOAT64_ARRAY,       \
+		&&OPCODE_SET_INDEXED_PACKED_VECTOR2_ARRAY,       \
+		&&OPCODE_SET_INDEXED_PACKED_VECTOR3_ARRAY,       \
+		&&OPCODE_SET_INDEXED_PACKED_COLOR_ARRAY,         \
+		&&OPCODE_SET_INDEXED_PACKED_VECTOR4_ARRAY,       \
 		&&OPCODE_SET_NAMED,                              \
 		&&OPCODE_SET_NAMED_VALIDATED,                    \
 		&&OPCODE_GET_NAMED,                              \
@@ -1192,6 +1211,80 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+// Direct element access for packed arrays, skipping the validated indexed getter/setter indirection.
+#ifdef DEBUG_ENABLED
+#define PACKED_ARRAY_OOB_BREAK(m_what, m_base, m_index)                                                                          \
+	err_text = "Out of bounds " m_what " index '" + m_index->operator String() + "' (on base: '" + _get_var_type(m_base) + "')"; \
+	OPCODE_BREAK
+#else
+#define PACKED_ARRAY_OOB_BREAK(m_what, m_base, m_index) ((void)0)
+#endif
+
+#define OPCODE_GET_INDEXED_PACKED_ARRAY(m_var_type, m_elem_type, m_get_func, m_ret_type, m_ret_get_func) \
+	OPCODE(OPCODE_GET_INDEXED_PACKED_##m_var_type##_ARRAY) {                                             \
+		CHECK_SPACE(3);                                                                                  \
+		GET_VARIANT_PTR(src, 0);                                                                         \
+		GET_VARIANT_PTR(index, 1);                                                                       \
+		GET_VARIANT_PTR(dst, 2);                                                                         \
+		const Vector<m_elem_type> *array = VariantInternal::m_get_func(src);                             \
+		const int64_t size = array->size();                                                              \
+		int64_t int_index = *VariantInternal::get_int(index);                                            \
+		if (int_index < 0) {                                                                             \
+			int_index += size;                                                                           \
+		}                                                                                                \
+		if (unlikely(int_index < 0 || int_index >= size)) {                                              \
+			PACKED_ARRAY_OOB_BREAK("get", src, index);                                                   \
+		} else {                                                                                         \
+			/* Read the element first, `src` and `dst` may be the same address. */                       \
+			const m_ret_type value = array->ptr()[int_index];                                            \
+			VariantTypeAdjust<m_ret_type>::adjust(dst);                                                  \
+			*VariantInternal::m_ret_get_func(dst) = value;                                               \
+		}                                                                                                \
+		ip += 4;                                                                                         \
+	}                                                                                                    \
+	DISPATCH_OPCODE
+
+			OPCODE_GET_INDEXED_PACKED_ARRAY(BYTE, uint8_t, get_byte_array, int64_t, get_int);
+			OPCODE_GET_INDEXED_PACKED_ARRAY(INT32, int32_t, get_int32_array, int64_t, get_int);
+			OPCODE_GET_INDEXED_PACKED_ARRAY(INT64, int64_t, get_int64_array, int64_t, get_int);
+			OPCODE_GET_INDEXED_PACKED_ARRAY(FLOAT32, float, get_float32_array, double, get_float);
+			OPCODE_GET_INDEXED_PACKED_ARRAY(FLOAT64, double, get_float64_array, double, get_float);
+			OPCODE_GET_INDEXED_PACKED_ARRAY(VECTOR2, Vector2, get_vector2_array, Vector2, get_vector2);
+			OPCODE_GET_INDEXED_PACKED_ARRAY(VECTOR3, Vector3, get_vector3_array, Vector3, get_vector3);
+			OPCODE_GET_INDEXED_PACKED_ARRAY(COLOR, Color, get_color_array, Color, get_color);
+			OPCODE_GET_INDEXED_PACKED_ARRAY(VECTOR4, Vector4, get_vector4_array, Vector4, get_vector4);
+
+#define OPCODE_SET_INDEXED_PACKED_ARRAY(m_var_type, m_elem_type, m_get_func, m_value_type, m_value_get_func) \
+	OPCODE(OPCODE_SET_INDEXED_PACKED_##m_var_type##_ARRAY) {                                                 \
+		CHECK_SPACE(3);                                                                                      \
+		GET_VARIANT_PTR(dst, 0);                                                                             \
+		GET_VARIANT_PTR(index, 1);                                                                           \
+		GET_VARIANT_PTR(value, 2);                                                                           \
+		Vector<m_elem_type> *array = VariantInternal::m_get_func(dst);                                       \
+		const int64_t size = array->size();                                                                  \
+		int64_t int_index = *VariantInternal::get_int(index);                                                \
+		if (int_index < 0) {                                                                                 \
+			int_index += size;                                                                               \
+		}                                                                                                    \
+		if (unlikely(int_index < 0 || int_index >= size)) {                                                  \
+			PACKED_ARRAY_OOB_BREAK("set", dst, index);                                                       \
+		} else {                                                                                             \
+			array->ptrw()[int_index] = m_elem_type(*VariantInternal::m_value_get_func(value));               \
+		}                                                                                                    \
+		ip += 4;                                                                                             \
+	}                                                                                                        \
+	DISPATCH_OPCODE
+
+			OPCODE_SET_INDEXED_PACKED_ARRAY(BYTE, uint8_t, get_byte_array, int64_t, get_int);
+			OPCODE_SET_INDEXED_PACKED_ARRAY(INT32, int32_t, get_int32_array, int64_t, get_int);
+			OPCODE_SET_INDEXED_PACKED_ARRAY(INT64, int64_t, get_int64_array, int64_t, get_int);
+			OPCODE_SET_INDEXED_PACKED_ARRAY(FLOAT32, float, get_float32_array, double, get_float);
+			OPCODE_SET_INDEXED_PACKED_ARRAY(FLOAT64, double, get_float64_array, double, get_float);
+			OPCODE_SET_INDEXED_PACKED_ARRAY(VECTOR2, Vector2, get_vector2_array, Vector2, get_vector2);
+			OPCODE_SET_INDEXED_PACKED_ARRAY(VECTOR3, Vector3, get_vector3_array, Vector3, get_vector3);
+			OPCODE_SET_INDEXED_PACKED_ARRAY(COLOR, Color, get_color_array, Color, get_color);
+			OPCODE_SET_INDEXED_PACKED_ARRAY(VECTOR4, Vector4, get_vector4_array, Vector4, get_vector4);
+
 			OPCODE(OPCODE_SET_NAMED) {
 				CHECK_SPACE(3);
 
@@ -3882,6 +3975,12 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				line = _code_ptr[ip + 1];
 				ip += 2;
 
+#ifdef DEBUG_ENABLED
+				if (GDScriptSamplingProfiler::is_sample_pending()) {
+					GDScriptSamplingProfiler::take_sample();
+				}
+#endif
+
 				if (EngineDebugger::is_active()) {
 					// line
 					bool do_break = false;
@@ -32,6 +32,8 @@
 
 #include "gdscript_test_runner.h"
 
+#include "../gdscript_sampling_profiler.h"
+
 #include "tests/test_macros.h"
 
 namespace GDScriptTests {
@@ -72,6 +74,53 @@ func _init():
 	CHECK_MESSAGE(int(ref_counted->get_meta("result")) == 42, "The script should assign object metadata successfully.");
 }
 
+#ifdef DEBUG_ENABLED
+TEST_CASE("[Modules][GDScript] Sampling profiler records running call paths") {
+	GDScriptLanguage::get_singleton()->init();
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+func busy_loop():
+	var total := 0
+	for i in 100000:
+		total += i
+	return total
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should parse successfully.");
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+
+	GDScriptSamplingProfiler *profiler = GDScriptSamplingProfiler::get_singleton();
+	REQUIRE(profiler != nullptr);
+	profiler->clear();
+	profiler->start(50);
+	// Sampling is statistical; keep the script busy until at least one sample lands.
+	for (int i = 0; i < 100 && profiler->get_total_samples() == 0; i++) {
+		ref_counted->call("busy_loop");
+	}
+	profiler->stop();
+
+	CHECK_MESSAGE(profiler->get_total_samples() > 0, "The profiler should sample the running script.");
+	bool found_function = false;
+	for (const KeyValue<String, uint64_t> &E : profiler->get_path_samples()) {
+		found_function = found_function || E.key.contains("busy_loop");
+	}
+	CHECK_MESSAGE(found_function, "Sampled call paths should name the running function.");
+
+	uint64_t line_total = 0;
+	for (const KeyValue<String, uint64_t> &E : profiler->get_line_samples()) {
+		line_total += E.value;
+	}
+	CHECK_MESSAGE(line_total == profiler->get_total_samples(), "Every sample should be attributed to a line.");
+	profiler->clear();
+}
+#endif // DEBUG_ENABLED
+
 TEST_CASE("[Modules][GDScript] Validate built-in API") {
 	GDScriptLanguage *lang = GDScriptLanguage::get_singleton();
 
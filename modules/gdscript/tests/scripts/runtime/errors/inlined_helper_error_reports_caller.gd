@@ -0,0 +1,7 @@
+# An inlined helper has no stack frame, so errors in it are reported at the call site.
+static func element(values: PackedInt32Array, index: int) -> int:
+	return values[index]
+
+func test():
+	var values := PackedInt32Array([1, 2, 3])
+	var _value := element(values, 3)
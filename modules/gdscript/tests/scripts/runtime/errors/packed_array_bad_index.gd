@@ -0,0 +1,3 @@
+func test():
+	var array := PackedFloat32Array([1.0, 2.0, 3.0])
+	var _value := array[3]
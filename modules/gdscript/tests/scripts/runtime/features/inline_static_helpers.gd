@@ -0,0 +1,57 @@
+# Small static helpers with a single return expression are inlined at the call site.
+
+const OFFSET = 10
+const PACKED = PackedInt32Array([1, 2])
+
+static func square(x: int) -> int:
+	return x * x
+
+static func clamp_add(a: int, b: int) -> int:
+	return clampi(a + b, 0, 100)
+
+static func pick(flag: bool, a: String, b: String) -> String:
+	return a if flag else b
+
+static func identity(v: Vector2) -> Vector2:
+	return v
+
+static func length_sum(a: Vector2, b: Vector2) -> float:
+	return a.length() + b.length()
+
+static func offset(x: int) -> int:
+	return x + OFFSET
+
+static func grow(values: PackedInt32Array) -> bool:
+	return values.push_back(1)
+
+static func not_inlined(x: int) -> int:
+	var y := x * 2
+	return y
+
+var calls := 0
+
+func side_effect() -> int:
+	calls += 1
+	return calls
+
+func test():
+	print(square(7))
+	print(square(square(2)))
+	print(clamp_add(60, 70))
+	print(pick(true, "yes", "no"))
+	print(pick(false, "yes", "no"))
+	print(identity(Vector2(1, 2)))
+	print(length_sum(Vector2(3, 4), Vector2(0, 1)))
+	print(offset(5))
+	print(not_inlined(21))
+
+	# Arguments are evaluated exactly once, even if used twice in the helper.
+	print(square(side_effect() + 1))
+	print(calls)
+
+	# Arguments are passed by value, mutating them in the helper doesn't affect the caller.
+	var values := PackedInt32Array([1, 2])
+	print(grow(values))
+	print(values)
+	print(grow(PACKED))
+	print(PACKED)
@@ -0,0 +1,55 @@
+# Typed packed array indexing uses dedicated opcodes; check they behave like the generic path.
+
+func test():
+	var floats := PackedFloat32Array([1.0, 2.0, 3.0, 4.0])
+	var copy := floats
+	for i in floats.size():
+		floats[i] = floats[i] * 2.0
+	floats[-1] = 0.5
+	print(floats)
+	print(copy)
+
+	var doubles := PackedFloat64Array([0.25, 0.5])
+	var d: float = doubles[1]
+	doubles[0] = d
+	print(doubles)
+
+	var ints := PackedInt32Array([10, 20, 30])
+	var last: int = ints[-1]
+	ints[0] = last + 1
+	print(ints)
+
+	var longs := PackedInt64Array([1, 2])
+	longs[1] = 1 << 40
+	print(longs[1])
+
+	var bytes := PackedByteArray([1, 2, 3])
+	bytes[1] = 255
+	print(bytes)
+
+	var points := PackedVector3Array([Vector3(1, 2, 3), Vector3.ZERO])
+	points[1] = points[0] * 2
+	print(points[1])
+
+	var points_2d := PackedVector2Array([Vector2(1, 2)])
+	points_2d[0] += Vector2(1, 1)
+	print(points_2d)
+
+	var colors := PackedColorArray([Color.RED])
+	colors[0] = Color.BLUE
+	print(colors[0])
+
+	var vectors_4d := PackedVector4Array([Vector4(1, 2, 3, 4)])
+	vectors_4d[0] = vectors_4d[0] + Vector4.ONE
+	print(vectors_4d[0])
+
+	# Whole-array math.
+	var values := PackedFloat32Array([1.0, 2.0, 3.0, 4.0, 5.0])
+	print(values.sum())
+	print(values.dot(PackedFloat32Array([1.0, 1.0, 1.0, 1.0, 2.0])))
+	var shared := values
+	values.scale(0.5)
+	print(values)
+	print(shared)
+	print(values.lerp(PackedFloat32Array([1.5, 1.0, 1.5, 2.0, 0.5]), 0.5))
+	print(PackedFloat64Array().sum())
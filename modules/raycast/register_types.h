@@ -32,5 +32,10 @@
 
 #include "modules/register_module_types.h"
 
+class RendererSceneOcclusionCull;
+
 void initialize_raycast_module(ModuleInitializationLevel p_level);
 void uninitialize_raycast_module(ModuleInitializationLevel p_level);
+
+// Null when rendering/occlusion_culling/backend selects the raster backend.
+RendererSceneOcclusionCull *get_raycast_occlusion_cull();
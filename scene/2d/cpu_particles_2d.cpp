@@ -31,7 +31,8 @@
 #include "cpu_particles_2d.h"
 #include "cpu_particles_2d.compat.inc"
 
-#include "core/math/random_number_generator.h"
+#include "core/math/random_pcg.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/math/transform_interpolator.h"
 #include "scene/2d/gpu_particles_2d.h"
 #include "scene/resources/atlas_texture.h"
@@ -697,6 +698,17 @@ static real_t rand_from_seed(uint32_t &seed) {
 	return (seed % uint32_t(65536)) / 65535.0;
 }
 
+// Gives the same sequence as RandomNumberGenerator, but lives on the stack so
+// particles can be restarted from any thread.
+struct ParticleRandom {
+	RandomPCG pcg;
+
+	explicit ParticleRandom(uint64_t p_seed) :
+			pcg(p_seed) {}
+
+	_FORCE_INLINE_ real_t randf() { return pcg.randf(); }
+};
+
 void CPUParticles2D::_update_internal() {
 	if (particles.is_empty() || !is_visible_in_tree()) {
 		_set_do_redraw(false);
@@ -763,97 +775,78 @@ void CPUParticles2D::_update_internal() {
 	_update_particle_data_buffer();
 }
 
-void CPUParticles2D::_particles_process(double p_delta) {
-	p_delta *= speed_scale;
-
-	int pcount = particles.size();
-	Particle *w = particles.ptrw();
+bool CPUParticles2D::_particle_should_restart(int p_index, const ParticlesProcessFrame &p_frame, double &r_local_delta) const {
+	const Particle &p = p_frame.particles[p_index];
+	r_local_delta = p_frame.delta;
 
-	Particle *parray = w;
+	// The phase is a ratio between 0 (birth) and 1 (end of life) for each particle.
+	// While we use time in tests later on, for randomness we use the phase as done in the
+	// original shader code, and we later multiply by lifetime to get the time.
+	double restart_phase = double(p_index) / double(p_frame.pcount);
 
-	double prev_time = time;
-	time += p_delta;
-	if (time > lifetime) {
-		time = Math::fmod(time, lifetime);
-		cycle++;
-		if (one_shot && cycle > 0) {
-			set_emitting(false);
-			notify_property_list_changed();
+	if (randomness_ratio > 0.0) {
+		uint32_t _seed = cycle;
+		if (restart_phase >= p_frame.system_phase) {
+			_seed -= uint32_t(1);
 		}
+		_seed *= uint32_t(p_frame.pcount);
+		_seed += uint32_t(p_index);
+		double random = double(idhash(_seed) % uint32_t(65536)) / 65536.0;
+		restart_phase += randomness_ratio * random * 1.0 / double(p_frame.pcount);
 	}
 
-	Transform2D emission_xform;
-	Transform2D velocity_xform;
-	if (!local_coords) {
-		if (!_interpolation_data.interpolated_follow) {
-			emission_xform = get_global_transform();
-		} else {
-			TransformInterpolator::interpolate_transform_2d(_interpolation_data.global_xform_prev, _interpolation_data.global_xform_curr, emission_xform, Engine::get_singleton()->get_physics_interpolation_fraction());
-		}
-		velocity_xform = emission_xform;
-		velocity_xform[2] = Vector2();
-	}
-
-	double system_phase = time / lifetime;
+	restart_phase *= (1.0 - explosiveness_ratio);
+	double restart_time = restart_phase * lifetime;
+	bool restart = false;
 
-	bool should_be_active = false;
-	for (int i = 0; i < pcount; i++) {
-		Particle &p = parray[i];
+	if (time > p_frame.prev_time) {
+		// restart_time >= prev_time is used so particles emit in the first frame they are processed
 
-		if (!emitting && !p.active) {
-			continue;
+		if (restart_time >= p_frame.prev_time && restart_time < time) {
+			restart = true;
+			if (fractional_delta) {
+				r_local_delta = time - restart_time;
+			}
 		}
 
-		double local_delta = p_delta;
-
-		// The phase is a ratio between 0 (birth) and 1 (end of life) for each particle.
-		// While we use time in tests later on, for randomness we use the phase as done in the
-		// original shader code, and we later multiply by lifetime to get the time.
-		double restart_phase = double(i) / double(pcount);
+	} else if (r_local_delta > 0.0) {
+		if (restart_time >= p_frame.prev_time) {
+			restart = true;
+			if (fractional_delta) {
+				r_local_delta = lifetime - restart_time + time;
+			}
 
-		if (randomness_ratio > 0.0) {
-			uint32_t _seed = cycle;
-			if (restart_phase >= system_phase) {
-				_seed -= uint32_t(1);
+		} else if (restart_time < time) {
+			restart = true;
+			if (fractional_delta) {
+				r_local_delta = time - restart_time;
 			}
-			_seed *= uint32_t(pcount);
-			_seed += uint32_t(i);
-			double random = double(idhash(_seed) % uint32_t(65536)) / 65536.0;
-			restart_phase += randomness_ratio * random * 1.0 / double(pcount);
 		}
+	}
 
-		restart_phase *= (1.0 - explosiveness_ratio);
-		double restart_time = restart_phase * lifetime;
-		bool restart = false;
+	if (p.time * (1.0 - explosiveness_ratio) > p.lifetime) {
+		restart = true;
+	}
 
-		if (time > prev_time) {
-			// restart_time >= prev_time is used so particles emit in the first frame they are processed
+	return restart;
+}
 
-			if (restart_time >= prev_time && restart_time < time) {
-				restart = true;
-				if (fractional_delta) {
-					local_delta = time - restart_time;
-				}
-			}
+void CPUParticles2D::_particles_process_batch(uint32_t p_batch, ParticlesProcessFrame *p_frame) {
+	const int from = p_batch * PARTICLES_PROCESS_BATCH_SIZE;
+	const int to = MIN(from + int(PARTICLES_PROCESS_BATCH_SIZE), p_frame->pcount);
+	const Transform2D &emission_xform = p_frame->emission_xform;
+	const Transform2D &velocity_xform = p_frame->velocity_xform;
 
-		} else if (local_delta > 0.0) {
-			if (restart_time >= prev_time) {
-				restart = true;
-				if (fractional_delta) {
-					local_delta = lifetime - restart_time + time;
-				}
+	bool should_be_active = false;
+	for (int i = from; i < to; i++) {
+		Particle &p = p_frame->particles[i];
 
-			} else if (restart_time < time) {
-				restart = true;
-				if (fractional_delta) {
-					local_delta = time - restart_time;
-				}
-			}
+		if (!emitting && !p.active) {
+			continue;
 		}
 
-		if (p.time * (1.0 - explosiveness_ratio) > p.lifetime) {
-			restart = true;
-		}
+		double local_delta = 0.0;
+		bool restart = _particle_should_restart(i, *p_frame, local_delta);
 
 		float tv = 0.0;
 
@@ -880,22 +873,22 @@ void CPUParticles2D::_particles_process(double p_delta) {
 			}
 
 			p.seed = seed + uint32_t(i) + i + cycle;
-			rng->set_seed(p.seed);
+			ParticleRandom rng(p.seed);
 
-			p.angle_rand = rng->randf();
-			p.scale_rand = rng->randf();
-			p.hue_rot_rand = rng->randf();
-			p.anim_offset_rand = rng->randf();
+			p.angle_rand = rng.randf();
+			p.scale_rand = rng.randf();
+			p.hue_rot_rand = rng.randf();
+			p.anim_offset_rand = rng.randf();
 
 			if (color_initial_ramp.is_valid()) {
-				p.start_color_rand = color_initial_ramp->get_color_at_offset(rng->randf());
+				p.start_color_rand = color_initial_ramp->get_color_at_offset(rng.randf());
 			} else {
 				p.start_color_rand = Color(1, 1, 1, 1);
 			}
 
-			real_t angle1_rad = direction.angle() + Math::deg_to_rad((rng->randf() * 2.0 - 1.0) * spread);
+			real_t angle1_rad = direction.angle() + Math::deg_to_rad((rng.randf() * 2.0 - 1.0) * spread);
 			Vector2 rot = Vector2(Math::cos(angle1_rad), Math::sin(angle1_rad));
-			p.velocity = rot * Math::lerp(parameters_min[PARAM_INITIAL_LINEAR_VELOCITY], parameters_max[PARAM_INITIAL_LINEAR_VELOCITY], rng->randf());
+			p.velocity = rot * Math::lerp(parameters_min[PARAM_INITIAL_LINEAR_VELOCITY], parameters_max[PARAM_INITIAL_LINEAR_VELOCITY], rng.randf());
 
 			real_t base_angle = tex_angle * Math::lerp(parameters_min[PARAM_ANGLE], parameters_max[PARAM_ANGLE], p.angle_rand);
 			p.rotation = Math::deg_to_rad(base_angle);
@@ -903,7 +896,7 @@ void CPUParticles2D::_particles_process(double p_delta) {
 			p.custom[0] = 0.0; // unused
 			p.custom[1] = 0.0; // phase [0..1]
 			p.custom[2] = tex_anim_offset * Math::lerp(parameters_min[PARAM_ANIM_OFFSET], parameters_max[PARAM_ANIM_OFFSET], p.anim_offset_rand);
-			p.custom[3] = (1.0 - rng->randf() * lifetime_randomness);
+			p.custom[3] = (1.0 - rng.randf() * lifetime_randomness);
 			p.transform = Transform2D();
 			p.time = 0;
 			p.lifetime = lifetime * p.custom[3];
@@ -914,17 +907,17 @@ void CPUParticles2D::_particles_process(double p_delta) {
 					//do none
 				} break;
 				case EMISSION_SHAPE_SPHERE: {
-					real_t t = Math::TAU * rng->randf();
-					real_t radius = emission_sphere_radius * rng->randf();
+					real_t t = Math::TAU * rng.randf();
+					real_t radius = emission_sphere_radius * rng.randf();
 					p.transform[2] = Vector2(Math::cos(t), Math::sin(t)) * radius;
 				} break;
 				case EMISSION_SHAPE_SPHERE_SURFACE: {
-					real_t s = rng->randf(), t = Math::TAU * rng->randf();
+					real_t s = rng.randf(), t = Math::TAU * rng.randf();
 					real_t radius = emission_sphere_radius * Math::sqrt(1.0 - s * s);
 					p.transform[2] = Vector2(Math::cos(t), Math::sin(t)) * radius;
 				} break;
 				case EMISSION_SHAPE_RECTANGLE: {
-					p.transform[2] = Vector2(rng->randf() * 2.0 - 1.0, rng->randf() * 2.0 - 1.0) * emission_rect_extents;
+					p.transform[2] = Vector2(rng.randf() * 2.0 - 1.0, rng.randf() * 2.0 - 1.0) * emission_rect_extents;
 				} break;
 				case EMISSION_SHAPE_POINTS:
 				case EMISSION_SHAPE_DIRECTED_POINTS: {
@@ -933,7 +926,7 @@ void CPUParticles2D::_particles_process(double p_delta) {
 						break;
 					}
 
-					int random_idx = Math::rand() % pc;
+					int random_idx = p_frame->emission_rands[i].rand % pc;
 
 					p.transform[2] = emission_points.get(random_idx);
 
@@ -950,10 +943,10 @@ void CPUParticles2D::_particles_process(double p_delta) {
 					}
 				} break;
 				case EMISSION_SHAPE_RING: {
-					real_t t = Math::TAU * Math::randf();
+					real_t t = Math::TAU * p_frame->emission_rands[i].randf[0];
 					real_t outer_sq = emission_ring_radius * emission_ring_radius;
 					real_t inner_sq = emission_ring_inner_radius * emission_ring_inner_radius;
-					real_t radius = Math::sqrt(Math::randf() * (outer_sq - inner_sq) + inner_sq);
+					real_t radius = Math::sqrt(p_frame->emission_rands[i].randf[1] * (outer_sq - inner_sq) + inner_sq);
 					p.transform[2] = Vector2(Math::cos(t), Math::sin(t)) * radius;
 				} break;
 				case EMISSION_SHAPE_MAX: { // Max value for validity check.
@@ -1152,7 +1145,88 @@ void CPUParticles2D::_particles_process(double p_delta) {
 
 		should_be_active = true;
 	}
-	if (!Math::is_equal_approx(time, 0.0) && active && !should_be_active) {
+
+	if (should_be_active) {
+		p_frame->should_be_active.set();
+	}
+}
+
+void CPUParticles2D::_particles_process(double p_delta) {
+	p_delta *= speed_scale;
+
+	int pcount = particles.size();
+
+	double prev_time = time;
+	time += p_delta;
+	if (time > lifetime) {
+		time = Math::fmod(time, lifetime);
+		cycle++;
+		if (one_shot && cycle > 0) {
+			set_emitting(false);
+			notify_property_list_changed();
+		}
+	}
+
+	Transform2D emission_xform;
+	Transform2D velocity_xform;
+	if (!local_coords) {
+		if (!_interpolation_data.interpolated_follow) {
+			emission_xform = get_global_transform();
+		} else {
+			TransformInterpolator::interpolate_transform_2d(_interpolation_data.global_xform_prev, _interpolation_data.global_xform_curr, emission_xform, Engine::get_singleton()->get_physics_interpolation_fraction());
+		}
+		velocity_xform = emission_xform;
+		velocity_xform[2] = Vector2();
+	}
+
+	double system_phase = time / lifetime;
+
+	ParticlesProcessFrame frame;
+	frame.particles = particles.ptrw();
+	frame.pcount = pcount;
+	frame.delta = p_delta;
+	frame.prev_time = prev_time;
+	frame.system_phase = system_phase;
+	frame.emission_xform = emission_xform;
+	frame.velocity_xform = velocity_xform;
+
+	if (emitting && (emission_shape == EMISSION_SHAPE_POINTS || emission_shape == EMISSION_SHAPE_DIRECTED_POINTS || emission_shape == EMISSION_SHAPE_RING)) {
+		// The global generator can't be shared by worker threads, so draw its values for
+		// restarting particles up front, in the same order as a serial loop would.
+		particle_emission_rands.resize(pcount);
+		for (int i = 0; i < pcount; i++) {
+			double local_delta = 0.0;
+			if (_particle_should_restart(i, frame, local_delta)) {
+				if (emission_shape == EMISSION_SHAPE_RING) {
+					particle_emission_rands[i].randf[0] = Math::randf();
+					particle_emission_rands[i].randf[1] = Math::randf();
+				} else if (emission_points.size() > 0) {
+					particle_emission_rands[i].rand = Math::rand();
+				}
+			}
+		}
+		frame.emission_rands = particle_emission_rands.ptr();
+	}
+
+	// Gradients sort their points lazily, sort them now so batches only read them.
+	if (color_ramp.is_valid()) {
+		color_ramp->get_color_at_offset(0.0);
+	}
+	if (color_initial_ramp.is_valid()) {
+		color_initial_ramp->get_color_at_offset(0.0);
+	}
+
+	const uint32_t batch_count = (pcount + PARTICLES_PROCESS_BATCH_SIZE - 1) / PARTICLES_PROCESS_BATCH_SIZE;
+	if (use_threads && pcount >= PARTICLES_PROCESS_THREADED_MIN) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &CPUParticles2D::_particles_process_batch, &frame, batch_count, -1, true, SNAME("CPUParticles2DProcess"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < batch_count; i++) {
+			_particles_process_batch(i, &frame);
+		}
+	}
+
+	if (!Math::is_equal_approx(time, 0.0) && active && !frame.should_be_active.is_set()) {
 		active = false;
 		emit_signal(SceneStringName(finished));
 	}
@@ -1693,8 +1767,6 @@ CPUParticles2D::CPUParticles2D() {
 	set_use_local_coordinates(false);
 	set_seed(Math::rand());
 
-	rng.instantiate();
-
 	set_param_min(PARAM_INITIAL_LINEAR_VELOCITY, 0);
 	set_param_min(PARAM_ANGULAR_VELOCITY, 0);
 	set_param_min(PARAM_ORBIT_VELOCITY, 0);
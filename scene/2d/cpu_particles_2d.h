@@ -33,8 +33,6 @@
 #include "scene/2d/node_2d.h"
 #include "scene/resources/gradient.h"
 
-class RandomNumberGenerator;
-
 class CPUParticles2D : public Node2D {
 private:
 	GDCLASS(CPUParticles2D, Node2D);
@@ -188,9 +186,37 @@ private:
 
 	Vector2 gravity = Vector2(0, 980);
 
-	Ref<RandomNumberGenerator> rng;
+	// Large emitters are processed in batches on the WorkerThreadPool. Each particle
+	// only depends on its own state and seed, so the result matches a serial loop.
+	enum {
+		PARTICLES_PROCESS_BATCH_SIZE = 256,
+		PARTICLES_PROCESS_THREADED_MIN = 2048,
+	};
+
+	// Draws from the global generator for restarting particles, made before the batches run.
+	struct EmissionRand {
+		uint32_t rand = 0;
+		float randf[2] = {};
+	};
+
+	struct ParticlesProcessFrame {
+		Particle *particles = nullptr;
+		int pcount = 0;
+		double delta = 0.0;
+		double prev_time = 0.0;
+		double system_phase = 0.0;
+		Transform2D emission_xform;
+		Transform2D velocity_xform;
+		const EmissionRand *emission_rands = nullptr;
+		SafeFlag should_be_active;
+	};
+
+	LocalVector<EmissionRand> particle_emission_rands;
+	bool use_threads = true;
 
 	void _update_internal();
+	bool _particle_should_restart(int p_index, const ParticlesProcessFrame &p_frame, double &r_local_delta) const;
+	void _particles_process_batch(uint32_t p_batch, ParticlesProcessFrame *p_frame);
 	void _particles_process(double p_delta);
 	void _update_particle_data_buffer();
 	void _set_emitting();
@@ -335,6 +361,10 @@ public:
 
 	void restart(bool p_keep_seed = false);
 
+	// Processes every batch on the calling thread, the result is the same either way.
+	void set_use_threads(bool p_use_threads) { use_threads = p_use_threads; }
+	RID get_multimesh() const { return multimesh; }
+
 	void convert_from_particles(Node *p_particles);
 
 	CPUParticles2D();
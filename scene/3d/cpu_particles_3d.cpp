@@ -31,7 +31,8 @@
 #include "cpu_particles_3d.h"
 #include "cpu_particles_3d.compat.inc"
 
-#include "core/math/random_number_generator.h"
+#include "core/math/random_pcg.h"
+#include "core/object/worker_thread_pool.h"
 #include "scene/3d/camera_3d.h"
 #include "scene/3d/gpu_particles_3d.h"
 #include "scene/main/viewport.h"
@@ -647,6 +648,17 @@ static real_t rand_from_seed(uint32_t &seed) {
 	return (seed % uint32_t(65536)) / 65535.0;
 }
 
+// Gives the same sequence as RandomNumberGenerator, but lives on the stack so
+// particles can be restarted from any thread.
+struct ParticleRandom {
+	RandomPCG pcg;
+
+	explicit ParticleRandom(uint64_t p_seed) :
+			pcg(p_seed) {}
+
+	_FORCE_INLINE_ real_t randf() { return pcg.randf(); }
+};
+
 void CPUParticles3D::_update_internal() {
 	if (particles.is_empty() || !is_visible_in_tree()) {
 		_set_redraw(false);
@@ -717,92 +729,78 @@ void CPUParticles3D::_update_internal() {
 	}
 }
 
-void CPUParticles3D::_particles_process(double p_delta) {
-	p_delta *= speed_scale;
+bool CPUParticles3D::_particle_should_restart(int p_index, const ParticlesProcessFrame &p_frame, double &r_local_delta) const {
+	const Particle &p = p_frame.particles[p_index];
+	r_local_delta = p_frame.delta;
 
-	int pcount = particles.size();
-	Particle *w = particles.ptrw();
+	// The phase is a ratio between 0 (birth) and 1 (end of life) for each particle.
+	// While we use time in tests later on, for randomness we use the phase as done in the
+	// original shader code, and we later multiply by lifetime to get the time.
+	double restart_phase = double(p_index) / double(p_frame.pcount);
 
-	Particle *parray = w;
-
-	double prev_time = time;
-	time += p_delta;
-	if (time > lifetime) {
-		time = Math::fmod(time, lifetime);
-		cycle++;
-		if (one_shot && cycle > 0) {
-			set_emitting(false);
-			notify_property_list_changed();
+	if (randomness_ratio > 0.0) {
+		uint32_t _seed = cycle;
+		if (restart_phase >= p_frame.system_phase) {
+			_seed -= uint32_t(1);
 		}
+		_seed *= uint32_t(p_frame.pcount);
+		_seed += uint32_t(p_index);
+		double random = double(idhash(_seed) % uint32_t(65536)) / 65536.0;
+		restart_phase += randomness_ratio * random * 1.0 / double(p_frame.pcount);
 	}
 
-	Transform3D emission_xform;
-	Basis velocity_xform;
-	if (!local_coords) {
-		emission_xform = get_global_transform_interpolated();
-		velocity_xform = emission_xform.basis;
-	}
+	restart_phase *= (1.0 - explosiveness_ratio);
+	double restart_time = restart_phase * lifetime;
+	bool restart = false;
 
-	double system_phase = time / lifetime;
+	if (time > p_frame.prev_time) {
+		// restart_time >= prev_time is used so particles emit in the first frame they are processed
 
-	bool should_be_active = false;
-	for (int i = 0; i < pcount; i++) {
-		Particle &p = parray[i];
-
-		if (!emitting && !p.active) {
-			continue;
+		if (restart_time >= p_frame.prev_time && restart_time < time) {
+			restart = true;
+			if (fractional_delta) {
+				r_local_delta = time - restart_time;
+			}
 		}
 
-		double local_delta = p_delta;
-
-		// The phase is a ratio between 0 (birth) and 1 (end of life) for each particle.
-		// While we use time in tests later on, for randomness we use the phase as done in the
-		// original shader code, and we later multiply by lifetime to get the time.
-		double restart_phase = double(i) / double(pcount);
+	} else if (r_local_delta > 0.0) {
+		if (restart_time >= p_frame.prev_time) {
+			restart = true;
+			if (fractional_delta) {
+				r_local_delta = lifetime - restart_time + time;
+			}
 
-		if (randomness_ratio > 0.0) {
-			uint32_t _seed = cycle;
-			if (restart_phase >= system_phase) {
-				_seed -= uint32_t(1);
+		} else if (restart_time < time) {
+			restart = true;
+			if (fractional_delta) {
+				r_local_delta = time - restart_time;
 			}
-			_seed *= uint32_t(pcount);
-			_seed += uint32_t(i);
-			double random = double(idhash(_seed) % uint32_t(65536)) / 65536.0;
-			restart_phase += randomness_ratio * random * 1.0 / double(pcount);
 		}
+	}
 
-		restart_phase *= (1.0 - explosiveness_ratio);
-		double restart_time = restart_phase * lifetime;
-		bool restart = false;
+	if (p.time * (1.0 - explosiveness_ratio) > p.lifetime) {
+		restart = true;
+	}
 
-		if (time > prev_time) {
-			// restart_time >= prev_time is used so particles emit in the first frame they are processed
+	return restart;
+}
 
-			if (restart_time >= prev_time && restart_time < time) {
-				restart = true;
-				if (fractional_delta) {
-					local_delta = time - restart_time;
-				}
-			}
+void CPUParticles3D::_particles_process_batch(uint32_t p_batch, ParticlesProcessFrame *p_frame) {
+	const int from = p_batch * PARTICLES_PROCESS_BATCH_SIZE;
+	const int to = MIN(from + int(PARTICLES_PROCESS_BATCH_SIZE), p_frame->pcount);
+	const Transform3D &emission_xform = p_frame->emission_xform;
+	const Basis &velocity_xform = p_frame->velocity_xform;
 
-		} else if (local_delta > 0.0) {
-			if (restart_time >= prev_time) {
-				restart = true;
-				if (fractional_delta) {
-					local_delta = lifetime - restart_time + time;
-				}
+	bool should_be_active = false;
+	for (int i = from; i < to; i++) {
+		Particle &p = p_frame->particles[i];
 
-			} else if (restart_time < time) {
-				restart = true;
-				if (fractional_delta) {
-					local_delta = time - restart_time;
-				}
-			}
+		if (!emitting && !p.active) {
+			continue;
 		}
 
-		if (p.time * (1.0 - explosiveness_ratio) > p.lifetime) {
-			restart = true;
-		}
+		double local_delta = 0.0;
+		bool restart = _particle_should_restart(i, *p_frame, local_delta);
 
 		float tv = 0.0;
 
@@ -828,27 +826,27 @@ void CPUParticles3D::_particles_process(double p_delta) {
 				tex_anim_offset = curve_parameters[PARAM_ANGLE]->sample(tv);
 			}
 
-			p.seed = seed + uint32_t(1) + i + cycle * pcount;
-			rng->set_seed(p.seed);
-			p.angle_rand = rng->randf();
-			p.scale_rand = rng->randf();
-			p.hue_rot_rand = rng->randf();
-			p.anim_offset_rand = rng->randf();
+			p.seed = seed + uint32_t(1) + i + cycle * p_frame->pcount;
+			ParticleRandom rng(p.seed);
+			p.angle_rand = rng.randf();
+			p.scale_rand = rng.randf();
+			p.hue_rot_rand = rng.randf();
+			p.anim_offset_rand = rng.randf();
 
 			if (color_initial_ramp.is_valid()) {
-				p.start_color_rand = color_initial_ramp->get_color_at_offset(rng->randf());
+				p.start_color_rand = color_initial_ramp->get_color_at_offset(rng.randf());
 			} else {
 				p.start_color_rand = Color(1, 1, 1, 1);
 			}
 
 			if (particle_flags[PARTICLE_FLAG_DISABLE_Z]) {
-				real_t angle1_rad = Math::atan2(direction.y, direction.x) + Math::deg_to_rad((rng->randf() * 2.0 - 1.0) * spread);
+				real_t angle1_rad = Math::atan2(direction.y, direction.x) + Math::deg_to_rad((rng.randf() * 2.0 - 1.0) * spread);
 				Vector3 rot = Vector3(Math::cos(angle1_rad), Math::sin(angle1_rad), 0.0);
-				p.velocity = rot * Math::lerp(parameters_min[PARAM_INITIAL_LINEAR_VELOCITY], parameters_max[PARAM_INITIAL_LINEAR_VELOCITY], rng->randf());
+				p.velocity = rot * Math::lerp(parameters_min[PARAM_INITIAL_LINEAR_VELOCITY], parameters_max[PARAM_INITIAL_LINEAR_VELOCITY], rng.randf());
 			} else {
 				//initiate velocity spread in 3D
-				real_t angle1_rad = Math::deg_to_rad((rng->randf() * (real_t)2.0 - (real_t)1.0) * spread);
-				real_t angle2_rad = Math::deg_to_rad((rng->randf() * (real_t)2.0 - (real_t)1.0) * ((real_t)1.0 - flatness) * spread);
+				real_t angle1_rad = Math::deg_to_rad((rng.randf() * (real_t)2.0 - (real_t)1.0) * spread);
+				real_t angle2_rad = Math::deg_to_rad((rng.randf() * (real_t)2.0 - (real_t)1.0) * ((real_t)1.0 - flatness) * spread);
 
 				Vector3 direction_xz = Vector3(Math::sin(angle1_rad), 0, Math::cos(angle1_rad));
 				Vector3 direction_yz = Vector3(0, Math::sin(angle2_rad), Math::cos(angle2_rad));
@@ -868,14 +866,14 @@ void CPUParticles3D::_particles_process(double p_delta) {
 				binormal.normalize();
 				Vector3 normal = binormal.cross(direction_nrm);
 				spread_direction = binormal * spread_direction.x + normal * spread_direction.y + direction_nrm * spread_direction.z;
-				p.velocity = spread_direction * Math::lerp(parameters_min[PARAM_INITIAL_LINEAR_VELOCITY], parameters_max[PARAM_INITIAL_LINEAR_VELOCITY], rng->randf());
+				p.velocity = spread_direction * Math::lerp(parameters_min[PARAM_INITIAL_LINEAR_VELOCITY], parameters_max[PARAM_INITIAL_LINEAR_VELOCITY], rng.randf());
 			}
 
 			real_t base_angle = tex_angle * Math::lerp(parameters_min[PARAM_ANGLE], parameters_max[PARAM_ANGLE], p.angle_rand);
 			p.custom[0] = Math::deg_to_rad(base_angle); //angle
 			p.custom[1] = 0.0; //phase
 			p.custom[2] = tex_anim_offset * Math::lerp(parameters_min[PARAM_ANIM_OFFSET], parameters_max[PARAM_ANIM_OFFSET], p.anim_offset_rand); //animation offset (0-1)
-			p.custom[3] = (1.0 - rng->randf() * lifetime_randomness);
+			p.custom[3] = (1.0 - rng.randf() * lifetime_randomness);
 			p.transform = Transform3D();
 			p.time = 0;
 			p.lifetime = lifetime * p.custom[3];
@@ -886,20 +884,20 @@ void CPUParticles3D::_particles_process(double p_delta) {
 					//do none
 				} break;
 				case EMISSION_SHAPE_SPHERE: {
-					real_t s = 2.0 * rng->randf() - 1.0;
-					real_t t = Math::TAU * rng->randf();
-					real_t x = rng->randf();
+					real_t s = 2.0 * rng.randf() - 1.0;
+					real_t t = Math::TAU * rng.randf();
+					real_t x = rng.randf();
 					real_t radius = emission_sphere_radius * Math::sqrt(1.0 - s * s);
 					p.transform.origin = Vector3(0, 0, 0).lerp(Vector3(radius * Math::cos(t), radius * Math::sin(t), emission_sphere_radius * s), x);
 				} break;
 				case EMISSION_SHAPE_SPHERE_SURFACE: {
-					real_t s = 2.0 * rng->randf() - 1.0;
-					real_t t = Math::TAU * rng->randf();
+					real_t s = 2.0 * rng.randf() - 1.0;
+					real_t t = Math::TAU * rng.randf();
 					real_t radius = emission_sphere_radius * Math::sqrt(1.0 - s * s);
 					p.transform.origin = Vector3(radius * Math::cos(t), radius * Math::sin(t), emission_sphere_radius * s);
 				} break;
 				case EMISSION_SHAPE_BOX: {
-					p.transform.origin = Vector3(rng->randf() * 2.0 - 1.0, rng->randf() * 2.0 - 1.0, rng->randf() * 2.0 - 1.0) * emission_box_extents;
+					p.transform.origin = Vector3(rng.randf() * 2.0 - 1.0, rng.randf() * 2.0 - 1.0, rng.randf() * 2.0 - 1.0) * emission_box_extents;
 				} break;
 				case EMISSION_SHAPE_POINTS:
 				case EMISSION_SHAPE_DIRECTED_POINTS: {
@@ -908,7 +906,7 @@ void CPUParticles3D::_particles_process(double p_delta) {
 						break;
 					}
 
-					int random_idx = Math::rand() % pc;
+					int random_idx = p_frame->emission_rands[i].rand % pc;
 
 					p.transform.origin = emission_points.get(random_idx);
 
@@ -943,11 +941,11 @@ void CPUParticles3D::_particles_process(double p_delta) {
 				case EMISSION_SHAPE_RING: {
 					real_t radius_clamped = MAX(0.001, emission_ring_radius);
 					real_t top_radius = MAX(radius_clamped - Math::tan(Math::deg_to_rad(90.0 - emission_ring_cone_angle)) * emission_ring_height, 0.0);
-					real_t y_pos = rng->randf();
+					real_t y_pos = rng.randf();
 					real_t skew = MAX(MIN(radius_clamped, top_radius) / MAX(radius_clamped, top_radius), 0.5);
 					y_pos = radius_clamped < top_radius ? Math::pow(y_pos, skew) : 1.0 - Math::pow(y_pos, skew);
-					real_t ring_random_angle = rng->randf() * Math::TAU;
-					real_t ring_random_radius = Math::sqrt(rng->randf() * (radius_clamped * radius_clamped - emission_ring_inner_radius * emission_ring_inner_radius) + emission_ring_inner_radius * emission_ring_inner_radius);
+					real_t ring_random_angle = rng.randf() * Math::TAU;
+					real_t ring_random_radius = Math::sqrt(rng.randf() * (radius_clamped * radius_clamped - emission_ring_inner_radius * emission_ring_inner_radius) + emission_ring_inner_radius * emission_ring_inner_radius);
 					ring_random_radius = Math::lerp(ring_random_radius, ring_random_radius * (top_radius / radius_clamped), y_pos);
 					Vector3 axis = emission_ring_axis == Vector3(0.0, 0.0, 0.0) ? Vector3(0.0, 0.0, 1.0) : emission_ring_axis.normalized();
 					Vector3 ortho_axis;
@@ -1222,7 +1220,78 @@ void CPUParticles3D::_particles_process(double p_delta) {
 
 		should_be_active = true;
 	}
-	if (!Math::is_equal_approx(time, 0.0) && active && !should_be_active) {
+
+	if (should_be_active) {
+		p_frame->should_be_active.set();
+	}
+}
+
+void CPUParticles3D::_particles_process(double p_delta) {
+	p_delta *= speed_scale;
+
+	int pcount = particles.size();
+
+	double prev_time = time;
+	time += p_delta;
+	if (time > lifetime) {
+		time = Math::fmod(time, lifetime);
+		cycle++;
+		if (one_shot && cycle > 0) {
+			set_emitting(false);
+			notify_property_list_changed();
+		}
+	}
+
+	Transform3D emission_xform;
+	Basis velocity_xform;
+	if (!local_coords) {
+		emission_xform = get_global_transform_interpolated();
+		velocity_xform = emission_xform.basis;
+	}
+
+	double system_phase = time / lifetime;
+
+	ParticlesProcessFrame frame;
+	frame.particles = particles.ptrw();
+	frame.pcount = pcount;
+	frame.delta = p_delta;
+	frame.prev_time = prev_time;
+	frame.system_phase = system_phase;
+	frame.emission_xform = emission_xform;
+	frame.velocity_xform = velocity_xform;
+
+	if (emitting && (emission_shape == EMISSION_SHAPE_POINTS || emission_shape == EMISSION_SHAPE_DIRECTED_POINTS) && emission_points.size() > 0) {
+		// Math::rand() can't be shared by worker threads, so draw the emission points of
+		// restarting particles up front, in the same order as a serial loop would.
+		particle_emission_rands.resize(pcount);
+		for (int i = 0; i < pcount; i++) {
+			double local_delta = 0.0;
+			if (_particle_should_restart(i, frame, local_delta)) {
+				particle_emission_rands[i].rand = Math::rand();
+			}
+		}
+		frame.emission_rands = particle_emission_rands.ptr();
+	}
+
+	// Gradients sort their points lazily, sort them now so batches only read them.
+	if (color_ramp.is_valid()) {
+		color_ramp->get_color_at_offset(0.0);
+	}
+	if (color_initial_ramp.is_valid()) {
+		color_initial_ramp->get_color_at_offset(0.0);
+	}
+
+	const uint32_t batch_count = (pcount + PARTICLES_PROCESS_BATCH_SIZE - 1) / PARTICLES_PROCESS_BATCH_SIZE;
+	if (use_threads && pcount >= PARTICLES_PROCESS_THREADED_MIN) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &CPUParticles3D::_particles_process_batch, &frame, batch_count, -1, true, SNAME("CPUParticles3DProcess"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < batch_count; i++) {
+			_particles_process_batch(i, &frame);
+		}
+	}
+
+	if (!Math::is_equal_approx(time, 0.0) && active && !frame.should_be_active.is_set()) {
 		active = false;
 		emit_signal(SceneStringName(finished));
 	}
@@ -1777,8 +1846,6 @@ CPUParticles3D::CPUParticles3D() {
 	set_amount(8);
 	set_seed(Math::rand());
 
-	rng.instantiate();
-
 	set_param_min(PARAM_INITIAL_LINEAR_VELOCITY, 0);
 	set_param_min(PARAM_ANGULAR_VELOCITY, 0);
 	set_param_min(PARAM_ORBIT_VELOCITY, 0);
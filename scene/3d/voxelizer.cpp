@@ -31,6 +31,8 @@
 #include "voxelizer.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
 
 static _FORCE_INLINE_ void get_uv_and_normal(const Vector3 &p_pos, const Vector3 *p_vtx, const Vector2 *p_uv, const Vector3 *p_normal, Vector2 &r_uv, Vector3 &r_normal) {
 	if (p_pos.is_equal_approx(p_vtx[0])) {
@@ -72,7 +74,7 @@ static _FORCE_INLINE_ void get_uv_and_normal(const Vector3 &p_pos, const Vector3
 	r_normal = (p_normal[0] * u + p_normal[1] * v + p_normal[2] * w).normalized();
 }
 
-void Voxelizer::_plot_face(int p_idx, int p_level, int p_x, int p_y, int p_z, const Vector3 *p_vtx, const Vector3 *p_normal, const Vector2 *p_uv, const MaterialCache &p_material, const AABB &p_aabb) {
+void Voxelizer::_plot_face(Vector<Cell> &r_cells, int p_idx, int p_level, int p_x, int p_y, int p_z, const Vector3 *p_vtx, const Vector3 *p_normal, const Vector2 *p_uv, const MaterialCache &p_material, const AABB &p_aabb) {
 	if (p_level == cell_subdiv) {
 		//plot the face by guessing its albedo and emission value
 
@@ -219,16 +221,16 @@ void Voxelizer::_plot_face(int p_idx, int p_level, int p_x, int p_y, int p_z, co
 		}
 
 		//put this temporarily here, corrected in a later step
-		bake_cells.write[p_idx].albedo[0] += albedo_accum.r;
-		bake_cells.write[p_idx].albedo[1] += albedo_accum.g;
-		bake_cells.write[p_idx].albedo[2] += albedo_accum.b;
-		bake_cells.write[p_idx].emission[0] += emission_accum.r;
-		bake_cells.write[p_idx].emission[1] += emission_accum.g;
-		bake_cells.write[p_idx].emission[2] += emission_accum.b;
-		bake_cells.write[p_idx].normal[0] += normal_accum.x;
-		bake_cells.write[p_idx].normal[1] += normal_accum.y;
-		bake_cells.write[p_idx].normal[2] += normal_accum.z;
-		bake_cells.write[p_idx].alpha += alpha;
+		r_cells.write[p_idx].albedo[0] += albedo_accum.r;
+		r_cells.write[p_idx].albedo[1] += albedo_accum.g;
+		r_cells.write[p_idx].albedo[2] += albedo_accum.b;
+		r_cells.write[p_idx].emission[0] += emission_accum.r;
+		r_cells.write[p_idx].emission[1] += emission_accum.g;
+		r_cells.write[p_idx].emission[2] += emission_accum.b;
+		r_cells.write[p_idx].normal[0] += normal_accum.x;
+		r_cells.write[p_idx].normal[1] += normal_accum.y;
+		r_cells.write[p_idx].normal[2] += normal_accum.z;
+		r_cells.write[p_idx].alpha += alpha;
 
 	} else {
 		//go down
@@ -271,23 +273,192 @@ void Voxelizer::_plot_face(int p_idx, int p_level, int p_x, int p_y, int p_z, co
 				}
 			}
 
-			if (bake_cells[p_idx].children[i] == CHILD_EMPTY) {
+			if (r_cells[p_idx].children[i] == CHILD_EMPTY) {
 				//sub cell must be created
 
-				uint32_t child_idx = bake_cells.size();
-				bake_cells.write[p_idx].children[i] = child_idx;
-				bake_cells.resize(bake_cells.size() + 1);
-				bake_cells.write[child_idx].level = p_level + 1;
-				bake_cells.write[child_idx].x = nx / half;
-				bake_cells.write[child_idx].y = ny / half;
-				bake_cells.write[child_idx].z = nz / half;
+				uint32_t child_idx = r_cells.size();
+				r_cells.write[p_idx].children[i] = child_idx;
+				r_cells.resize(r_cells.size() + 1);
+				r_cells.write[child_idx].level = p_level + 1;
+				r_cells.write[child_idx].x = nx / half;
+				r_cells.write[child_idx].y = ny / half;
+				r_cells.write[child_idx].z = nz / half;
 			}
 
-			_plot_face(bake_cells[p_idx].children[i], p_level + 1, nx, ny, nz, p_vtx, p_normal, p_uv, p_material, aabb);
+			_plot_face(r_cells, r_cells[p_idx].children[i], p_level + 1, nx, ny, nz, p_vtx, p_normal, p_uv, p_material, aabb);
 		}
 	}
 }
 
+void Voxelizer::_bin_face(uint32_t p_face) {
+	const PlotFace &face = plot_faces[p_face];
+
+	AABB face_aabb(face.vtx[0], Vector3());
+	face_aabb.expand_to(face.vtx[1]);
+	face_aabb.expand_to(face.vtx[2]);
+
+	const int bin_axis_count = 1 << plot_bin_level;
+	const Vector3 bin_size = po2_bounds.size / real_t(bin_axis_count);
+	const Vector3 face_end = face_aabb.get_end();
+
+	int from[3];
+	int to[3];
+	for (int i = 0; i < 3; i++) {
+		// Grow the range by one bin to be safe from rounding, the overlap test below is the exact one.
+		from[i] = CLAMP(int(Math::floor((face_aabb.position[i] - po2_bounds.position[i]) / bin_size[i])) - 1, 0, bin_axis_count - 1);
+		to[i] = CLAMP(int(Math::floor((face_end[i] - po2_bounds.position[i]) / bin_size[i])) + 1, 0, bin_axis_count - 1);
+	}
+
+	for (int z = from[2]; z <= to[2]; z++) {
+		for (int y = from[1]; y <= to[1]; y++) {
+			for (int x = from[0]; x <= to[0]; x++) {
+				const uint32_t bin_index = (uint32_t(z) << (plot_bin_level * 2)) | (uint32_t(y) << plot_bin_level) | uint32_t(x);
+				PlotBin &bin = plot_bins[bin_index];
+
+				//make sure to not plot beyond limits
+				if (bin.x >= axis_cell_size[0] || bin.y >= axis_cell_size[1] || bin.z >= axis_cell_size[2]) {
+					continue;
+				}
+
+				Vector3 qsize = bin.aabb.size * 0.5;
+				if (!Geometry3D::triangle_box_overlap(bin.aabb.position + qsize, qsize, face.vtx)) {
+					continue;
+				}
+
+				if (bin.faces.is_empty()) {
+					plot_bins_used.push_back(bin_index);
+				}
+				bin.faces.push_back(p_face);
+			}
+		}
+	}
+}
+
+void Voxelizer::_plot_bin(uint32_t p_index, const PlotFace *p_faces) {
+	PlotBin &bin = plot_bins[plot_bins_used[p_index]];
+
+	for (uint32_t i = 0; i < bin.faces.size(); i++) {
+		if (i % PLOT_CANCEL_CHECK_FACES == 0 && plot_cancelled.is_set()) {
+			break;
+		}
+
+		const PlotFace &face = p_faces[bin.faces[i]];
+		_plot_face(bin.cells, 0, plot_bin_level, bin.x, bin.y, bin.z, face.vtx, face.normal, face.uv, plot_materials[face.material], bin.aabb);
+	}
+}
+
+Voxelizer::BakeResult Voxelizer::_plot_binned_faces(int p_bake_current, int p_bake_total, BakeStepFunc p_bake_step_function) {
+	BakeResult result = BAKE_RESULT_OK;
+
+	if (plot_bin_level == 0) {
+		// The root cell is the only cell, there is nothing to split.
+		for (const PlotFace &face : plot_faces) {
+			_plot_face(bake_cells, 0, 0, 0, 0, 0, face.vtx, face.normal, face.uv, plot_materials[face.material], po2_bounds);
+		}
+	} else {
+		for (uint32_t i = 0; i < plot_faces.size(); i++) {
+			_bin_face(i);
+		}
+
+		for (uint32_t bin_index : plot_bins_used) {
+			PlotBin &bin = plot_bins[bin_index];
+			if (bin.parent != CHILD_EMPTY) {
+				continue;
+			}
+
+			// Create the path down to the bin in the shared tree. The bin cell itself
+			// stays in the bin until _merge_plot_bins().
+			uint32_t idx = 0;
+			for (int level = 0; level < plot_bin_level; level++) {
+				int half = (1 << cell_subdiv) >> (level + 1);
+				uint32_t child = ((bin.x / half) & 1) | (((bin.y / half) & 1) << 1) | (((bin.z / half) & 1) << 2);
+
+				if (level + 1 == plot_bin_level) {
+					bin.parent = idx;
+					bin.parent_child = child;
+					bin.cells.resize(1);
+					bin.cells.write[0].level = level + 1;
+					bin.cells.write[0].x = bin.x / half;
+					bin.cells.write[0].y = bin.y / half;
+					bin.cells.write[0].z = bin.z / half;
+				} else {
+					if (bake_cells[idx].children[child] == CHILD_EMPTY) {
+						uint32_t child_idx = bake_cells.size();
+						bake_cells.write[idx].children[child] = child_idx;
+						bake_cells.resize(bake_cells.size() + 1);
+						bake_cells.write[child_idx].level = level + 1;
+						bake_cells.write[child_idx].x = bin.x / half;
+						bake_cells.write[child_idx].y = bin.y / half;
+						bake_cells.write[child_idx].z = bin.z / half;
+					}
+					idx = bake_cells[idx].children[child];
+				}
+			}
+		}
+
+		plot_cancelled.clear();
+
+		if (!use_threads || plot_faces.size() < PLOT_THREAD_MIN_FACES) {
+			for (uint32_t i = 0; i < plot_bins_used.size(); i++) {
+				_plot_bin(i, plot_faces.ptr());
+			}
+		} else {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &Voxelizer::_plot_bin, plot_faces.ptr(), plot_bins_used.size(), -1, true, SNAME("VoxelizerPlotFaces"));
+			if (p_bake_step_function != nullptr) {
+				while (!WorkerThreadPool::get_singleton()->is_group_task_completed(group_task)) {
+					OS::get_singleton()->delay_usec(10000);
+					if (p_bake_step_function(p_bake_current, p_bake_total)) {
+						plot_cancelled.set();
+						result = BAKE_RESULT_CANCELLED;
+						break;
+					}
+				}
+			}
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		}
+
+		for (uint32_t bin_index : plot_bins_used) {
+			plot_bins[bin_index].faces.clear();
+		}
+		plot_bins_used.clear();
+	}
+
+	plot_faces.clear();
+
+	return result;
+}
+
+void Voxelizer::_merge_plot_bins() {
+	// Bins are appended in a fixed order, and _sort() reorders all cells afterwards anyway.
+	for (PlotBin &bin : plot_bins) {
+		if (bin.cells.is_empty()) {
+			continue;
+		}
+
+		const uint32_t offset = bake_cells.size();
+		const uint32_t count = bin.cells.size();
+		bake_cells.resize(offset + count);
+
+		Cell *dst = bake_cells.ptrw() + offset;
+		const Cell *src = bin.cells.ptr();
+		for (uint32_t i = 0; i < count; i++) {
+			dst[i] = src[i];
+			for (uint32_t j = 0; j < 8; j++) {
+				if (dst[i].children[j] != CHILD_EMPTY) {
+					dst[i].children[j] += offset;
+				}
+			}
+		}
+
+		bake_cells.write[bin.parent].children[bin.parent_child] = offset;
+
+		bin.cells.clear();
+		bin.parent = CHILD_EMPTY;
+	}
+
+	max_original_cells = bake_cells.size();
+}
+
 Vector<Color> Voxelizer::_get_bake_texture(Ref<Image> p_image, const Color &p_color_mul, const Color &p_color_add) {
 	Vector<Color> ret;
 
@@ -424,7 +595,8 @@ Voxelizer::BakeResult Voxelizer::plot_mesh(const Transform3D &p_xform, Ref<Mesh>
 		} else {
 			src_material = p_mesh->surface_get_material(i);
 		}
-		MaterialCache material = _get_material_cache(src_material);
+		uint32_t material = plot_materials.size();
+		plot_materials.push_back(_get_material_cache(src_material));
 
 		Array a = p_mesh->surface_get_arrays(i);
 
@@ -456,6 +628,7 @@ Voxelizer::BakeResult Voxelizer::plot_mesh(const Transform3D &p_xform, Ref<Mesh>
 				bake_current++;
 				if (p_bake_step_func != nullptr && (bake_current & 2047) == 1) {
 					if (p_bake_step_func(bake_current, bake_total)) {
+						plot_faces.clear();
 						return BAKE_RESULT_CANCELLED;
 					}
 				}
@@ -480,8 +653,19 @@ Voxelizer::BakeResult Voxelizer::plot_mesh(const Transform3D &p_xform, Ref<Mesh>
 				if (!Geometry3D::triangle_box_overlap(original_bounds.get_center(), original_bounds.size * 0.5, vtxs)) {
 					continue;
 				}
-				//plot
-				_plot_face(0, 0, 0, 0, 0, vtxs, normal, uvs, material, po2_bounds);
+				//queue for plotting
+				PlotFace face;
+				for (int k = 0; k < 3; k++) {
+					face.vtx[k] = vtxs[k];
+					face.normal[k] = normal[k];
+					face.uv[k] = uvs[k];
+				}
+				face.material = material;
+				plot_faces.push_back(face);
+
+				if (plot_faces.size() >= PLOT_FLUSH_FACES && _plot_binned_faces(bake_current, bake_total, p_bake_step_func) != BAKE_RESULT_OK) {
+					return BAKE_RESULT_CANCELLED;
+				}
 			}
 
 		} else {
@@ -495,6 +679,7 @@ Voxelizer::BakeResult Voxelizer::plot_mesh(const Transform3D &p_xform, Ref<Mesh>
 				bake_current++;
 				if (p_bake_step_func != nullptr && (bake_current & 2047) == 1) {
 					if (p_bake_step_func(bake_current, bake_total)) {
+						plot_faces.clear();
 						return BAKE_RESULT_CANCELLED;
 					}
 				}
@@ -519,14 +704,23 @@ Voxelizer::BakeResult Voxelizer::plot_mesh(const Transform3D &p_xform, Ref<Mesh>
 				if (!Geometry3D::triangle_box_overlap(original_bounds.get_center(), original_bounds.size * 0.5, vtxs)) {
 					continue;
 				}
-				//plot face
-				_plot_face(0, 0, 0, 0, 0, vtxs, normal, uvs, material, po2_bounds);
+				//queue for plotting
+				PlotFace face;
+				for (int k = 0; k < 3; k++) {
+					face.vtx[k] = vtxs[k];
+					face.normal[k] = normal[k];
+					face.uv[k] = uvs[k];
+				}
+				face.material = material;
+				plot_faces.push_back(face);
+
+				if (plot_faces.size() >= PLOT_FLUSH_FACES && _plot_binned_faces(bake_current, bake_total, p_bake_step_func) != BAKE_RESULT_OK) {
+					return BAKE_RESULT_CANCELLED;
+				}
 			}
 		}
 	}
 
-	max_original_cells = bake_cells.size();
-
 	return BAKE_RESULT_OK;
 }
 
@@ -592,71 +786,66 @@ void Voxelizer::_sort() {
 	sorted = true;
 }
 
-void Voxelizer::_fixup_plot(int p_idx, int p_level) {
-	if (p_level == cell_subdiv) {
-		leaf_voxel_count++;
-		float alpha = bake_cells[p_idx].alpha;
+void Voxelizer::_fixup_plot(uint32_t p_index, uint32_t p_from) {
+	const uint32_t idx = p_from + p_index;
+
+	if (bake_cells[idx].level == cell_subdiv) {
+		float alpha = bake_cells[idx].alpha;
 
-		bake_cells.write[p_idx].albedo[0] /= alpha;
-		bake_cells.write[p_idx].albedo[1] /= alpha;
-		bake_cells.write[p_idx].albedo[2] /= alpha;
+		bake_cells.write[idx].albedo[0] /= alpha;
+		bake_cells.write[idx].albedo[1] /= alpha;
+		bake_cells.write[idx].albedo[2] /= alpha;
 
 		//transfer emission to light
-		bake_cells.write[p_idx].emission[0] /= alpha;
-		bake_cells.write[p_idx].emission[1] /= alpha;
-		bake_cells.write[p_idx].emission[2] /= alpha;
+		bake_cells.write[idx].emission[0] /= alpha;
+		bake_cells.write[idx].emission[1] /= alpha;
+		bake_cells.write[idx].emission[2] /= alpha;
 
-		bake_cells.write[p_idx].normal[0] /= alpha;
-		bake_cells.write[p_idx].normal[1] /= alpha;
-		bake_cells.write[p_idx].normal[2] /= alpha;
+		bake_cells.write[idx].normal[0] /= alpha;
+		bake_cells.write[idx].normal[1] /= alpha;
+		bake_cells.write[idx].normal[2] /= alpha;
 
-		Vector3 n(bake_cells[p_idx].normal[0], bake_cells[p_idx].normal[1], bake_cells[p_idx].normal[2]);
+		Vector3 n(bake_cells[idx].normal[0], bake_cells[idx].normal[1], bake_cells[idx].normal[2]);
 		if (n.length() < 0.01) {
 			//too much fight over normal, zero it
-			bake_cells.write[p_idx].normal[0] = 0;
-			bake_cells.write[p_idx].normal[1] = 0;
-			bake_cells.write[p_idx].normal[2] = 0;
+			bake_cells.write[idx].normal[0] = 0;
+			bake_cells.write[idx].normal[1] = 0;
+			bake_cells.write[idx].normal[2] = 0;
 		} else {
 			n.normalize();
-			bake_cells.write[p_idx].normal[0] = n.x;
-			bake_cells.write[p_idx].normal[1] = n.y;
-			bake_cells.write[p_idx].normal[2] = n.z;
+			bake_cells.write[idx].normal[0] = n.x;
+			bake_cells.write[idx].normal[1] = n.y;
+			bake_cells.write[idx].normal[2] = n.z;
 		}
 
-		bake_cells.write[p_idx].alpha = 1.0;
-
-		/*if (bake_light.size()) {
-			for(int i=0;i<6;i++) {
-			}
-		}*/
+		bake_cells.write[idx].alpha = 1.0;
 
 	} else {
-		//go down
-
-		bake_cells.write[p_idx].emission[0] = 0;
-		bake_cells.write[p_idx].emission[1] = 0;
-		bake_cells.write[p_idx].emission[2] = 0;
-		bake_cells.write[p_idx].normal[0] = 0;
-		bake_cells.write[p_idx].normal[1] = 0;
-		bake_cells.write[p_idx].normal[2] = 0;
-		bake_cells.write[p_idx].albedo[0] = 0;
-		bake_cells.write[p_idx].albedo[1] = 0;
-		bake_cells.write[p_idx].albedo[2] = 0;
+		//children are in a deeper level, which was fixed up already
+
+		bake_cells.write[idx].emission[0] = 0;
+		bake_cells.write[idx].emission[1] = 0;
+		bake_cells.write[idx].emission[2] = 0;
+		bake_cells.write[idx].normal[0] = 0;
+		bake_cells.write[idx].normal[1] = 0;
+		bake_cells.write[idx].normal[2] = 0;
+		bake_cells.write[idx].albedo[0] = 0;
+		bake_cells.write[idx].albedo[1] = 0;
+		bake_cells.write[idx].albedo[2] = 0;
 
 		float alpha_average = 0;
 
 		for (int i = 0; i < 8; i++) {
-			uint32_t child = bake_cells[p_idx].children[i];
+			uint32_t child = bake_cells[idx].children[i];
 
 			if (child == CHILD_EMPTY) {
 				continue;
 			}
 
-			_fixup_plot(child, p_level + 1);
 			alpha_average += bake_cells[child].alpha;
 		}
 
-		bake_cells.write[p_idx].alpha = alpha_average / 8.0;
+		bake_cells.write[idx].alpha = alpha_average / 8.0;
 	}
 }
 
@@ -701,13 +890,75 @@ void Voxelizer::begin_bake(int p_subdiv, const AABB &p_bounds, float p_exposure_
 	to_cell_space = to_grid * to_bounds.affine_inverse();
 
 	cell_size = po2_bounds.size[longest_axis] / axis_cell_size[longest_axis];
+
+	plot_bin_level = MIN(cell_subdiv, int(PLOT_BIN_LEVEL));
+	plot_bins.clear();
+	plot_bins.resize(1 << (plot_bin_level * 3));
+	plot_bins_used.clear();
+	plot_faces.clear();
+	plot_materials.clear();
+
+	const int bin_mask = (1 << plot_bin_level) - 1;
+	for (uint32_t i = 0; i < plot_bins.size(); i++) {
+		PlotBin &bin = plot_bins[i];
+		bin.x = (i & bin_mask) << (cell_subdiv - plot_bin_level);
+		bin.y = ((i >> plot_bin_level) & bin_mask) << (cell_subdiv - plot_bin_level);
+		bin.z = ((i >> (plot_bin_level * 2)) & bin_mask) << (cell_subdiv - plot_bin_level);
+
+		// Subdivide the same way _plot_face() does, so bins get the exact same bounds.
+		bin.aabb = po2_bounds;
+		for (int level = 0; level < plot_bin_level; level++) {
+			int half = (1 << cell_subdiv) >> (level + 1);
+			bin.aabb.size *= 0.5;
+			if ((bin.x / half) & 1) {
+				bin.aabb.position.x += bin.aabb.size.x;
+			}
+			if ((bin.y / half) & 1) {
+				bin.aabb.position.y += bin.aabb.size.y;
+			}
+			if ((bin.z / half) & 1) {
+				bin.aabb.position.z += bin.aabb.size.z;
+			}
+		}
+	}
 }
 
 void Voxelizer::end_bake() {
+	if (!plot_faces.is_empty()) {
+		_plot_binned_faces(0, 0, nullptr);
+	}
+	plot_materials.clear();
+	_merge_plot_bins();
+
 	if (!sorted) {
 		_sort();
 	}
-	_fixup_plot(0, 0);
+
+	// Cells are sorted by level, so each level is a contiguous range. Fix up the
+	// deepest level first, so parents can average children that are already final.
+	uint32_t to = bake_cells.size();
+	for (int level = cell_subdiv; level >= 0; level--) {
+		uint32_t from = to;
+		while (from > 0 && bake_cells[from - 1].level == level) {
+			from--;
+		}
+
+		const uint32_t count = to - from;
+		if (level == cell_subdiv) {
+			leaf_voxel_count = count;
+		}
+
+		if (use_threads && count >= FIXUP_THREAD_MIN_CELLS) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &Voxelizer::_fixup_plot, from, count, -1, true, SNAME("VoxelizerFixupPlot"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		} else {
+			for (uint32_t i = 0; i < count; i++) {
+				_fixup_plot(i, from);
+			}
+		}
+
+		to = from;
+	}
 }
 
 //create the data for rendering server
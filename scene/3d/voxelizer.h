@@ -30,6 +30,8 @@
 
 #pragma once
 
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 #include "scene/resources/multimesh.h"
 
 class Voxelizer {
@@ -94,6 +96,43 @@ private:
 	};
 
 	HashMap<Ref<Material>, MaterialCache> material_cache;
+
+	// Faces are binned by the octree cell they overlap at PLOT_BIN_LEVEL, and each bin
+	// builds its own subtree on a worker thread. Faces are plotted in mesh order within
+	// a bin, so the result does not depend on the number of threads.
+	enum {
+		PLOT_BIN_LEVEL = 3,
+		PLOT_FLUSH_FACES = 65536, // Faces gathered, possibly across meshes, before they are plotted.
+		PLOT_THREAD_MIN_FACES = 1024,
+		PLOT_CANCEL_CHECK_FACES = 256,
+		FIXUP_THREAD_MIN_CELLS = 4096,
+	};
+
+	struct PlotFace {
+		Vector3 vtx[3];
+		Vector3 normal[3];
+		Vector2 uv[3];
+		uint32_t material = 0;
+	};
+
+	struct PlotBin {
+		uint32_t parent = CHILD_EMPTY; // Cell in bake_cells holding this bin as a child, CHILD_EMPTY until used.
+		uint32_t parent_child = 0;
+		int x = 0; // Position in leaf cells, as passed to _plot_face().
+		int y = 0;
+		int z = 0;
+		AABB aabb;
+		Vector<Cell> cells; // Subtree of this bin, the bin cell itself is at index 0.
+		LocalVector<uint32_t> faces; // Faces waiting to be plotted, in mesh order.
+	};
+
+	int plot_bin_level = 0;
+	LocalVector<PlotBin> plot_bins;
+	LocalVector<uint32_t> plot_bins_used;
+	LocalVector<PlotFace> plot_faces;
+	LocalVector<MaterialCache> plot_materials;
+	SafeFlag plot_cancelled;
+
 	float exposure_normalization = 1.0;
 	AABB original_bounds;
 	AABB po2_bounds;
@@ -108,11 +147,17 @@ private:
 	int max_original_cells = 0;
 	int leaf_voxel_count = 0;
 
+	bool use_threads = true;
+
 	Vector<Color> _get_bake_texture(Ref<Image> p_image, const Color &p_color_mul, const Color &p_color_add);
 	MaterialCache _get_material_cache(Ref<Material> p_material);
 
-	void _plot_face(int p_idx, int p_level, int p_x, int p_y, int p_z, const Vector3 *p_vtx, const Vector3 *p_normal, const Vector2 *p_uv, const MaterialCache &p_material, const AABB &p_aabb);
-	void _fixup_plot(int p_idx, int p_level);
+	void _plot_face(Vector<Cell> &r_cells, int p_idx, int p_level, int p_x, int p_y, int p_z, const Vector3 *p_vtx, const Vector3 *p_normal, const Vector2 *p_uv, const MaterialCache &p_material, const AABB &p_aabb);
+	void _bin_face(uint32_t p_face);
+	void _plot_bin(uint32_t p_index, const PlotFace *p_faces);
+	BakeResult _plot_binned_faces(int p_bake_current, int p_bake_total, BakeStepFunc p_bake_step_function);
+	void _merge_plot_bins();
+	void _fixup_plot(uint32_t p_index, uint32_t p_from);
 	void _debug_mesh(int p_idx, int p_level, const AABB &p_aabb, Ref<MultiMesh> &p_multimesh, int &idx);
 
 	bool sorted = false;
@@ -124,6 +169,9 @@ public:
 	BakeResult plot_mesh(const Transform3D &p_xform, Ref<Mesh> &p_mesh, const Vector<Ref<Material>> &p_materials, const Ref<Material> &p_override_material, BakeStepFunc p_bake_step_function);
 	void end_bake();
 
+	// Plots and fixes up cells on the calling thread only, the result is the same either way.
+	void set_use_threads(bool p_use_threads) { use_threads = p_use_threads; }
+
 	int get_voxel_gi_octree_depth() const;
 	Vector3i get_voxel_gi_octree_size() const;
 	int get_voxel_gi_cell_count() const;
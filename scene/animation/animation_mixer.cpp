@@ -33,6 +33,8 @@
 
 #include "core/config/engine.h"
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/thread.h"
 #include "core/string/string_name.h"
 #include "scene/2d/audio_stream_player_2d.h"
 #include "scene/animation/animation_player.h"
@@ -581,6 +583,11 @@ bool AnimationMixer::is_dummy() const {
 /* -------------------------------------------- */
 
 void AnimationMixer::_clear_caches() {
+	// A pending parallel blend points into the caches being freed, so drop it.
+	if (parallel_pending) {
+		parallel_pending = false;
+		clear_animation_instances();
+	}
 	_init_root_motion_cache();
 	_clear_audio_streams();
 	_clear_playing_caches();
@@ -646,6 +653,9 @@ void AnimationMixer::_create_track_num_to_track_cache_for_animation(Ref<Animatio
 }
 
 bool AnimationMixer::_update_caches() {
+	// Apply a pending parallel blend before its track caches are rebuilt.
+	_finish_pending_blend();
+
 	setup_pass++;
 
 	root_motion_cache.loc = Vector3(0, 0, 0);
@@ -1000,18 +1010,169 @@ bool AnimationMixer::_update_caches() {
 /* -------------------------------------------- */
 
 void AnimationMixer::_process_animation(double p_delta, bool p_update_only) {
-	_blend_init();
-	if (cache_valid && _blend_pre_process(p_delta, track_count, track_map)) {
-		_blend_capture(p_delta);
+	_finish_pending_blend();
+	if (_blend_begin(p_delta)) {
 		_blend_calc_total_weight();
 		_blend_process(p_delta, p_update_only);
-		_blend_apply();
-		_blend_post_process();
-		emit_signal(SNAME("mixer_applied"));
-	};
+		_blend_end();
+	}
 	clear_animation_instances();
 }
 
+bool AnimationMixer::_blend_begin(double p_delta) {
+	_blend_init();
+	if (!cache_valid || !_blend_pre_process(p_delta, track_count, track_map)) {
+		return false;
+	}
+	_blend_capture(p_delta);
+	return true;
+}
+
+void AnimationMixer::_blend_end() {
+	_blend_apply();
+	_blend_post_process();
+	emit_signal(SNAME("mixer_applied"));
+}
+
+bool AnimationMixer::_can_blend_in_parallel() const {
+#ifdef TOOLS_ENABLED
+	if (editing) {
+		return false;
+	}
+#endif // TOOLS_ENABLED
+	if (is_GDVIRTUAL_CALL_post_process_key_value) {
+		return false; // Overridden by a script, which must run on the main thread.
+	}
+	bool force_continuous = callback_mode_discrete == ANIMATION_CALLBACK_MODE_DISCRETE_FORCE_CONTINUOUS;
+	for (const AnimationInstance &ai : animation_instances) {
+		const Ref<Animation> &a = ai.animation_data.animation;
+		const LocalVector<Animation::Track *> &tracks = a->get_tracks();
+		for (uint32_t i = 0; i < tracks.size(); i++) {
+			const Animation::Track *animation_track = tracks[i];
+			if (!animation_track->enabled) {
+				continue;
+			}
+			switch (animation_track->type) {
+				case Animation::TYPE_POSITION_3D:
+				case Animation::TYPE_ROTATION_3D:
+				case Animation::TYPE_SCALE_3D:
+				case Animation::TYPE_BLEND_SHAPE:
+				case Animation::TYPE_BEZIER: {
+				} break;
+				case Animation::TYPE_VALUE: {
+					// Discrete values are set on the object while blending.
+					if (!force_continuous && a->value_track_get_update_mode(i) == Animation::UPDATE_DISCRETE) {
+						return false;
+					}
+				} break;
+				default: {
+					// Method, audio and animation tracks call into other nodes while blending.
+					return false;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+void AnimationMixer::_schedule_process_animation(double p_delta) {
+	// Mixers in sub-thread process groups are processed concurrently, only the main thread batches.
+	if (!GLOBAL_GET_CACHED(bool, "animation/mixer/parallel_evaluation") || !Thread::is_main_thread()) {
+		_process_animation(p_delta);
+		return;
+	}
+
+	_finish_pending_blend();
+	if (!_blend_begin(p_delta)) {
+		clear_animation_instances();
+		return;
+	}
+
+	if (is_GDVIRTUAL_CALL_post_process_key_value && !GDVIRTUAL_IS_OVERRIDDEN(_post_process_key_value)) {
+		is_GDVIRTUAL_CALL_post_process_key_value = false;
+	}
+	if (!_can_blend_in_parallel()) {
+		_blend_calc_total_weight();
+		_blend_process(p_delta);
+		_blend_end();
+		clear_animation_instances();
+		return;
+	}
+
+	parallel_pending = true;
+	parallel_delta = p_delta;
+	parallel_batch.push_back(get_instance_id());
+	if (!parallel_batch_queued) {
+		parallel_batch_queued = true;
+		callable_mp_static(&AnimationMixer::_process_parallel_batch).call_deferred();
+	}
+}
+
+void AnimationMixer::_finish_pending_blend() {
+	if (!parallel_pending) {
+		return;
+	}
+	// Processed again before the batch ran (e.g. by a seek), so finish the pending blend here.
+	parallel_pending = false;
+	if (cache_valid) {
+		_blend_calc_total_weight();
+		_blend_process(parallel_delta);
+		_blend_end();
+	}
+	clear_animation_instances();
+}
+
+void AnimationMixer::_blend_parallel_task(void *p_userdata, uint32_t p_index) {
+	AnimationMixer *mixer = static_cast<AnimationMixer **>(p_userdata)[p_index];
+	mixer->_blend_calc_total_weight();
+	mixer->_blend_process(mixer->parallel_delta);
+}
+
+void AnimationMixer::_process_parallel_batch() {
+	parallel_batch_queued = false;
+
+	LocalVector<ObjectID> batch;
+	SWAP(batch, parallel_batch);
+
+	LocalVector<AnimationMixer *> mixers;
+	LocalVector<ObjectID> mixer_ids;
+	for (const ObjectID &id : batch) {
+		AnimationMixer *mixer = ObjectDB::get_instance<AnimationMixer>(id);
+		if (!mixer || !mixer->parallel_pending) {
+			continue; // Freed, or already finished by another process call.
+		}
+		if (!mixer->cache_valid) {
+			// Caches were cleared while pending, e.g. the mixer left the tree.
+			mixer->parallel_pending = false;
+			mixer->clear_animation_instances();
+			continue;
+		}
+		mixers.push_back(mixer);
+		mixer_ids.push_back(id);
+	}
+
+	if (mixers.size() >= PARALLEL_BLEND_MIN_MIXERS) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&AnimationMixer::_blend_parallel_task, mixers.ptr(), mixers.size(), -1, true, SNAME("AnimationMixerBlend"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (AnimationMixer *mixer : mixers) {
+			mixer->_blend_calc_total_weight();
+			mixer->_blend_process(mixer->parallel_delta);
+		}
+	}
+
+	// Applying may run scripts through setters and signals, which could free other mixers.
+	for (const ObjectID &id : mixer_ids) {
+		AnimationMixer *mixer = ObjectDB::get_instance<AnimationMixer>(id);
+		if (!mixer || !mixer->parallel_pending) {
+			continue;
+		}
+		mixer->parallel_pending = false;
+		mixer->_blend_end();
+		mixer->clear_animation_instances();
+	}
+}
+
 Variant AnimationMixer::_post_process_key_value(const Ref<Animation> &p_anim, int p_track, Variant &p_value, ObjectID p_object_id, int p_object_sub_idx) {
 #ifndef _3D_DISABLED
 	switch (p_anim->track_get_type(p_track)) {
@@ -2355,13 +2516,13 @@ void AnimationMixer::_notification(int p_what) {
 
 		case NOTIFICATION_INTERNAL_PROCESS: {
 			if (active && callback_mode_process == ANIMATION_CALLBACK_MODE_PROCESS_IDLE) {
-				_process_animation(get_process_delta_time());
+				_schedule_process_animation(get_process_delta_time());
 			}
 		} break;
 
 		case NOTIFICATION_INTERNAL_PHYSICS_PROCESS: {
 			if (active && callback_mode_process == ANIMATION_CALLBACK_MODE_PROCESS_PHYSICS) {
-				_process_animation(get_physics_process_delta_time());
+				_schedule_process_animation(get_physics_process_delta_time());
 			}
 		} break;
 
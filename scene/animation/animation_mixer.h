@@ -326,6 +326,26 @@ protected:
 	int track_count = 0;
 	bool deterministic = false;
 
+	/* ---- Parallel evaluation ---- */
+	// With "animation/mixer/parallel_evaluation", mixers processed in the same frame whose tracks
+	// only write into their track caches are blended together on the WorkerThreadPool at the end
+	// of the frame. Applying the results to nodes is still done serially on the main thread.
+	// Only mixers processed on the main thread are batched, so the batch needs no lock.
+	enum {
+		PARALLEL_BLEND_MIN_MIXERS = 4,
+	};
+
+	static inline LocalVector<ObjectID> parallel_batch;
+	static inline bool parallel_batch_queued = false;
+	bool parallel_pending = false;
+	double parallel_delta = 0.0;
+
+	bool _can_blend_in_parallel() const;
+	void _schedule_process_animation(double p_delta);
+	void _finish_pending_blend();
+	static void _blend_parallel_task(void *p_userdata, uint32_t p_index);
+	static void _process_parallel_batch();
+
 	/* ---- Root motion accumulator for Skeleton3D ---- */
 	NodePath root_motion_track;
 	bool root_motion_local = false;
@@ -364,6 +384,8 @@ protected:
 	GDVIRTUAL5RC(Variant, _post_process_key_value, Ref<Animation>, int, Variant, ObjectID, int);
 
 	void _blend_init();
+	bool _blend_begin(double p_delta);
+	void _blend_end();
 	virtual bool _blend_pre_process(double p_delta, int p_track_count, const AHashMap<NodePath, int> &p_track_map);
 	virtual void _blend_capture(double p_delta);
 	void _blend_calc_total_weight(); // For indeterministic blending.
@@ -33,7 +33,17 @@
 #include "scene/resources/mesh.h"
 #include "servers/physics_3d/physics_server_3d.h"
 
+void ConcavePolygonShape3D::_load_lazy_faces() const {
+	_load_lazy_property(SNAME("data"), [this](const Variant &p_value) {
+		ConcavePolygonShape3D *self = const_cast<ConcavePolygonShape3D *>(this);
+		self->faces = p_value;
+		self->_update_shape();
+	});
+}
+
 Vector<Vector3> ConcavePolygonShape3D::get_debug_mesh_lines() const {
+	_load_lazy_faces();
+
 	HashSet<DrawEdge, DrawEdge> edges;
 
 	int index_count = faces.size();
@@ -61,6 +71,8 @@ Vector<Vector3> ConcavePolygonShape3D::get_debug_mesh_lines() const {
 }
 
 Ref<ArrayMesh> ConcavePolygonShape3D::get_debug_arraymesh_faces(const Color &p_modulate) const {
+	_load_lazy_faces();
+
 	Vector<Color> colors;
 
 	for (int i = 0; i < faces.size(); i++) {
@@ -87,6 +99,16 @@ real_t ConcavePolygonShape3D::get_enclosing_radius() const {
 	return Math::sqrt(r);
 }
 
+RID ConcavePolygonShape3D::get_rid() const {
+	// Physics needs the faces as soon as the shape is used anywhere.
+	_load_lazy_faces();
+	return Shape3D::get_rid();
+}
+
+bool ConcavePolygonShape3D::can_load_property_lazily(const StringName &p_name) const {
+	return p_name == SNAME("data");
+}
+
 void ConcavePolygonShape3D::_update_shape() {
 	Dictionary d;
 	d["faces"] = faces;
@@ -97,18 +119,21 @@ void ConcavePolygonShape3D::_update_shape() {
 }
 
 void ConcavePolygonShape3D::set_faces(const Vector<Vector3> &p_faces) {
+	_discard_lazy_property(SNAME("data"));
 	faces = p_faces;
 	_update_shape();
 	emit_changed();
 }
 
 Vector<Vector3> ConcavePolygonShape3D::get_faces() const {
+	_load_lazy_faces();
 	return faces;
 }
 
 void ConcavePolygonShape3D::set_backface_collision_enabled(bool p_enabled) {
 	backface_collision = p_enabled;
 
+	_load_lazy_faces();
 	if (!faces.is_empty()) {
 		_update_shape();
 		emit_changed();
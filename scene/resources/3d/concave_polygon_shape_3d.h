@@ -60,6 +60,8 @@ class ConcavePolygonShape3D : public Shape3D {
 		}
 	};
 
+	void _load_lazy_faces() const;
+
 protected:
 	static void _bind_methods();
 
@@ -76,5 +78,8 @@ public:
 	virtual Ref<ArrayMesh> get_debug_arraymesh_faces(const Color &p_modulate) const override;
 	virtual real_t get_enclosing_radius() const override;
 
+	virtual RID get_rid() const override;
+	virtual bool can_load_property_lazily(const StringName &p_name) const override;
+
 	ConcavePolygonShape3D();
 };
@@ -578,6 +578,8 @@ public:
 
 	static TrackType get_cache_type(TrackType p_type);
 
+	virtual bool has_thread_safe_setters() const override { return true; }
+
 	Animation();
 	~Animation();
 };
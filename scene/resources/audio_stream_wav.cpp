@@ -655,12 +655,12 @@ Ref<AudioSample> AudioStreamWAV::generate_sample() const {
 	return sample;
 }
 
-Ref<AudioStreamWAV> AudioStreamWAV::load_from_buffer(const Vector<uint8_t> &p_stream_data, const Dictionary &p_options) {
+Ref<AudioStreamWAV> AudioStreamWAV::_load_from_memory(const uint8_t *p_data, uint64_t p_size, const Dictionary &p_options) {
 	// /* STEP 1, READ WAVE FILE */
 
 	Ref<FileAccessMemory> file;
 	file.instantiate();
-	Error err = file->open_custom(p_stream_data.ptr(), p_stream_data.size());
+	Error err = file->open_custom(p_data, p_size);
 	ERR_FAIL_COND_V_MSG(err != OK, Ref<AudioStreamWAV>(), "Cannot create memfile for WAV file buffer.");
 
 	/* CHECK RIFF */
@@ -1198,7 +1198,21 @@ Ref<AudioStreamWAV> AudioStreamWAV::load_from_buffer(const Vector<uint8_t> &p_st
 	return sample;
 }
 
+Ref<AudioStreamWAV> AudioStreamWAV::load_from_buffer(const Vector<uint8_t> &p_stream_data, const Dictionary &p_options) {
+	return _load_from_memory(p_stream_data.ptr(), p_stream_data.size(), p_options);
+}
+
 Ref<AudioStreamWAV> AudioStreamWAV::load_from_file(const String &p_path, const Dictionary &p_options) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ);
+	ERR_FAIL_COND_V_MSG(f.is_null(), Ref<AudioStreamWAV>(), vformat("Cannot open file '%s'.", p_path));
+
+	// Parse the mapped file directly when possible instead of reading it into memory first.
+	uint64_t length = f->get_length();
+	const uint8_t *view = length > 0 ? f->get_buffer_view(length) : nullptr;
+	if (view) {
+		return _load_from_memory(view, length, p_options);
+	}
+
 	const Vector<uint8_t> stream_data = FileAccess::get_file_as_bytes(p_path);
 	ERR_FAIL_COND_V_MSG(stream_data.is_empty(), Ref<AudioStreamWAV>(), vformat("Cannot open file '%s'.", p_path));
 	return load_from_buffer(stream_data, p_options);
@@ -126,6 +126,8 @@ private:
 
 	Dictionary tags;
 
+	static Ref<AudioStreamWAV> _load_from_memory(const uint8_t *p_data, uint64_t p_size, const Dictionary &p_options);
+
 protected:
 	static void _bind_methods();
 
@@ -70,6 +70,8 @@ public:
 		}
 	};
 
+	virtual bool has_thread_safe_setters() const override { return true; }
+
 	Curve();
 
 	int get_point_count() const { return _points.size(); }
@@ -252,6 +254,8 @@ public:
 
 	PackedVector2Array tessellate(int p_max_stages = 5, real_t p_tolerance = 4) const; //useful for display
 	PackedVector2Array tessellate_even_length(int p_max_stages = 5, real_t p_length = 20.0) const; // Useful for baking.
+
+	virtual bool has_thread_safe_setters() const override { return true; }
 };
 
 class Curve3D : public Resource {
@@ -360,4 +364,6 @@ public:
 
 	PackedVector3Array tessellate(int p_max_stages = 5, real_t p_tolerance = 4) const; // Useful for display.
 	PackedVector3Array tessellate_even_length(int p_max_stages = 5, real_t p_length = 0.2) const; // Useful for baking.
+
+	virtual bool has_thread_safe_setters() const override { return true; }
 };
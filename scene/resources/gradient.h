@@ -123,6 +123,8 @@ protected:
 	void _validate_property(PropertyInfo &p_property) const;
 
 public:
+	virtual bool has_thread_safe_setters() const override { return true; }
+
 	Gradient();
 	virtual ~Gradient();
 
@@ -35,6 +35,7 @@
 #include "core/io/missing_resource.h"
 #include "core/io/resource_loader.h"
 #include "core/object/script_language.h"
+#include "core/os/os.h"
 #include "core/templates/local_vector.h"
 #include "core/variant/callable_bind.h"
 #include "scene/2d/node_2d.h"
@@ -144,11 +145,7 @@ static Node *_find_node_by_id(Node *p_owner, Node *p_node, int32_t p_id) {
 	return nullptr;
 }
 
-Node *SceneState::instantiate(GenEditState p_edit_state) const {
-	// Nodes where instantiation failed (because something is missing.)
-	List<Node *> stray_instances;
-
-#define NODE_FROM_ID(p_name, p_id)                                             \
+#define NODE_FROM_ID(p_name, p_id, p_fail_ret)                                 \
 	Node *p_name;                                                              \
 	if (p_id & FLAG_ID_IS_PATH) {                                              \
 		NodePath np = node_paths[p_id & FLAG_MASK];                            \
@@ -157,443 +154,515 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 			p_name = _recover_node_path_index(ret_nodes[0], p_id & FLAG_MASK); \
 		}                                                                      \
 	} else {                                                                   \
-		ERR_FAIL_INDEX_V(p_id & FLAG_MASK, nc, nullptr);                       \
+		ERR_FAIL_INDEX_V(p_id & FLAG_MASK, nc, p_fail_ret);                    \
 		p_name = ret_nodes[p_id & FLAG_MASK];                                  \
 	}
 
-	int nc = nodes.size();
-	ERR_FAIL_COND_V_MSG(nc == 0, nullptr, vformat("Failed to instantiate scene state of \"%s\", node count is 0. Make sure the PackedScene resource is valid.", path));
+void SceneState::_build_instantiation_plan() const {
+	// Built separately, instantiations still running keep their reference to the previous plan.
+	Vector<NodePlan> plan;
+	plan.resize(nodes.size());
+	NodePlan *plan_ptrw = plan.ptrw();
 
-	const StringName *snames = nullptr;
-	int sname_count = names.size();
-	if (sname_count) {
-		snames = &names[0];
-	}
+	for (int i = 0; i < nodes.size(); i++) {
+		const NodeData &n = nodes[i];
+		if (n.type == TYPE_INSTANTIATED || n.instance >= 0 || (i == 0 && base_scene_idx >= 0) || n.type < 0 || n.type >= names.size()) {
+			continue; // Not created through ClassDB.
+		}
 
-	const Variant *props = nullptr;
-	int prop_count = variants.size();
-	if (prop_count) {
-		props = &variants[0];
+		NodePlan &node_plan = plan_ptrw[i];
+		const StringName &type = names[n.type];
+		node_plan.creation_func = ClassDB::get_native_creation_func(type);
+		if (!node_plan.creation_func) {
+			continue;
+		}
+
+		node_plan.setters.resize(n.properties.size());
+		for (int j = 0; j < n.properties.size(); j++) {
+			const int name = n.properties[j].name;
+			if ((name & FLAG_PATH_PROPERTY_IS_NODE) || name < 0 || name >= names.size() || names[name] == CoreStringName(script)) {
+				continue;
+			}
+			node_plan.setters[j].method = ClassDB::get_property_setter_method(type, names[name], &node_plan.setters[j].index);
+		}
 	}
 
-	//Vector<Variant> properties;
+	instantiation_plan = plan;
+	instantiation_plan_valid = true;
+}
 
-	const NodeData *nd = &nodes[0];
+void SceneState::_invalidate_instantiation_plan() {
+	MutexLock lock(instantiation_plan_mutex);
+	instantiation_plan_valid = false;
+}
 
-	Node **ret_nodes = (Node **)alloca(sizeof(Node *) * nc);
-	ret_nodes[0] = nullptr; // Sidesteps "maybe uninitialized" false-positives on GCC.
+bool SceneState::instantiate_begin(InstantiationData &r_data, GenEditState p_edit_state) const {
+	int nc = nodes.size();
+	ERR_FAIL_COND_V_MSG(nc == 0, false, vformat("Failed to instantiate scene state of \"%s\", node count is 0. Make sure the PackedScene resource is valid.", path));
 
-	bool gen_node_path_cache = p_edit_state != GEN_EDIT_STATE_DISABLED && node_path_cache.is_empty();
+	r_data.edit_state = p_edit_state;
+	r_data.next_node = 0;
+	r_data.ret_nodes.resize(nc);
+	r_data.ret_nodes[0] = nullptr;
+	r_data.gen_node_path_cache = p_edit_state != GEN_EDIT_STATE_DISABLED && node_path_cache.is_empty();
+	r_data.deep_search_warned = false;
 
-	HashMap<Ref<Resource>, Ref<Resource>> resources_local_to_scene;
+	// The editor needs Object::set() to keep track of edits, so only use the plan at runtime.
+	r_data.plan.clear();
+	if (p_edit_state == GEN_EDIT_STATE_DISABLED && !Engine::get_singleton()->is_editor_hint()) {
+		MutexLock lock(instantiation_plan_mutex);
+		if (!instantiation_plan_valid || instantiation_plan.size() != nc) {
+			_build_instantiation_plan();
+		}
+		r_data.plan = instantiation_plan;
+	}
+	return true;
+}
 
-	LocalVector<DeferredNodePathProperties> deferred_node_paths;
+bool SceneState::instantiate_step(InstantiationData &r_data) const {
+	int nc = nodes.size();
+	ERR_FAIL_INDEX_V(r_data.next_node, nc, false);
+	ERR_FAIL_COND_V((int)r_data.ret_nodes.size() != nc, false);
 
-	bool deep_search_warned = false;
+	const StringName *snames = names.ptr();
+	int sname_count = names.size();
+	const Variant *props = variants.ptr();
+	int prop_count = variants.size();
 
-	for (int i = 0; i < nc; i++) {
-		const NodeData &n = nd[i];
+	Node **ret_nodes = r_data.ret_nodes.ptr();
+	const int i = r_data.next_node++;
+	const NodeData &n = nodes[i];
+	const NodePlan *node_plan = i < r_data.plan.size() ? &r_data.plan[i] : nullptr;
 
-		Node *parent = nullptr;
-		String old_parent_path;
+	Node *parent = nullptr;
+	String old_parent_path;
 
-		if (i > 0) {
-			ERR_FAIL_COND_V_MSG(n.parent == -1, nullptr, vformat("Invalid scene: node %s does not specify its parent node.", snames[n.name]));
-			NODE_FROM_ID(nparent, n.parent);
+	if (i > 0) {
+		ERR_FAIL_COND_V_MSG(n.parent == -1, false, vformat("Invalid scene: node %s does not specify its parent node.", snames[n.name]));
+		NODE_FROM_ID(nparent, n.parent, false);
 #ifdef DEBUG_ENABLED
-			if (!nparent && (n.parent & FLAG_ID_IS_PATH)) {
-				WARN_PRINT(String("Parent path '" + String(node_paths[n.parent & FLAG_MASK]) + "' for node '" + String(snames[n.name]) + "' has vanished when instantiating: '" + get_path() + "'.").ascii().get_data());
-				old_parent_path = String(node_paths[n.parent & FLAG_MASK]).trim_prefix("./").replace_char('/', '@');
-				nparent = ret_nodes[0];
-			}
+		if (!nparent && (n.parent & FLAG_ID_IS_PATH)) {
+			WARN_PRINT(String("Parent path '" + String(node_paths[n.parent & FLAG_MASK]) + "' for node '" + String(snames[n.name]) + "' has vanished when instantiating: '" + get_path() + "'.").ascii().get_data());
+			old_parent_path = String(node_paths[n.parent & FLAG_MASK]).trim_prefix("./").replace_char('/', '@');
+			nparent = ret_nodes[0];
+		}
 #endif
-			parent = nparent;
-		} else {
-			// i == 0 is root node.
-			ERR_FAIL_COND_V_MSG(n.parent != -1, nullptr, vformat("Invalid scene: root node %s cannot specify a parent node.", snames[n.name]));
-			ERR_FAIL_COND_V_MSG(n.type == TYPE_INSTANTIATED && base_scene_idx < 0, nullptr, vformat("Invalid scene: root node %s in an instance, but there's no base scene.", snames[n.name]));
-		}
-
-		Node *node = nullptr;
-		MissingNode *missing_node = nullptr;
-		bool is_inherited_scene = false;
-
-		if (i == 0 && base_scene_idx >= 0) {
-			// Scene inheritance on root node.
-			Ref<PackedScene> sdata = props[base_scene_idx];
-			ERR_FAIL_COND_V(sdata.is_null(), nullptr);
-			node = sdata->instantiate(p_edit_state == GEN_EDIT_STATE_DISABLED ? PackedScene::GEN_EDIT_STATE_DISABLED : PackedScene::GEN_EDIT_STATE_INSTANCE); //only main gets main edit state
-			ERR_FAIL_NULL_V(node, nullptr);
-			if (p_edit_state != GEN_EDIT_STATE_DISABLED) {
-				node->set_scene_inherited_state(sdata->get_state());
-			}
-			is_inherited_scene = true;
-		} else if (n.instance >= 0) {
-			// Instance a scene into this node.
-			if (n.instance & FLAG_INSTANCE_IS_PLACEHOLDER) {
-				const String scene_path = props[n.instance & FLAG_MASK];
-				if (disable_placeholders) {
-					Ref<PackedScene> sdata = ResourceLoader::load(scene_path, "PackedScene");
-					if (sdata.is_valid()) {
-						node = sdata->instantiate(p_edit_state == GEN_EDIT_STATE_DISABLED ? PackedScene::GEN_EDIT_STATE_DISABLED : PackedScene::GEN_EDIT_STATE_INSTANCE);
-						ERR_FAIL_NULL_V(node, nullptr);
-					} else if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
-						missing_node = memnew(MissingNode);
-						missing_node->set_original_scene(scene_path);
-						missing_node->set_recording_properties(true);
-						node = missing_node;
-					} else {
-						ERR_FAIL_V_MSG(nullptr, "Placeholder scene is missing.");
-					}
-				} else {
-					InstancePlaceholder *ip = memnew(InstancePlaceholder);
-					ip->set_instance_path(scene_path);
-					node = ip;
-				}
-				node->set_scene_instance_load_placeholder(true);
-			} else {
-				Ref<Resource> res = props[n.instance & FLAG_MASK];
-				Ref<PackedScene> sdata = res;
+		parent = nparent;
+	} else {
+		// i == 0 is root node.
+		ERR_FAIL_COND_V_MSG(n.parent != -1, false, vformat("Invalid scene: root node %s cannot specify a parent node.", snames[n.name]));
+		ERR_FAIL_COND_V_MSG(n.type == TYPE_INSTANTIATED && base_scene_idx < 0, false, vformat("Invalid scene: root node %s in an instance, but there's no base scene.", snames[n.name]));
+	}
+
+	Node *node = nullptr;
+	MissingNode *missing_node = nullptr;
+	bool is_inherited_scene = false;
+
+	if (i == 0 && base_scene_idx >= 0) {
+		// Scene inheritance on root node.
+		Ref<PackedScene> sdata = props[base_scene_idx];
+		ERR_FAIL_COND_V(sdata.is_null(), false);
+		node = sdata->instantiate(r_data.edit_state == GEN_EDIT_STATE_DISABLED ? PackedScene::GEN_EDIT_STATE_DISABLED : PackedScene::GEN_EDIT_STATE_INSTANCE); //only main gets main edit state
+		ERR_FAIL_NULL_V(node, false);
+		if (r_data.edit_state != GEN_EDIT_STATE_DISABLED) {
+			node->set_scene_inherited_state(sdata->get_state());
+		}
+		is_inherited_scene = true;
+	} else if (n.instance >= 0) {
+		// Instance a scene into this node.
+		if (n.instance & FLAG_INSTANCE_IS_PLACEHOLDER) {
+			const String scene_path = props[n.instance & FLAG_MASK];
+			if (disable_placeholders) {
+				Ref<PackedScene> sdata = ResourceLoader::load(scene_path, "PackedScene");
 				if (sdata.is_valid()) {
-					node = sdata->instantiate(p_edit_state == GEN_EDIT_STATE_DISABLED ? PackedScene::GEN_EDIT_STATE_DISABLED : PackedScene::GEN_EDIT_STATE_INSTANCE);
-					ERR_FAIL_NULL_V_MSG(node, nullptr, vformat("Failed to load scene dependency: \"%s\". Make sure the required scene is valid.", sdata->get_path()));
+					node = sdata->instantiate(r_data.edit_state == GEN_EDIT_STATE_DISABLED ? PackedScene::GEN_EDIT_STATE_DISABLED : PackedScene::GEN_EDIT_STATE_INSTANCE);
+					ERR_FAIL_NULL_V(node, false);
 				} else if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
 					missing_node = memnew(MissingNode);
-#ifdef TOOLS_ENABLED
-					if (res.is_valid()) {
-						missing_node->set_original_scene(res->get_meta("__load_path__", ""));
-					}
-#endif
+					missing_node->set_original_scene(scene_path);
 					missing_node->set_recording_properties(true);
 					node = missing_node;
 				} else {
-					ERR_FAIL_V_MSG(nullptr, "Scene instance is missing.");
+					ERR_FAIL_V_MSG(false, "Placeholder scene is missing.");
 				}
+			} else {
+				InstancePlaceholder *ip = memnew(InstancePlaceholder);
+				ip->set_instance_path(scene_path);
+				node = ip;
 			}
+			node->set_scene_instance_load_placeholder(true);
+		} else {
+			Ref<Resource> res = props[n.instance & FLAG_MASK];
+			Ref<PackedScene> sdata = res;
+			if (sdata.is_valid()) {
+				node = sdata->instantiate(r_data.edit_state == GEN_EDIT_STATE_DISABLED ? PackedScene::GEN_EDIT_STATE_DISABLED : PackedScene::GEN_EDIT_STATE_INSTANCE);
+				ERR_FAIL_NULL_V_MSG(node, false, vformat("Failed to load scene dependency: \"%s\". Make sure the required scene is valid.", sdata->get_path()));
+			} else if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
+				missing_node = memnew(MissingNode);
+#ifdef TOOLS_ENABLED
+				if (res.is_valid()) {
+					missing_node->set_original_scene(res->get_meta("__load_path__", ""));
+				}
+#endif
+				missing_node->set_recording_properties(true);
+				node = missing_node;
+			} else {
+				ERR_FAIL_V_MSG(false, "Scene instance is missing.");
+			}
+		}
 
-		} else if (n.type == TYPE_INSTANTIATED) {
-			// Get the node from somewhere, it likely already exists from another instance.
-			if (parent) {
-				node = parent->_get_child_by_name(snames[n.name]);
-				if (i < ids.size()) {
-					if (!node) {
-						// Can't get by name, try to fetch by ID. This is slow, but should be fixed after re-save.
-						int32_t id = ids[i];
-						if (id != Node::UNIQUE_SCENE_ID_UNASSIGNED) {
-							if (!deep_search_warned) {
-								WARN_PRINT(vformat("%sA node in the scene this one inherits from has been removed or moved, so a recovery process needs to take place. Please re-save this scene to avoid the cost of this process next time.", !get_path().is_empty() ? get_path() + ": " : ""));
-								deep_search_warned = true;
-							}
-							Node *base = parent;
-							while (base != ret_nodes[0] && !base->is_instance()) {
-								base = base->get_parent();
-							}
-							node = _find_node_by_id(base, base, id);
+	} else if (n.type == TYPE_INSTANTIATED) {
+		// Get the node from somewhere, it likely already exists from another instance.
+		if (parent) {
+			node = parent->_get_child_by_name(snames[n.name]);
+			if (i < ids.size()) {
+				if (!node) {
+					// Can't get by name, try to fetch by ID. This is slow, but should be fixed after re-save.
+					int32_t id = ids[i];
+					if (id != Node::UNIQUE_SCENE_ID_UNASSIGNED) {
+						if (!r_data.deep_search_warned) {
+							WARN_PRINT(vformat("%sA node in the scene this one inherits from has been removed or moved, so a recovery process needs to take place. Please re-save this scene to avoid the cost of this process next time.", !get_path().is_empty() ? get_path() + ": " : ""));
+							r_data.deep_search_warned = true;
 						}
-					} else {
-						if (ids[i] != node->get_unique_scene_id()) {
-							// This may be a scene that did not originally have ids and
-							// was saved before the parent, so force the id to match the
-							// parent scene node id.
-							ids.write[i] = node->get_unique_scene_id();
+						Node *base = parent;
+						while (base != ret_nodes[0] && !base->is_instance()) {
+							base = base->get_parent();
 						}
+						node = _find_node_by_id(base, base, id);
+					}
+				} else {
+					if (ids[i] != node->get_unique_scene_id()) {
+						// This may be a scene that did not originally have ids and
+						// was saved before the parent, so force the id to match the
+						// parent scene node id.
+						ids.write[i] = node->get_unique_scene_id();
 					}
 				}
+			}
 #ifdef DEBUG_ENABLED
-				if (!node) {
-					WARN_PRINT(String("Node '" + String(ret_nodes[0]->get_path_to(parent)) + "/" + String(snames[n.name]) + "' was modified from inside an instance, but it has vanished.").ascii().get_data());
-				}
-#endif
+			if (!node) {
+				WARN_PRINT(String("Node '" + String(ret_nodes[0]->get_path_to(parent)) + "/" + String(snames[n.name]) + "' was modified from inside an instance, but it has vanished.").ascii().get_data());
 			}
-		} else {
-			// Node belongs to this scene and must be created.
-			Object *obj = ClassDB::instantiate(snames[n.type]);
+#endif
+		}
+	} else {
+		// Node belongs to this scene and must be created.
+		Object *obj = (node_plan && node_plan->creation_func) ? node_plan->creation_func(true) : ClassDB::instantiate(snames[n.type]);
 
-			node = Object::cast_to<Node>(obj);
+		node = Object::cast_to<Node>(obj);
 
-			if (!node) {
-				if (obj) {
-					memdelete(obj);
-					obj = nullptr;
-				}
+		if (!node) {
+			if (obj) {
+				memdelete(obj);
+				obj = nullptr;
+			}
 
-				if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
-					missing_node = memnew(MissingNode);
-					missing_node->set_original_class(snames[n.type]);
-					missing_node->set_recording_properties(true);
-					node = missing_node;
-					obj = missing_node;
-				} else {
-					WARN_PRINT(vformat("Node %s of type %s cannot be created. A placeholder will be created instead.", snames[n.name], snames[n.type]).ascii().get_data());
-					if (n.parent >= 0 && n.parent < nc && ret_nodes[n.parent]) {
-						if (Object::cast_to<Control>(ret_nodes[n.parent])) {
-							obj = memnew(Control);
-						} else if (Object::cast_to<Node2D>(ret_nodes[n.parent])) {
-							obj = memnew(Node2D);
+			if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
+				missing_node = memnew(MissingNode);
+				missing_node->set_original_class(snames[n.type]);
+				missing_node->set_recording_properties(true);
+				node = missing_node;
+				obj = missing_node;
+			} else {
+				WARN_PRINT(vformat("Node %s of type %s cannot be created. A placeholder will be created instead.", snames[n.name], snames[n.type]).ascii().get_data());
+				if (n.parent >= 0 && n.parent < nc && ret_nodes[n.parent]) {
+					if (Object::cast_to<Control>(ret_nodes[n.parent])) {
+						obj = memnew(Control);
+					} else if (Object::cast_to<Node2D>(ret_nodes[n.parent])) {
+						obj = memnew(Node2D);
 #ifndef _3D_DISABLED
-						} else if (Object::cast_to<Node3D>(ret_nodes[n.parent])) {
-							obj = memnew(Node3D);
+					} else if (Object::cast_to<Node3D>(ret_nodes[n.parent])) {
+						obj = memnew(Node3D);
 #endif // _3D_DISABLED
-						}
-					}
-
-					if (!obj) {
-						obj = memnew(Node);
 					}
+				}
 
-					node = Object::cast_to<Node>(obj);
+				if (!obj) {
+					obj = memnew(Node);
 				}
-			}
-		}
 
-		if (node) {
-			if (i < ids.size()) {
-				node->set_unique_scene_id(ids[i]);
+				node = Object::cast_to<Node>(obj);
 			}
-			// may not have found the node (part of instantiated scene and removed)
-			// if found all is good, otherwise ignore
-
-			//properties
-			int nprop_count = n.properties.size();
-			if (nprop_count) {
-				const NodeData::Property *nprops = &n.properties[0];
+		}
+	}
 
-				Dictionary missing_resource_properties;
-				HashMap<Ref<Resource>, Ref<Resource>> resources_local_to_sub_scene; // Record the mappings in the sub-scene.
+	if (node) {
+		if (i < ids.size()) {
+			node->set_unique_scene_id(ids[i]);
+		}
+		// may not have found the node (part of instantiated scene and removed)
+		// if found all is good, otherwise ignore
 
-				for (int j = 0; j < nprop_count; j++) {
-					bool valid;
+		//properties
+		int nprop_count = n.properties.size();
+		if (nprop_count) {
+			const NodeData::Property *nprops = &n.properties[0];
 
-					ERR_FAIL_INDEX_V(nprops[j].value, prop_count, nullptr);
+			Dictionary missing_resource_properties;
+			HashMap<Ref<Resource>, Ref<Resource>> resources_local_to_sub_scene; // Record the mappings in the sub-scene.
 
-					if (nprops[j].name & FLAG_PATH_PROPERTY_IS_NODE) {
-						if (!Engine::get_singleton()->is_editor_hint() && node->get_scene_instance_load_placeholder()) {
-							// We cannot know if the referenced nodes exist yet, so instead of deferring, we write the NodePaths directly.
+			for (int j = 0; j < nprop_count; j++) {
+				bool valid;
 
-							uint32_t name_idx = nprops[j].name & (FLAG_PATH_PROPERTY_IS_NODE - 1);
-							ERR_FAIL_UNSIGNED_INDEX_V(name_idx, (uint32_t)sname_count, nullptr);
+				ERR_FAIL_INDEX_V(nprops[j].value, prop_count, false);
 
-							node->set(snames[name_idx], props[nprops[j].value], &valid);
-							continue;
-						}
+				if (nprops[j].name & FLAG_PATH_PROPERTY_IS_NODE) {
+					if (!Engine::get_singleton()->is_editor_hint() && node->get_scene_instance_load_placeholder()) {
+						// We cannot know if the referenced nodes exist yet, so instead of deferring, we write the NodePaths directly.
 
 						uint32_t name_idx = nprops[j].name & (FLAG_PATH_PROPERTY_IS_NODE - 1);
-						ERR_FAIL_UNSIGNED_INDEX_V(name_idx, (uint32_t)sname_count, nullptr);
+						ERR_FAIL_UNSIGNED_INDEX_V(name_idx, (uint32_t)sname_count, false);
 
-						DeferredNodePathProperties dnp;
-						dnp.value = props[nprops[j].value];
-						dnp.base = node->get_instance_id();
-						dnp.property = snames[name_idx];
-						deferred_node_paths.push_back(dnp);
+						node->set(snames[name_idx], props[nprops[j].value], &valid);
 						continue;
 					}
 
-					ERR_FAIL_INDEX_V(nprops[j].name, sname_count, nullptr);
+					uint32_t name_idx = nprops[j].name & (FLAG_PATH_PROPERTY_IS_NODE - 1);
+					ERR_FAIL_UNSIGNED_INDEX_V(name_idx, (uint32_t)sname_count, false);
 
-					if (snames[nprops[j].name] == CoreStringName(script)) {
-						//work around to avoid old script variables from disappearing, should be the proper fix to:
-						//https://github.com/godotengine/godot/issues/2958
+					DeferredNodePathProperties dnp;
+					dnp.value = props[nprops[j].value];
+					dnp.base = node->get_instance_id();
+					dnp.property = snames[name_idx];
+					r_data.deferred_node_paths.push_back(dnp);
+					continue;
+				}
 
-						//store old state
-						List<Pair<StringName, Variant>> old_state;
-						if (node->get_script_instance()) {
-							node->get_script_instance()->get_property_state(old_state);
-						}
+				ERR_FAIL_INDEX_V(nprops[j].name, sname_count, false);
+
+				if (snames[nprops[j].name] == CoreStringName(script)) {
+					//work around to avoid old script variables from disappearing, should be the proper fix to:
+					//https://github.com/godotengine/godot/issues/2958
+
+					//store old state
+					List<Pair<StringName, Variant>> old_state;
+					if (node->get_script_instance()) {
+						node->get_script_instance()->get_property_state(old_state);
+					}
 
 #ifdef TOOLS_ENABLED
-						const Ref<Script> value_as_script = props[nprops[j].value];
-						// It is possible that the user changed an existing script to abstract after it was attached to a node.
-						// When this happens, the user needs to fix it. See https://github.com/godotengine/godot/issues/109171
-						if (value_as_script.is_valid() && value_as_script->is_abstract()) {
-							const String global_class_name = value_as_script->get_global_name();
-							if (global_class_name.is_empty()) {
-								ERR_PRINT("Node \"" + snames[n.name] + "\" previously had a script, but that script is now abstract. Please assign a different script (right-click -> Attach Script...) or change the node to a different type (right-click -> Change Type...) to fix this, then re-save the scene.");
-							} else {
-								ERR_PRINT("Node \"" + snames[n.name] + "\" previously had a class of type \"" + global_class_name + "\", but that class is now abstract. Please assign a different script (right-click -> Attach Script...) or change the node to a different type (right-click -> Change Type...) to fix this, then re-save the scene.");
-							}
-							callable_mp((Object *)node, &Object::remove_meta).call_deferred(SceneStringName(_custom_type_script));
+					const Ref<Script> value_as_script = props[nprops[j].value];
+					// It is possible that the user changed an existing script to abstract after it was attached to a node.
+					// When this happens, the user needs to fix it. See https://github.com/godotengine/godot/issues/109171
+					if (value_as_script.is_valid() && value_as_script->is_abstract()) {
+						const String global_class_name = value_as_script->get_global_name();
+						if (global_class_name.is_empty()) {
+							ERR_PRINT("Node \"" + snames[n.name] + "\" previously had a script, but that script is now abstract. Please assign a different script (right-click -> Attach Script...) or change the node to a different type (right-click -> Change Type...) to fix this, then re-save the scene.");
 						} else {
-							node->set_script(props[nprops[j].value]);
+							ERR_PRINT("Node \"" + snames[n.name] + "\" previously had a class of type \"" + global_class_name + "\", but that class is now abstract. Please assign a different script (right-click -> Attach Script...) or change the node to a different type (right-click -> Change Type...) to fix this, then re-save the scene.");
 						}
-#else
+						callable_mp((Object *)node, &Object::remove_meta).call_deferred(SceneStringName(_custom_type_script));
+					} else {
 						node->set_script(props[nprops[j].value]);
+					}
+#else
+					node->set_script(props[nprops[j].value]);
 #endif // TOOLS_ENABLED
 
-						//restore old state for new script, if exists
-						for (const Pair<StringName, Variant> &E : old_state) {
-							node->set(E.first, E.second);
+					//restore old state for new script, if exists
+					for (const Pair<StringName, Variant> &E : old_state) {
+						node->set(E.first, E.second);
+					}
+				} else {
+					Variant value = props[nprops[j].value];
+
+					if (value.get_type() == Variant::OBJECT) {
+						//handle resources that are local to scene by duplicating them if needed
+						Ref<Resource> res = value;
+						if (res.is_valid()) {
+							value = make_local_resource(value, n, resources_local_to_sub_scene, node, snames[nprops[j].name], r_data.resources_local_to_scene, i, ret_nodes, r_data.edit_state);
 						}
 					} else {
-						Variant value = props[nprops[j].value];
+						// Making sure that instances of inherited scenes don't share the same
+						// reference between them.
+						if (is_inherited_scene) {
+							value = value.duplicate(true);
+						}
+					}
 
-						if (value.get_type() == Variant::OBJECT) {
-							//handle resources that are local to scene by duplicating them if needed
-							Ref<Resource> res = value;
-							if (res.is_valid()) {
-								value = make_local_resource(value, n, resources_local_to_sub_scene, node, snames[nprops[j].name], resources_local_to_scene, i, ret_nodes, p_edit_state);
-							}
-						} else {
-							// Making sure that instances of inherited scenes don't share the same
-							// reference between them.
-							if (is_inherited_scene) {
-								value = value.duplicate(true);
+					if (value.get_type() == Variant::ARRAY) {
+						Array set_array = value;
+						bool is_get_valid = false;
+						Variant get_value = node->get(snames[nprops[j].name], &is_get_valid);
+
+						if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
+							Array get_array = get_value;
+							if (set_array.is_same_typed(get_array)) {
+								set_array = set_array.duplicate();
+							} else {
+								set_array = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
 							}
 						}
 
-						if (value.get_type() == Variant::ARRAY) {
-							Array set_array = value;
-							bool is_get_valid = false;
-							Variant get_value = node->get(snames[nprops[j].name], &is_get_valid);
-
-							if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
-								Array get_array = get_value;
-								if (set_array.is_same_typed(get_array)) {
-									set_array = set_array.duplicate();
-								} else {
-									set_array = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
-								}
-							}
+						value = setup_resources_in_array(set_array, n, resources_local_to_sub_scene, node, snames[nprops[j].name], r_data.resources_local_to_scene, i, ret_nodes, r_data.edit_state);
+					}
 
-							value = setup_resources_in_array(set_array, n, resources_local_to_sub_scene, node, snames[nprops[j].name], resources_local_to_scene, i, ret_nodes, p_edit_state);
-						}
+					if (value.get_type() == Variant::DICTIONARY) {
+						Dictionary set_dict = value;
+						bool is_get_valid = false;
+						Variant get_value = node->get(snames[nprops[j].name], &is_get_valid);
 
-						if (value.get_type() == Variant::DICTIONARY) {
-							Dictionary set_dict = value;
-							bool is_get_valid = false;
-							Variant get_value = node->get(snames[nprops[j].name], &is_get_valid);
-
-							if (is_get_valid && get_value.get_type() == Variant::DICTIONARY) {
-								Dictionary get_dict = get_value;
-								if (set_dict.is_same_typed(get_dict)) {
-									set_dict = set_dict.duplicate();
-								} else {
-									set_dict = Dictionary(set_dict, get_dict.get_typed_key_builtin(), get_dict.get_typed_key_class_name(), get_dict.get_typed_key_script(), get_dict.get_typed_value_builtin(), get_dict.get_typed_value_class_name(), get_dict.get_typed_value_script());
-								}
+						if (is_get_valid && get_value.get_type() == Variant::DICTIONARY) {
+							Dictionary get_dict = get_value;
+							if (set_dict.is_same_typed(get_dict)) {
+								set_dict = set_dict.duplicate();
+							} else {
+								set_dict = Dictionary(set_dict, get_dict.get_typed_key_builtin(), get_dict.get_typed_key_class_name(), get_dict.get_typed_key_script(), get_dict.get_typed_value_builtin(), get_dict.get_typed_value_class_name(), get_dict.get_typed_value_script());
 							}
+						}
 
-							value = setup_resources_in_dictionary(set_dict, n, resources_local_to_sub_scene, node, snames[nprops[j].name], resources_local_to_scene, i, ret_nodes, p_edit_state);
+						value = setup_resources_in_dictionary(set_dict, n, resources_local_to_sub_scene, node, snames[nprops[j].name], r_data.resources_local_to_scene, i, ret_nodes, r_data.edit_state);
+					}
+
+					bool set_valid = true;
+					if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled() && value.get_type() == Variant::OBJECT) {
+						Ref<MissingResource> mr = value;
+						if (mr.is_valid()) {
+							missing_resource_properties[snames[nprops[j].name]] = mr;
+							set_valid = false;
 						}
+					}
 
-						bool set_valid = true;
-						if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled() && value.get_type() == Variant::OBJECT) {
-							Ref<MissingResource> mr = value;
-							if (mr.is_valid()) {
-								missing_resource_properties[snames[nprops[j].name]] = mr;
-								set_valid = false;
+					if (set_valid) {
+						const PropertySetterPlan *setter = (node_plan && (uint32_t)j < node_plan->setters.size()) ? &node_plan->setters[j] : nullptr;
+						bool set_done = false;
+						if (setter && setter->method && !node->get_script_instance()) {
+							Callable::CallError ce;
+							// Same as what Object::set() ends up doing through ClassDB::set_property().
+							if (setter->index >= 0) {
+								const Variant index = setter->index;
+								const Variant *args[2] = { &index, &value };
+								setter->method->call(node, args, 2, ce);
+							} else {
+								const Variant *args[1] = { &value };
+								setter->method->call(node, args, 1, ce);
 							}
+							set_done = ce.error == Callable::CallError::CALL_OK;
 						}
-
-						if (set_valid) {
+						if (!set_done) {
+							// Arguments are checked before the setter runs, so a rejected call had no effect.
+							// Go through Object::set() for its validation, fallbacks and error reporting.
 							node->set(snames[nprops[j].name], value, &valid);
 						}
-						if (p_edit_state == GEN_EDIT_STATE_INSTANCE && value.get_type() != Variant::OBJECT) {
-							value = value.duplicate(true); // Duplicate arrays and dictionaries for the editor.
-						}
+					}
+					if (r_data.edit_state == GEN_EDIT_STATE_INSTANCE && value.get_type() != Variant::OBJECT) {
+						value = value.duplicate(true); // Duplicate arrays and dictionaries for the editor.
 					}
 				}
-				if (!missing_resource_properties.is_empty()) {
-					node->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
-				}
+			}
+			if (!missing_resource_properties.is_empty()) {
+				node->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
+			}
 
-				for (KeyValue<Ref<Resource>, Ref<Resource>> &E : resources_local_to_sub_scene) {
-					if (E.value->get_local_scene() == node) {
-						E.value->setup_local_to_scene(); // Setup may be required for the resource to work properly.
-					}
+			for (KeyValue<Ref<Resource>, Ref<Resource>> &E : resources_local_to_sub_scene) {
+				if (E.value->get_local_scene() == node) {
+					E.value->setup_local_to_scene(); // Setup may be required for the resource to work properly.
 				}
 			}
+		}
 
-			//name
+		//name
 
-			//groups
-			for (int j = 0; j < n.groups.size(); j++) {
-				ERR_FAIL_INDEX_V(n.groups[j], sname_count, nullptr);
-				node->add_to_group(snames[n.groups[j]], true);
-			}
+		//groups
+		for (int j = 0; j < n.groups.size(); j++) {
+			ERR_FAIL_INDEX_V(n.groups[j], sname_count, false);
+			node->add_to_group(snames[n.groups[j]], true);
+		}
 
-			if (n.instance >= 0 || n.type != TYPE_INSTANTIATED || i == 0) {
-				//if node was not part of instance, must set its name, parenthood and ownership
-				if (i > 0) {
-					if (parent) {
-						bool pending_add = true;
+		if (n.instance >= 0 || n.type != TYPE_INSTANTIATED || i == 0) {
+			//if node was not part of instance, must set its name, parenthood and ownership
+			if (i > 0) {
+				if (parent) {
+					bool pending_add = true;
 #ifdef TOOLS_ENABLED
-						if (Engine::get_singleton()->is_editor_hint()) {
-							Node *existing = parent->_get_child_by_name(snames[n.name]);
-							if (existing) {
-								// There's already a node in the same parent with the same name.
-								// This means that somehow the node was added both to the scene being
-								// loaded and another one instantiated in the former, maybe because of
-								// manual editing, or a bug in scene saving, or a loophole in the workflow
-								// (with any of the bugs possibly already fixed).
-								// Bring consistency back by letting it be assigned a non-clashing name.
-								// This simple workaround at least avoids leaks and helps the user realize
-								// something awkward has happened.
-								if (instantiation_warn_notify) {
-									instantiation_warn_notify(vformat(
-											TTR("An incoming node's name clashes with %s already in the scene (presumably, from a more nested instance).\nThe less nested node will be renamed. Please fix and re-save the scene."),
-											ret_nodes[0]->get_path_to(existing)));
-								}
-								node->set_name(snames[n.name]);
-								parent->add_child(node, true);
-								pending_add = false;
+					if (Engine::get_singleton()->is_editor_hint()) {
+						Node *existing = parent->_get_child_by_name(snames[n.name]);
+						if (existing) {
+							// There's already a node in the same parent with the same name.
+							// This means that somehow the node was added both to the scene being
+							// loaded and another one instantiated in the former, maybe because of
+							// manual editing, or a bug in scene saving, or a loophole in the workflow
+							// (with any of the bugs possibly already fixed).
+							// Bring consistency back by letting it be assigned a non-clashing name.
+							// This simple workaround at least avoids leaks and helps the user realize
+							// something awkward has happened.
+							if (instantiation_warn_notify) {
+								instantiation_warn_notify(vformat(
+										TTR("An incoming node's name clashes with %s already in the scene (presumably, from a more nested instance).\nThe less nested node will be renamed. Please fix and re-save the scene."),
+										ret_nodes[0]->get_path_to(existing)));
 							}
+							node->set_name(snames[n.name]);
+							parent->add_child(node, true);
+							pending_add = false;
 						}
+					}
 #endif
-						if (pending_add) {
-							parent->_add_child_nocheck(node, snames[n.name]);
-						}
-						if (n.index >= 0 && n.index < parent->get_child_count() - 1) {
-							parent->move_child(node, n.index);
-						}
-					} else {
-						//it may be possible that an instantiated scene has changed
-						//and the node has nowhere to go anymore
-						stray_instances.push_back(node); //can't be added, go to stray list
+					if (pending_add) {
+						parent->_add_child_nocheck(node, snames[n.name]);
 					}
-				} else {
-					if (Engine::get_singleton()->is_editor_hint()) {
-						//validate name if using editor, to avoid broken
-						node->set_name(snames[n.name]);
-					} else {
-						node->_set_name_nocheck(snames[n.name]);
+					if (n.index >= 0 && n.index < parent->get_child_count() - 1) {
+						parent->move_child(node, n.index);
 					}
+				} else {
+					//it may be possible that an instantiated scene has changed
+					//and the node has nowhere to go anymore
+					r_data.stray_instances.push_back(node); //can't be added, go to stray list
+				}
+			} else {
+				if (Engine::get_singleton()->is_editor_hint()) {
+					//validate name if using editor, to avoid broken
+					node->set_name(snames[n.name]);
+				} else {
+					node->_set_name_nocheck(snames[n.name]);
 				}
 			}
+		}
 
-			if (!old_parent_path.is_empty()) {
-				node->set_name(old_parent_path + "#" + node->get_name());
-			}
+		if (!old_parent_path.is_empty()) {
+			node->set_name(old_parent_path + "#" + node->get_name());
+		}
 
-			if (n.owner >= 0) {
-				NODE_FROM_ID(owner, n.owner);
-				if (owner) {
-					node->_set_owner_nocheck(owner);
-					if (node->data.unique_name_in_owner) {
-						node->_acquire_unique_name_in_owner();
-					}
+		if (n.owner >= 0) {
+			NODE_FROM_ID(owner, n.owner, false);
+			if (owner) {
+				node->_set_owner_nocheck(owner);
+				if (node->data.unique_name_in_owner) {
+					node->_acquire_unique_name_in_owner();
 				}
 			}
-
-			// We only want to deal with pinned flag if instantiating as pure main (no instance, no inheriting.)
-			if (p_edit_state == GEN_EDIT_STATE_MAIN) {
-				_sanitize_node_pinned_properties(node);
-			} else {
-				node->remove_meta("_edit_pinned_properties_");
-			}
 		}
 
-		if (missing_node) {
-			missing_node->set_recording_properties(false);
+		// We only want to deal with pinned flag if instantiating as pure main (no instance, no inheriting.)
+		if (r_data.edit_state == GEN_EDIT_STATE_MAIN) {
+			_sanitize_node_pinned_properties(node);
+		} else {
+			node->remove_meta("_edit_pinned_properties_");
 		}
+	}
+
+	if (missing_node) {
+		missing_node->set_recording_properties(false);
+	}
 
-		ret_nodes[i] = node;
+	ret_nodes[i] = node;
 
-		if (node && gen_node_path_cache && ret_nodes[0]) {
-			NodePath n2 = ret_nodes[0]->get_path_to(node);
-			node_path_cache[n2] = i;
-		}
+	if (node && r_data.gen_node_path_cache && ret_nodes[0]) {
+		NodePath n2 = ret_nodes[0]->get_path_to(node);
+		node_path_cache[n2] = i;
 	}
 
-	for (const DeferredNodePathProperties &dnp : deferred_node_paths) {
+	return true;
+}
+
+Node *SceneState::instantiate_end(InstantiationData &r_data) const {
+	int nc = nodes.size();
+	ERR_FAIL_COND_V(r_data.next_node != nc || (int)r_data.ret_nodes.size() != nc, nullptr);
+
+	const StringName *snames = names.ptr();
+	const Variant *props = variants.ptr();
+	Node **ret_nodes = r_data.ret_nodes.ptr();
+
+	for (const DeferredNodePathProperties &dnp : r_data.deferred_node_paths) {
 		// Replace properties stored as NodePaths with actual Nodes.
 		Node *base = ObjectDB::get_instance<Node>(dnp.base);
 		ERR_CONTINUE_EDMSG(!base, vformat("Failed to set deferred property '%s' as the base node disappeared.", dnp.property));
@@ -639,7 +708,7 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 		}
 	}
 
-	for (KeyValue<Ref<Resource>, Ref<Resource>> &E : resources_local_to_scene) {
+	for (KeyValue<Ref<Resource>, Ref<Resource>> &E : r_data.resources_local_to_scene) {
 		if (E.value->get_local_scene() == ret_nodes[0]) {
 			E.value->setup_local_to_scene();
 		}
@@ -655,8 +724,8 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 		//ERR_FAIL_INDEX_V( c.from, nc, nullptr );
 		//ERR_FAIL_INDEX_V( c.to, nc, nullptr );
 
-		NODE_FROM_ID(cfrom, c.from);
-		NODE_FROM_ID(cto, c.to);
+		NODE_FROM_ID(cfrom, c.from, nullptr);
+		NODE_FROM_ID(cto, c.to, nullptr);
 
 		if (!cfrom || !cto) {
 			continue;
@@ -681,15 +750,15 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 			callable = callable.unbind(c.unbinds);
 		}
 
-		cfrom->connect(snames[c.signal], callable, CONNECT_PERSIST | c.flags | (p_edit_state == GEN_EDIT_STATE_MAIN ? 0 : CONNECT_INHERITED));
+		cfrom->connect(snames[c.signal], callable, CONNECT_PERSIST | c.flags | (r_data.edit_state == GEN_EDIT_STATE_MAIN ? 0 : CONNECT_INHERITED));
 	}
 
 	//Node *s = ret_nodes[0];
 
 	//remove nodes that could not be added, likely as a result that
-	while (stray_instances.size()) {
-		memdelete(stray_instances.front()->get());
-		stray_instances.pop_front();
+	while (r_data.stray_instances.size()) {
+		memdelete(r_data.stray_instances.front()->get());
+		r_data.stray_instances.pop_front();
 	}
 
 	for (int i = 0; i < editable_instances.size(); i++) {
@@ -702,6 +771,39 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 	return ret_nodes[0];
 }
 
+void SceneState::instantiate_abort(InstantiationData &r_data) const {
+	// Every node created so far is either in the root's subtree or in the stray list.
+	if (r_data.next_node > 0 && r_data.ret_nodes.size() > 0 && r_data.ret_nodes[0]) {
+		memdelete(r_data.ret_nodes[0]);
+	}
+	while (r_data.stray_instances.size()) {
+		memdelete(r_data.stray_instances.front()->get());
+		r_data.stray_instances.pop_front();
+	}
+	r_data.ret_nodes.clear();
+	r_data.deferred_node_paths.clear();
+	r_data.resources_local_to_scene.clear();
+	r_data.next_node = 0;
+}
+
+#undef NODE_FROM_ID
+
+Node *SceneState::instantiate(GenEditState p_edit_state) const {
+	InstantiationData data;
+	if (!instantiate_begin(data, p_edit_state)) {
+		return nullptr;
+	}
+
+	int nc = nodes.size();
+	while (data.next_node < nc) {
+		if (!instantiate_step(data)) {
+			return nullptr;
+		}
+	}
+
+	return instantiate_end(data);
+}
+
 Variant SceneState::make_local_resource(Variant &p_value, const SceneState::NodeData &p_node_data, HashMap<Ref<Resource>, Ref<Resource>> &p_resources_local_to_sub_scene, Node *p_node, const StringName p_sname, HashMap<Ref<Resource>, Ref<Resource>> &p_resources_local_to_scene, int p_i, Node **p_ret_nodes, SceneState::GenEditState p_edit_state) const {
 	Ref<Resource> res = p_value;
 	if (res.is_null() || !res->is_local_to_scene()) {
@@ -1437,6 +1539,7 @@ String SceneState::get_path() const {
 }
 
 void SceneState::clear() {
+	_invalidate_instantiation_plan();
 	names.clear();
 	variants.clear();
 	nodes.clear();
@@ -1641,6 +1744,8 @@ void SceneState::set_bundled_scene(const Dictionary &p_dictionary) {
 
 	ERR_FAIL_COND_MSG(version > PACKED_SCENE_VERSION, "Save format version too new.");
 
+	_invalidate_instantiation_plan();
+
 	const int node_count = p_dictionary["node_count"];
 	const Vector<int> snodes = p_dictionary["nodes"];
 	ERR_FAIL_COND(snodes.size() < node_count);
@@ -2312,6 +2417,7 @@ void SceneState::add_node_property(int p_node, int p_name, int p_value, bool p_d
 	}
 	prop.value = p_value;
 	nodes.write[p_node].properties.push_back(prop);
+	_invalidate_instantiation_plan();
 }
 
 void SceneState::add_node_group(int p_node, int p_group) {
@@ -2366,6 +2472,7 @@ bool SceneState::rename_group_references(const StringName &p_old_name, const Str
 	for (const NodeData &node : nodes) {
 		for (const int &group : node.groups) {
 			if (names[group] == p_old_name) {
+				_invalidate_instantiation_plan();
 				names.write[group] = p_new_name;
 				edited = true;
 				break;
@@ -2486,17 +2593,38 @@ Node *PackedScene::instantiate(GenEditState p_edit_state) const {
 		return nullptr;
 	}
 
+	_setup_instance(s, p_edit_state);
+
+	return s;
+}
+
+void PackedScene::_setup_instance(Node *p_node, GenEditState p_edit_state) const {
 	if (p_edit_state != GEN_EDIT_STATE_DISABLED) {
-		s->set_scene_instance_state(state);
+		p_node->set_scene_instance_state(state);
 	}
 
 	if (!is_built_in()) {
-		s->set_scene_file_path(get_path());
+		p_node->set_scene_file_path(get_path());
 	}
 
-	s->notification(Node::NOTIFICATION_SCENE_INSTANTIATED);
+	p_node->notification(Node::NOTIFICATION_SCENE_INSTANTIATED);
+}
 
-	return s;
+Ref<PackedSceneInstantiation> PackedScene::instantiate_incremental(GenEditState p_edit_state) {
+#ifndef TOOLS_ENABLED
+	ERR_FAIL_COND_V_MSG(p_edit_state != GEN_EDIT_STATE_DISABLED, Ref<PackedSceneInstantiation>(), "Edit state is only for editors, does not work without tools compiled.");
+#endif
+
+	Ref<PackedSceneInstantiation> instantiation;
+	instantiation.instantiate();
+	instantiation->scene = Ref<PackedScene>(this);
+	instantiation->state = state; // Keep the state alive even if it gets replaced halfway through.
+	instantiation->edit_state = p_edit_state;
+	instantiation->node_count = state->get_node_count();
+	if (!state->instantiate_begin(instantiation->data, (SceneState::GenEditState)p_edit_state)) {
+		return Ref<PackedSceneInstantiation>();
+	}
+	return instantiation;
 }
 
 void PackedScene::replace_state(Ref<SceneState> p_by) {
@@ -2585,6 +2713,7 @@ void PackedScene::reset_state() {
 void PackedScene::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("pack", "path"), &PackedScene::pack);
 	ClassDB::bind_method(D_METHOD("instantiate", "edit_state"), &PackedScene::instantiate, DEFVAL(GEN_EDIT_STATE_DISABLED));
+	ClassDB::bind_method(D_METHOD("instantiate_incremental", "edit_state"), &PackedScene::instantiate_incremental, DEFVAL(GEN_EDIT_STATE_DISABLED));
 	ClassDB::bind_method(D_METHOD("can_instantiate"), &PackedScene::can_instantiate);
 	ClassDB::bind_method(D_METHOD("_set_bundled_scene", "scene"), &PackedScene::_set_bundled_scene);
 	ClassDB::bind_method(D_METHOD("_get_bundled_scene"), &PackedScene::_get_bundled_scene);
@@ -2601,3 +2730,52 @@ void PackedScene::_bind_methods() {
 PackedScene::PackedScene() {
 	state.instantiate();
 }
+
+bool PackedSceneInstantiation::step(int64_t p_time_budget_usec, int p_max_nodes) {
+	if (finished) {
+		return true;
+	}
+
+	// Always build at least one node, so every call makes progress.
+	const uint64_t deadline = OS::get_singleton()->get_ticks_usec() + MAX(p_time_budget_usec, 0);
+	const int last_node = p_max_nodes > 0 ? MIN(data.next_node + p_max_nodes, node_count) : node_count;
+	do {
+		if (!state->instantiate_step(data)) {
+			state->instantiate_abort(data);
+			finished = true;
+			ERR_FAIL_V_MSG(true, vformat("Failed to instantiate scene \"%s\".", scene->get_path()));
+		}
+	} while (data.next_node < last_node && OS::get_singleton()->get_ticks_usec() < deadline);
+
+	if (data.next_node == node_count) {
+		node = state->instantiate_end(data);
+		if (node) {
+			scene->_setup_instance(node, edit_state);
+		}
+		data = SceneState::InstantiationData();
+		finished = true;
+	}
+
+	return finished;
+}
+
+float PackedSceneInstantiation::get_progress() const {
+	if (finished || node_count == 0) {
+		return 1.0;
+	}
+	return float(data.next_node) / node_count;
+}
+
+void PackedSceneInstantiation::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("step", "time_budget_usec", "max_nodes"), &PackedSceneInstantiation::step, DEFVAL(0));
+	ClassDB::bind_method(D_METHOD("is_finished"), &PackedSceneInstantiation::is_finished);
+	ClassDB::bind_method(D_METHOD("get_progress"), &PackedSceneInstantiation::get_progress);
+	ClassDB::bind_method(D_METHOD("get_node"), &PackedSceneInstantiation::get_node);
+}
+
+PackedSceneInstantiation::~PackedSceneInstantiation() {
+	// A finished instance belongs to the caller, like with PackedScene::instantiate().
+	if (!finished && state.is_valid()) {
+		state->instantiate_abort(data);
+	}
+}
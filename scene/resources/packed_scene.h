@@ -90,6 +90,24 @@ class SceneState : public RefCounted {
 
 	Vector<ConnectionData> connections;
 
+	// Constructors and property setters resolved once, so that repeated instantiations skip the ClassDB lookups.
+	struct PropertySetterPlan {
+		MethodBind *method = nullptr; // When null, the property goes through Object::set().
+		int index = -1;
+	};
+
+	struct NodePlan {
+		Object *(*creation_func)(bool) = nullptr;
+		LocalVector<PropertySetterPlan> setters;
+	};
+
+	mutable Vector<NodePlan> instantiation_plan;
+	mutable bool instantiation_plan_valid = false;
+	mutable BinaryMutex instantiation_plan_mutex;
+
+	void _build_instantiation_plan() const;
+	void _invalidate_instantiation_plan();
+
 	Error _parse_node(Node *p_owner, Node *p_node, int p_parent_idx, HashMap<StringName, int> &name_map, HashMap<Variant, int> &variant_map, HashMap<Node *, int> &node_map, HashMap<Node *, int> &nodepath_map, HashSet<int32_t> &ids_saved);
 	Error _parse_connections(Node *p_owner, Node *p_node, HashMap<StringName, int> &name_map, HashMap<Variant, int> &variant_map, HashMap<Node *, int> &node_map, HashMap<Node *, int> &nodepath_map);
 
@@ -138,6 +156,19 @@ public:
 		int node = -1;
 	};
 
+	// Progress of an instantiation that is done one node at a time, see instantiate_step().
+	struct InstantiationData {
+		GenEditState edit_state = GEN_EDIT_STATE_DISABLED;
+		Vector<NodePlan> plan; // Shared with the state, so it outlives a rebuild of the state's plan.
+		int next_node = 0;
+		LocalVector<Node *> ret_nodes;
+		List<Node *> stray_instances; // Nodes where instantiation failed (because something is missing.)
+		HashMap<Ref<Resource>, Ref<Resource>> resources_local_to_scene;
+		LocalVector<DeferredNodePathProperties> deferred_node_paths;
+		bool gen_node_path_cache = false;
+		bool deep_search_warned = false;
+	};
+
 	static void set_disable_placeholders(bool p_disable);
 	static Ref<Resource> get_remap_resource(const Ref<Resource> &p_resource, HashMap<Ref<Resource>, Ref<Resource>> &remap_cache, const Ref<Resource> &p_fallback, Node *p_for_scene);
 
@@ -160,6 +191,11 @@ public:
 	bool can_instantiate() const;
 	Node *instantiate(GenEditState p_edit_state) const;
 
+	bool instantiate_begin(InstantiationData &r_data, GenEditState p_edit_state) const;
+	bool instantiate_step(InstantiationData &r_data) const;
+	Node *instantiate_end(InstantiationData &r_data) const;
+	void instantiate_abort(InstantiationData &r_data) const;
+
 	Array setup_resources_in_array(Array &array_to_scan, const SceneState::NodeData &n, HashMap<Ref<Resource>, Ref<Resource>> &resources_local_to_sub_scene, Node *node, const StringName sname, HashMap<Ref<Resource>, Ref<Resource>> &resources_local_to_scene, int i, Node **ret_nodes, SceneState::GenEditState p_edit_state) const;
 	Dictionary setup_resources_in_dictionary(Dictionary &p_dictionary_to_scan, const SceneState::NodeData &p_n, HashMap<Ref<Resource>, Ref<Resource>> &p_resources_local_to_sub_scene, Node *p_node, const StringName p_sname, HashMap<Ref<Resource>, Ref<Resource>> &p_resources_local_to_scene, int p_i, Node **p_ret_nodes, SceneState::GenEditState p_edit_state) const;
 	Variant make_local_resource(Variant &value, const SceneState::NodeData &p_node_data, HashMap<Ref<Resource>, Ref<Resource>> &p_resources_local_to_sub_scene, Node *p_node, const StringName p_sname, HashMap<Ref<Resource>, Ref<Resource>> &p_resources_local_to_scene, int p_i, Node **p_ret_nodes, SceneState::GenEditState p_edit_state) const;
@@ -241,10 +277,14 @@ public:
 
 VARIANT_ENUM_CAST(SceneState::GenEditState)
 
+class PackedSceneInstantiation;
+
 class PackedScene : public Resource {
 	GDCLASS(PackedScene, Resource);
 	RES_BASE_EXTENSION("scn");
 
+	friend class PackedSceneInstantiation;
+
 	Ref<SceneState> state;
 
 	void _set_bundled_scene(const Dictionary &p_scene);
@@ -263,12 +303,18 @@ public:
 		GEN_EDIT_STATE_MAIN_INHERITED,
 	};
 
+private:
+	void _setup_instance(Node *p_node, GenEditState p_edit_state) const;
+
+public:
 	Error pack(Node *p_scene);
 
 	void clear();
 
 	bool can_instantiate() const;
 	Node *instantiate(GenEditState p_edit_state = GEN_EDIT_STATE_DISABLED) const;
+	Ref<PackedSceneInstantiation> instantiate_incremental(GenEditState p_edit_state = GEN_EDIT_STATE_DISABLED);
+
 
 	void recreate_state();
 	void replace_state(Ref<SceneState> p_by);
@@ -292,3 +338,30 @@ public:
 };
 
 VARIANT_ENUM_CAST(PackedScene::GenEditState)
+
+// Builds the node tree of a PackedScene over several calls to step(), so large scenes
+// can be instantiated without stalling a single frame.
+class PackedSceneInstantiation : public RefCounted {
+	GDCLASS(PackedSceneInstantiation, RefCounted);
+
+	friend class PackedScene;
+
+	Ref<PackedScene> scene;
+	Ref<SceneState> state;
+	PackedScene::GenEditState edit_state = PackedScene::GEN_EDIT_STATE_DISABLED;
+	SceneState::InstantiationData data;
+	int node_count = 0;
+	Node *node = nullptr;
+	bool finished = false;
+
+protected:
+	static void _bind_methods();
+
+public:
+	bool step(int64_t p_time_budget_usec, int p_max_nodes = 0);
+	bool is_finished() const { return finished; }
+	float get_progress() const;
+	Node *get_node() const { return node; }
+
+	~PackedSceneInstantiation();
+};
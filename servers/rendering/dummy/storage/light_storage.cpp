@@ -47,7 +47,10 @@ LightStorage::~LightStorage() {
 }
 
 bool LightStorage::free(RID p_rid) {
-	if (owns_lightmap(p_rid)) {
+	if (owns_light(p_rid)) {
+		light_free(p_rid);
+		return true;
+	} else if (owns_lightmap(p_rid)) {
 		lightmap_free(p_rid);
 		return true;
 	} else if (owns_lightmap_instance(p_rid)) {
@@ -58,6 +61,213 @@ bool LightStorage::free(RID p_rid) {
 	return false;
 }
 
+/* LIGHT API */
+
+void LightStorage::_light_initialize(RID p_light, RS::LightType p_type) {
+	if (p_light.is_null()) {
+		return;
+	}
+
+	Light light;
+	light.type = p_type;
+
+	// Only the parameters used for culling matter here, match the defaults of the real renderers.
+	light.param[RS::LIGHT_PARAM_ENERGY] = 1.0;
+	light.param[RS::LIGHT_PARAM_RANGE] = 1.0;
+	light.param[RS::LIGHT_PARAM_SPOT_ANGLE] = 45;
+	light.param[RS::LIGHT_PARAM_SHADOW_MAX_DISTANCE] = 0;
+	light.param[RS::LIGHT_PARAM_SHADOW_SPLIT_1_OFFSET] = 0.1;
+	light.param[RS::LIGHT_PARAM_SHADOW_SPLIT_2_OFFSET] = 0.3;
+	light.param[RS::LIGHT_PARAM_SHADOW_SPLIT_3_OFFSET] = 0.6;
+	light.param[RS::LIGHT_PARAM_SHADOW_FADE_START] = 0.8;
+	light.param[RS::LIGHT_PARAM_SHADOW_PANCAKE_SIZE] = 20.0;
+
+	light_owner.initialize_rid(p_light, light);
+}
+
+Dependency *LightStorage::get_light_dependency(RID p_rid) const {
+	Light *light = light_owner.get_or_null(p_rid);
+	ERR_FAIL_NULL_V(light, nullptr);
+
+	return &light->dependency;
+}
+
+RID LightStorage::directional_light_allocate() {
+	return lights_enabled ? light_owner.allocate_rid() : RID();
+}
+
+void LightStorage::directional_light_initialize(RID p_rid) {
+	_light_initialize(p_rid, RS::LIGHT_DIRECTIONAL);
+}
+
+RID LightStorage::omni_light_allocate() {
+	return lights_enabled ? light_owner.allocate_rid() : RID();
+}
+
+void LightStorage::omni_light_initialize(RID p_rid) {
+	_light_initialize(p_rid, RS::LIGHT_OMNI);
+}
+
+RID LightStorage::spot_light_allocate() {
+	return lights_enabled ? light_owner.allocate_rid() : RID();
+}
+
+void LightStorage::spot_light_initialize(RID p_rid) {
+	_light_initialize(p_rid, RS::LIGHT_SPOT);
+}
+
+void LightStorage::light_free(RID p_rid) {
+	Light *light = light_owner.get_or_null(p_rid);
+	ERR_FAIL_NULL(light);
+
+	light->dependency.deleted_notify(p_rid);
+	light_owner.free(p_rid);
+}
+
+void LightStorage::light_set_param(RID p_light, RS::LightParam p_param, float p_value) {
+	Light *light = light_owner.get_or_null(p_light);
+	if (!light) {
+		return;
+	}
+	ERR_FAIL_INDEX(p_param, RS::LIGHT_PARAM_MAX);
+
+	if (light->param[p_param] == p_value) {
+		return;
+	}
+
+	light->param[p_param] = p_value;
+
+	if (p_param == RS::LIGHT_PARAM_RANGE || p_param == RS::LIGHT_PARAM_SPOT_ANGLE) {
+		light->dependency.changed_notify(Dependency::DEPENDENCY_CHANGED_LIGHT);
+	}
+}
+
+void LightStorage::light_set_shadow(RID p_light, bool p_enabled) {
+	Light *light = light_owner.get_or_null(p_light);
+	if (!light) {
+		return;
+	}
+
+	light->shadow = p_enabled;
+	light->dependency.changed_notify(Dependency::DEPENDENCY_CHANGED_LIGHT);
+}
+
+void LightStorage::light_set_cull_mask(RID p_light, uint32_t p_mask) {
+	Light *light = light_owner.get_or_null(p_light);
+	if (!light) {
+		return;
+	}
+
+	light->cull_mask = p_mask;
+	light->dependency.changed_notify(Dependency::DEPENDENCY_CHANGED_LIGHT);
+}
+
+void LightStorage::light_set_shadow_caster_mask(RID p_light, uint32_t p_caster_mask) {
+	Light *light = light_owner.get_or_null(p_light);
+	if (!light) {
+		return;
+	}
+
+	light->shadow_caster_mask = p_caster_mask;
+	light->dependency.changed_notify(Dependency::DEPENDENCY_CHANGED_LIGHT);
+}
+
+uint32_t LightStorage::light_get_shadow_caster_mask(RID p_light) const {
+	const Light *light = light_owner.get_or_null(p_light);
+	if (!light) {
+		return 0xFFFFFFFF;
+	}
+
+	return light->shadow_caster_mask;
+}
+
+void LightStorage::light_set_bake_mode(RID p_light, RS::LightBakeMode p_bake_mode) {
+	Light *light = light_owner.get_or_null(p_light);
+	if (!light) {
+		return;
+	}
+
+	light->bake_mode = p_bake_mode;
+	light->dependency.changed_notify(Dependency::DEPENDENCY_CHANGED_LIGHT);
+}
+
+bool LightStorage::light_has_shadow(RID p_light) const {
+	const Light *light = light_owner.get_or_null(p_light);
+	if (!light) {
+		return false;
+	}
+
+	return light->shadow;
+}
+
+RS::LightType LightStorage::light_get_type(RID p_light) const {
+	const Light *light = light_owner.get_or_null(p_light);
+	if (!light) {
+		return RS::LIGHT_OMNI;
+	}
+
+	return light->type;
+}
+
+AABB LightStorage::light_get_aabb(RID p_light) const {
+	const Light *light = light_owner.get_or_null(p_light);
+	if (!light) {
+		return AABB();
+	}
+
+	switch (light->type) {
+		case RS::LIGHT_SPOT: {
+			float len = light->param[RS::LIGHT_PARAM_RANGE];
+			float angle = Math::deg_to_rad(light->param[RS::LIGHT_PARAM_SPOT_ANGLE]);
+
+			if (angle > Math::PI * 0.5) {
+				// Light casts backwards as well.
+				return AABB(Vector3(-1, -1, -1) * len, Vector3(2, 2, 2) * len);
+			}
+
+			float size = Math::sin(angle) * len;
+			return AABB(Vector3(-size, -size, -len), Vector3(size * 2, size * 2, len));
+		};
+		case RS::LIGHT_OMNI: {
+			float r = light->param[RS::LIGHT_PARAM_RANGE];
+			return AABB(-Vector3(r, r, r), Vector3(r, r, r) * 2);
+		};
+		case RS::LIGHT_DIRECTIONAL: {
+			return AABB();
+		};
+	}
+
+	ERR_FAIL_V(AABB());
+}
+
+float LightStorage::light_get_param(RID p_light, RS::LightParam p_param) {
+	const Light *light = light_owner.get_or_null(p_light);
+	if (!light) {
+		return 0.0;
+	}
+	ERR_FAIL_INDEX_V(p_param, RS::LIGHT_PARAM_MAX, 0);
+
+	return light->param[p_param];
+}
+
+RS::LightBakeMode LightStorage::light_get_bake_mode(RID p_light) {
+	const Light *light = light_owner.get_or_null(p_light);
+	if (!light) {
+		return RS::LIGHT_BAKE_DISABLED;
+	}
+
+	return light->bake_mode;
+}
+
+uint32_t LightStorage::light_get_cull_mask(RID p_light) const {
+	const Light *light = light_owner.get_or_null(p_light);
+	if (!light) {
+		return 0;
+	}
+
+	return light->cull_mask;
+}
+
 /* LIGHTMAP API */
 
 RID LightStorage::lightmap_allocate() {
@@ -84,3 +294,15 @@ RID LightStorage::lightmap_instance_create(RID p_lightmap) {
 void LightStorage::lightmap_instance_free(RID p_lightmap) {
 	lightmap_instance_owner.free(p_lightmap);
 }
+
+/* SHADOW ATLAS API */
+
+RID LightStorage::shadow_atlas_create() {
+	return lights_enabled ? shadow_atlas_owner.make_rid(ShadowAtlas()) : RID();
+}
+
+void LightStorage::shadow_atlas_free(RID p_atlas) {
+	if (shadow_atlas_owner.owns(p_atlas)) {
+		shadow_atlas_owner.free(p_atlas);
+	}
+}
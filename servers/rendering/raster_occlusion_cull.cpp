@@ -0,0 +1,512 @@
+/**************************************************************************/
+/*  raster_occlusion_cull.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "raster_occlusion_cull.h"
+
+#include "core/object/worker_thread_pool.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RASTER_OCCLUSION_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define RASTER_OCCLUSION_NEON
+#include <arm_neon.h>
+#endif
+
+// Rows rasterized by each thread, at least.
+static const int RASTER_BAND_MIN_ROWS = 16;
+
+void RasterOcclusionCull::RasterHZBuffer::clear() {
+	HZBuffer::clear();
+
+	raster_depth.clear();
+	distance_scale.clear();
+	triangles.clear();
+	view_vertices.clear();
+}
+
+void RasterOcclusionCull::RasterHZBuffer::resize(const Size2i &p_size) {
+	if (p_size == Size2i()) {
+		clear();
+		return;
+	}
+
+	if (!sizes.is_empty() && p_size == sizes[0]) {
+		return; // Size didn't change
+	}
+
+	HZBuffer::resize(p_size);
+
+	raster_depth.resize(p_size.x * p_size.y);
+	distance_scale.clear(); // Recomputed on next update.
+}
+
+void RasterOcclusionCull::RasterHZBuffer::begin(const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	view_transform = p_cam_transform.affine_inverse();
+	projection = p_cam_projection;
+	orthogonal = p_cam_orthogonal;
+	z_near = p_cam_projection.get_z_near();
+	z_far = p_cam_projection.get_z_far() * 1.05f;
+	debug_tex_range = z_far;
+
+	triangles.clear();
+
+	if (!orthogonal && (distance_scale.size() != raster_depth.size() || distance_scale_projection != projection)) {
+		_update_distance_scale();
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_update_distance_scale() {
+	const Size2i &buffer_size = sizes[0];
+	distance_scale.resize(buffer_size.x * buffer_size.y);
+	distance_scale_projection = projection;
+
+	Projection inv_projection = projection.inverse();
+	for (int y = 0; y < buffer_size.y; y++) {
+		for (int x = 0; x < buffer_size.x; x++) {
+			// Point on the near plane seen through the pixel center.
+			Vector3 ndc = Vector3((x + 0.5f) / buffer_size.x * 2.0f - 1.0f, (y + 0.5f) / buffer_size.y * 2.0f - 1.0f, -1.0f);
+			Vector3 view = inv_projection.xform(ndc);
+			distance_scale[y * buffer_size.x + x] = view.z < 0.0f ? view.length() / -view.z : 1.0f;
+		}
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::add_occluder(const Vector3 *p_vertices, uint32_t p_vertex_count, const uint32_t *p_indices, uint32_t p_index_count) {
+	view_vertices.resize(p_vertex_count);
+	for (uint32_t i = 0; i < p_vertex_count; i++) {
+		view_vertices[i] = view_transform.xform(p_vertices[i]);
+	}
+
+	for (uint32_t i = 0; i + 2 < p_index_count; i += 3) {
+		ERR_CONTINUE(p_indices[i] >= p_vertex_count || p_indices[i + 1] >= p_vertex_count || p_indices[i + 2] >= p_vertex_count);
+		const Vector3 *tri[3] = { &view_vertices[p_indices[i]], &view_vertices[p_indices[i + 1]], &view_vertices[p_indices[i + 2]] };
+
+		int in_front = 0;
+		for (int j = 0; j < 3; j++) {
+			if (-tri[j]->z >= z_near) {
+				in_front++;
+			}
+		}
+
+		if (in_front == 0) {
+			continue;
+		}
+
+		if (in_front == 3) {
+			_add_triangle(*tri[0], *tri[1], *tri[2]);
+			continue;
+		}
+
+		// Clip against the near plane, which results in one or two triangles.
+		Vector3 clipped[4];
+		int clipped_count = 0;
+		for (int j = 0; j < 3; j++) {
+			const Vector3 &a = *tri[j];
+			const Vector3 &b = *tri[(j + 1) % 3];
+			bool a_in = -a.z >= z_near;
+			bool b_in = -b.z >= z_near;
+			if (a_in) {
+				clipped[clipped_count++] = a;
+			}
+			if (a_in != b_in) {
+				real_t t = (-z_near - a.z) / (b.z - a.z);
+				clipped[clipped_count++] = a.lerp(b, t);
+			}
+		}
+
+		for (int j = 2; j < clipped_count; j++) {
+			_add_triangle(clipped[0], clipped[j - 1], clipped[j]);
+		}
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_add_triangle(const Vector3 &p_a, const Vector3 &p_b, const Vector3 &p_c) {
+	const Size2i &buffer_size = sizes[0];
+	const Vector3 *view[3] = { &p_a, &p_b, &p_c };
+
+	// Buffer coordinates, with pixel centers at integer positions.
+	float x[3];
+	float y[3];
+	float depth[3];
+	for (int i = 0; i < 3; i++) {
+		Vector3 ndc = projection.xform(*view[i]);
+		x[i] = (ndc.x * 0.5f + 0.5f) * buffer_size.x - 0.5f;
+		y[i] = (ndc.y * 0.5f + 0.5f) * buffer_size.y - 0.5f;
+		depth[i] = orthogonal ? view[i]->z : -1.0f / view[i]->z;
+	}
+
+	float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+	if (Math::abs(area) < CMP_EPSILON) {
+		return;
+	}
+
+	if (area < 0.0f) {
+		// Occluders are double sided, make the winding counter-clockwise so the inside is positive.
+		SWAP(x[1], x[2]);
+		SWAP(y[1], y[2]);
+		SWAP(depth[1], depth[2]);
+		area = -area;
+	}
+
+	// Clamp before converting, vertices close to the near plane can project very far away.
+	Triangle triangle;
+	triangle.min_x = (int)Math::ceil(CLAMP(MIN(x[0], MIN(x[1], x[2])), 0.0f, (float)buffer_size.x));
+	triangle.max_x = (int)Math::floor(CLAMP(MAX(x[0], MAX(x[1], x[2])), -1.0f, (float)(buffer_size.x - 1)));
+	triangle.min_y = (int)Math::ceil(CLAMP(MIN(y[0], MIN(y[1], y[2])), 0.0f, (float)buffer_size.y));
+	triangle.max_y = (int)Math::floor(CLAMP(MAX(y[0], MAX(y[1], y[2])), -1.0f, (float)(buffer_size.y - 1)));
+
+	if (triangle.min_x > triangle.max_x || triangle.min_y > triangle.max_y) {
+		return;
+	}
+
+	for (int i = 0; i < 3; i++) {
+		int j = (i + 1) % 3;
+		triangle.edge_a[i] = y[i] - y[j];
+		triangle.edge_b[i] = x[j] - x[i];
+		triangle.edge_c[i] = -(triangle.edge_a[i] * x[i] + triangle.edge_b[i] * y[i]);
+	}
+
+	float dx1 = x[1] - x[0];
+	float dy1 = y[1] - y[0];
+	float dx2 = x[2] - x[0];
+	float dy2 = y[2] - y[0];
+	float dd1 = depth[1] - depth[0];
+	float dd2 = depth[2] - depth[0];
+	triangle.depth_a = (dd1 * dy2 - dd2 * dy1) / area;
+	triangle.depth_b = (dx1 * dd2 - dx2 * dd1) / area;
+	triangle.depth_c = depth[0] - triangle.depth_a * x[0] - triangle.depth_b * y[0];
+
+	triangles.push_back(triangle);
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_rasterize_band(uint32_t p_band, const RasterThreadData *p_data) {
+	int height = sizes[0].y;
+	int from = p_band * height / p_data->band_count;
+	int to = (p_band + 1 == p_data->band_count) ? height : ((p_band + 1) * height / p_data->band_count);
+	_rasterize_rows(from, to);
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_rasterize_rows(int p_from, int p_to) {
+	const int width = sizes[0].x;
+	const float clear_depth = -FLT_MAX;
+
+	for (int i = p_from * width; i < p_to * width; i++) {
+		raster_depth[i] = clear_depth;
+	}
+
+	for (const Triangle &triangle : triangles) {
+		int min_y = MAX(triangle.min_y, p_from);
+		int max_y = MIN(triangle.max_y, p_to - 1);
+
+		for (int y = min_y; y <= max_y; y++) {
+			float *row = &raster_depth[y * width];
+			float fy = y;
+			float row_c0 = triangle.edge_b[0] * fy + triangle.edge_c[0];
+			float row_c1 = triangle.edge_b[1] * fy + triangle.edge_c[1];
+			float row_c2 = triangle.edge_b[2] * fy + triangle.edge_c[2];
+			float row_depth = triangle.depth_b * fy + triangle.depth_c;
+
+			int x = triangle.min_x;
+
+			// Four pixels at a time, keeping the closest depth where the pixel center is covered.
+#if defined(RASTER_OCCLUSION_SSE2)
+			const __m128 lanes = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 a0 = _mm_set1_ps(triangle.edge_a[0]);
+			const __m128 a1 = _mm_set1_ps(triangle.edge_a[1]);
+			const __m128 a2 = _mm_set1_ps(triangle.edge_a[2]);
+			const __m128 ad = _mm_set1_ps(triangle.depth_a);
+			const __m128 c0 = _mm_set1_ps(row_c0);
+			const __m128 c1 = _mm_set1_ps(row_c1);
+			const __m128 c2 = _mm_set1_ps(row_c2);
+			const __m128 cd = _mm_set1_ps(row_depth);
+
+			for (; x + 3 <= triangle.max_x; x += 4) {
+				__m128 fx = _mm_add_ps(_mm_set1_ps((float)x), lanes);
+				__m128 inside = _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a0, fx), c0), zero);
+				inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a1, fx), c1), zero));
+				inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a2, fx), c2), zero));
+				if (_mm_movemask_ps(inside) == 0) {
+					continue;
+				}
+
+				__m128 current = _mm_loadu_ps(row + x);
+				__m128 closest = _mm_max_ps(current, _mm_add_ps(_mm_mul_ps(ad, fx), cd));
+				_mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, closest), _mm_andnot_ps(inside, current)));
+			}
+#elif defined(RASTER_OCCLUSION_NEON)
+			const float lanes_data[4] = { 0.0f, 1.0f, 2.0f, 3.0f };
+			const float32x4_t lanes = vld1q_f32(lanes_data);
+			const float32x4_t zero = vdupq_n_f32(0.0f);
+			const float32x4_t a0 = vdupq_n_f32(triangle.edge_a[0]);
+			const float32x4_t a1 = vdupq_n_f32(triangle.edge_a[1]);
+			const float32x4_t a2 = vdupq_n_f32(triangle.edge_a[2]);
+			const float32x4_t ad = vdupq_n_f32(triangle.depth_a);
+			const float32x4_t c0 = vdupq_n_f32(row_c0);
+			const float32x4_t c1 = vdupq_n_f32(row_c1);
+			const float32x4_t c2 = vdupq_n_f32(row_c2);
+			const float32x4_t cd = vdupq_n_f32(row_depth);
+
+			for (; x + 3 <= triangle.max_x; x += 4) {
+				float32x4_t fx = vaddq_f32(vdupq_n_f32((float)x), lanes);
+				uint32x4_t inside = vcgeq_f32(vmlaq_f32(c0, a0, fx), zero);
+				inside = vandq_u32(inside, vcgeq_f32(vmlaq_f32(c1, a1, fx), zero));
+				inside = vandq_u32(inside, vcgeq_f32(vmlaq_f32(c2, a2, fx), zero));
+				if (vmaxvq_u32(inside) == 0) {
+					continue;
+				}
+
+				float32x4_t current = vld1q_f32(row + x);
+				float32x4_t closest = vmaxq_f32(current, vmlaq_f32(cd, ad, fx));
+				vst1q_f32(row + x, vbslq_f32(inside, closest, current));
+			}
+#endif
+
+			for (; x <= triangle.max_x; x++) {
+				float fx = x;
+				if (triangle.edge_a[0] * fx + row_c0 >= 0.0f && triangle.edge_a[1] * fx + row_c1 >= 0.0f && triangle.edge_a[2] * fx + row_c2 >= 0.0f) {
+					row[x] = MAX(row[x], triangle.depth_a * fx + row_depth);
+				}
+			}
+		}
+	}
+
+	// Resolve to distances from the camera, as expected by the occlusion tests.
+	float *distances = mips[0];
+	for (int i = p_from * width; i < p_to * width; i++) {
+		float depth = raster_depth[i];
+		float distance;
+		if (depth == clear_depth) {
+			distance = z_far;
+		} else if (orthogonal) {
+			distance = -depth;
+		} else {
+			distance = depth > 0.0f ? distance_scale[i] / depth : z_far;
+		}
+		distances[i] = MIN(distance, z_far);
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::end() {
+	const int height = sizes[0].y;
+
+	RasterThreadData td;
+	td.band_count = MAX(1, MIN((int)WorkerThreadPool::get_singleton()->get_thread_count(), height / RASTER_BAND_MIN_ROWS));
+
+	if (td.band_count > 1 && !triangles.is_empty()) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterHZBuffer::_rasterize_band, &td, td.band_count, -1, true, SNAME("RasterOcclusionCullRasterize"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		_rasterize_rows(0, height);
+	}
+
+	update_mips();
+}
+
+////////////////////////////////////////////////////////
+
+bool RasterOcclusionCull::is_occluder(RID p_rid) {
+	return occluder_owner.owns(p_rid);
+}
+
+RID RasterOcclusionCull::occluder_allocate() {
+	return occluder_owner.allocate_rid();
+}
+
+void RasterOcclusionCull::occluder_initialize(RID p_occluder) {
+	Occluder *occluder = memnew(Occluder);
+	occluder_owner.initialize_rid(p_occluder, occluder);
+}
+
+void RasterOcclusionCull::occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+
+	occluder->vertices = p_vertices;
+	occluder->indices = p_indices;
+	occluder->version++;
+}
+
+void RasterOcclusionCull::free_occluder(RID p_occluder) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+	memdelete(occluder);
+	occluder_owner.free(p_occluder);
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_scenario(RID p_scenario) {
+	ERR_FAIL_COND(scenarios.has(p_scenario));
+	scenarios[p_scenario] = Scenario();
+}
+
+void RasterOcclusionCull::remove_scenario(RID p_scenario) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	scenarios.erase(p_scenario);
+}
+
+void RasterOcclusionCull::scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) {
+	Scenario *scenario = scenarios.getptr(p_scenario);
+	ERR_FAIL_NULL(scenario);
+
+	OccluderInstance &instance = scenario->instances[p_instance];
+
+	if (instance.occluder != p_occluder || instance.xform != p_xform) {
+		instance.occluder = p_occluder;
+		instance.xform = p_xform;
+		instance.dirty = true;
+	}
+
+	instance.enabled = p_enabled;
+}
+
+void RasterOcclusionCull::scenario_remove_instance(RID p_scenario, RID p_instance) {
+	Scenario *scenario = scenarios.getptr(p_scenario);
+	ERR_FAIL_NULL(scenario);
+	scenario->instances.erase(p_instance);
+}
+
+void RasterOcclusionCull::_update_instance(OccluderInstance &p_instance, const Occluder *p_occluder) {
+	int vertex_count = p_occluder->vertices.size();
+	const Vector3 *read = p_occluder->vertices.ptr();
+
+	p_instance.vertices.resize(vertex_count);
+	for (int i = 0; i < vertex_count; i++) {
+		p_instance.vertices[i] = p_instance.xform.xform(read[i]);
+		if (i == 0) {
+			p_instance.aabb = AABB(p_instance.vertices[i], Vector3());
+		} else {
+			p_instance.aabb.expand_to(p_instance.vertices[i]);
+		}
+	}
+
+	p_instance.indices.resize(p_occluder->indices.size());
+	if (p_occluder->indices.size()) {
+		memcpy(p_instance.indices.ptr(), p_occluder->indices.ptr(), p_occluder->indices.size() * sizeof(int32_t));
+	}
+
+	p_instance.occluder_version = p_occluder->version;
+	p_instance.dirty = false;
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_buffer(RID p_buffer) {
+	ERR_FAIL_COND(buffers.has(p_buffer));
+	buffers[p_buffer] = RasterHZBuffer();
+}
+
+void RasterOcclusionCull::remove_buffer(RID p_buffer) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers.erase(p_buffer);
+}
+
+void RasterOcclusionCull::buffer_set_scenario(RID p_buffer, RID p_scenario) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	ERR_FAIL_COND(p_scenario.is_valid() && !scenarios.has(p_scenario));
+	buffers[p_buffer].scenario_rid = p_scenario;
+}
+
+void RasterOcclusionCull::buffer_set_size(RID p_buffer, const Vector2i &p_size) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers[p_buffer].resize(p_size);
+}
+
+void RasterOcclusionCull::buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	RasterHZBuffer *buffer = buffers.getptr(p_buffer);
+	if (!buffer || buffer->is_empty()) {
+		return;
+	}
+
+	Scenario *scenario = scenarios.getptr(buffer->scenario_rid);
+	if (!scenario) {
+		return;
+	}
+
+	Vector<Plane> planes = p_cam_projection.get_projection_planes(p_cam_transform);
+
+	buffer->begin(p_cam_transform, p_cam_projection, p_cam_orthogonal);
+
+	for (KeyValue<RID, OccluderInstance> &E : scenario->instances) {
+		OccluderInstance &instance = E.value;
+		if (!instance.enabled) {
+			continue;
+		}
+
+		const Occluder *occluder = occluder_owner.get_or_null(instance.occluder);
+		if (!occluder) {
+			continue;
+		}
+
+		if (instance.dirty || instance.occluder_version != occluder->version) {
+			_update_instance(instance, occluder);
+		}
+
+		if (instance.vertices.is_empty()) {
+			continue;
+		}
+
+		// Skip occluders fully outside of the view frustum.
+		bool outside = false;
+		for (const Plane &plane : planes) {
+			Vector3 closest = instance.aabb.position + Vector3(plane.normal.x < 0 ? instance.aabb.size.x : 0, plane.normal.y < 0 ? instance.aabb.size.y : 0, plane.normal.z < 0 ? instance.aabb.size.z : 0);
+			if (plane.distance_to(closest) > 0) {
+				outside = true;
+				break;
+			}
+		}
+
+		if (outside) {
+			continue;
+		}
+
+		buffer->add_occluder(instance.vertices.ptr(), instance.vertices.size(), instance.indices.ptr(), instance.indices.size());
+	}
+
+	buffer->end();
+}
+
+RasterOcclusionCull::HZBuffer *RasterOcclusionCull::buffer_get_ptr(RID p_buffer) {
+	return buffers.getptr(p_buffer);
+}
+
+RID RasterOcclusionCull::buffer_get_debug_texture(RID p_buffer) {
+	ERR_FAIL_COND_V(!buffers.has(p_buffer), RID());
+	return buffers[p_buffer].get_debug_texture();
+}
+
+RasterOcclusionCull::~RasterOcclusionCull() {
+	LocalVector<RID> occluders = occluder_owner.get_owned_list();
+	for (const RID &occluder : occluders) {
+		free_occluder(occluder);
+	}
+}
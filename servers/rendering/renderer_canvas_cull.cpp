@@ -46,6 +46,12 @@ const static float FEATHER_SIZE = 1.25f;
 
 static RendererCanvasCull *_canvas_cull_singleton = nullptr;
 
+// Items with fewer children than this are culled child by child.
+static const int CHILD_INDEX_MIN_CHILDREN = 64;
+static const int CHILD_INDEX_MAX_DIMENSION = 256;
+// Children spanning more cells than this are always visited instead.
+static const int CHILD_INDEX_MAX_CELLS_PER_CHILD = 16;
+
 void RendererCanvasCull::_dependency_changed(Dependency::DependencyChangedNotification p_notification, DependencyTracker *p_tracker) {
 	Item *item = (Item *)p_tracker->userdata;
 
@@ -67,9 +73,7 @@ void RendererCanvasCull::_dependency_deleted(const RID &p_dependency, Dependency
 	_canvas_cull_singleton->_item_queue_update(item, true);
 }
 
-void RendererCanvasCull::_render_canvas_item_tree(RID p_to_render_target, Canvas::ChildItem *p_child_items, int p_child_item_count, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, RenderingServer::CanvasItemTextureFilter p_default_filter, RenderingServer::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_vertices_to_pixel, uint32_t p_canvas_cull_mask, RenderingMethod::RenderInfo *r_render_info) {
-	RENDER_TIMESTAMP("Cull CanvasItem Tree");
-
+RendererCanvasRender::Item *RendererCanvasCull::_cull_canvas_item_tree(Canvas::ChildItem *p_child_items, int p_child_item_count, const Transform2D &p_transform, const Rect2 &p_clip_rect, uint32_t p_canvas_cull_mask) {
 	// This is used to avoid passing the camera transform down the rendering
 	// function calls, as it won't be used in 99% of cases, because the camera
 	// transform is normally concatenated with the item global transform.
@@ -98,6 +102,14 @@ void RendererCanvasCull::_render_canvas_item_tree(RID p_to_render_target, Canvas
 		}
 	}
 
+	return list;
+}
+
+void RendererCanvasCull::_render_canvas_item_tree(RID p_to_render_target, Canvas::ChildItem *p_child_items, int p_child_item_count, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, RenderingServer::CanvasItemTextureFilter p_default_filter, RenderingServer::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_vertices_to_pixel, uint32_t p_canvas_cull_mask, RenderingMethod::RenderInfo *r_render_info) {
+	RENDER_TIMESTAMP("Cull CanvasItem Tree");
+
+	RendererCanvasRender::Item *list = _cull_canvas_item_tree(p_child_items, p_child_item_count, p_transform, p_clip_rect, p_canvas_cull_mask);
+
 	RENDER_TIMESTAMP("Render CanvasItems");
 
 	bool sdf_flag;
@@ -188,6 +200,195 @@ void RendererCanvasCull::_mark_ysort_dirty(RendererCanvasCull::Item *ysort_owner
 	} while (ysort_owner && ysort_owner->sort_y);
 }
 
+void RendererCanvasCull::_mark_subtree_rect_dirty(Item *p_item) {
+	while (p_item && !p_item->subtree_rect_dirty) {
+		p_item->subtree_rect_dirty = true;
+		p_item = _canvas_cull_singleton->canvas_item_owner.owns(p_item->parent) ? _canvas_cull_singleton->canvas_item_owner.get_or_null(p_item->parent) : nullptr;
+	}
+}
+
+void RendererCanvasCull::_mark_parent_subtree_rect_dirty(Item *p_item) {
+	if (canvas_item_owner.owns(p_item->parent)) {
+		_mark_subtree_rect_dirty(canvas_item_owner.get_or_null(p_item->parent));
+	}
+}
+
+void RendererCanvasCull::_update_subtree_rect(Item *p_item) {
+	if (!p_item->subtree_rect_dirty) {
+		return;
+	}
+
+	if (p_item->children_order_dirty) {
+		p_item->child_items.sort_custom<ItemIndexSort>();
+		p_item->children_order_dirty = false;
+	}
+
+	// Anything that draws relative to something other than its own rect makes the subtree unsafe to cull.
+	bool cullable = p_item->copy_back_buffer == nullptr && p_item->vp_render == nullptr && p_item->canvas_group == nullptr && !p_item->repeat_source && !p_item->use_identity_transform && !p_item->update_when_visible && p_item->skeleton.is_null();
+	bool empty = p_item->commands == nullptr && p_item->visibility_notifier == nullptr;
+	int depth = 0;
+
+	// Same rect as used by _cull_canvas_item().
+	Rect2 rect = p_item->get_rect();
+	if (p_item->visibility_notifier) {
+		if (p_item->visibility_notifier->area.size != Vector2()) {
+			rect = rect.merge(p_item->visibility_notifier->area);
+		}
+	}
+
+	int child_item_count = p_item->child_items.size();
+	Item **child_items = p_item->child_items.ptrw();
+	for (int i = 0; i < child_item_count; i++) {
+		Item *child = child_items[i];
+		_update_subtree_rect(child);
+
+		// Children being interpolated are drawn in between two transforms.
+		if (!child->subtree_cullable || (child->interpolated && child->on_interpolate_transform_list)) {
+			cullable = false;
+		}
+		if (child->subtree_empty) {
+			continue;
+		}
+
+		// Grow by a pixel to account for snapping of the child's transform.
+		Rect2 child_rect = child->xform_curr.xform(child->subtree_rect).grow(1);
+		rect = empty ? child_rect : rect.merge(child_rect);
+		empty = false;
+		depth = MAX(depth, child->subtree_depth + 1);
+	}
+
+	p_item->subtree_rect = rect;
+	p_item->subtree_depth = depth;
+	p_item->subtree_empty = empty;
+	p_item->subtree_cullable = cullable;
+	p_item->subtree_rect_dirty = false;
+
+	// The children are indexed once their bounds stop changing, see _cull_canvas_item().
+	p_item->subtree_rect_frame = RSG::rasterizer->get_frame_number();
+	if (p_item->child_index) {
+		memdelete(p_item->child_index);
+		p_item->child_index = nullptr;
+	}
+	p_item->child_index_pending = child_item_count >= CHILD_INDEX_MIN_CHILDREN && !p_item->sort_y && p_item->canvas_group == nullptr;
+}
+
+void RendererCanvasCull::_build_child_index(Item *p_item) {
+	int child_item_count = p_item->child_items.size();
+	Item **child_items = p_item->child_items.ptrw();
+
+	Item::ChildIndex *index = memnew(Item::ChildIndex);
+	LocalVector<Rect2> child_rects;
+	LocalVector<uint32_t> bounded_children;
+	child_rects.resize(child_item_count);
+
+	for (int i = 0; i < child_item_count; i++) {
+		Item *child = child_items[i];
+		if (!child->subtree_cullable || (child->interpolated && child->on_interpolate_transform_list)) {
+			index->unbounded_children.push_back(i);
+			continue;
+		}
+		if (child->subtree_empty) {
+			// Draws nothing, never needs to be visited.
+			continue;
+		}
+		child_rects[i] = child->xform_curr.xform(child->subtree_rect).grow(1);
+		index->bounds = bounded_children.is_empty() ? child_rects[i] : index->bounds.merge(child_rects[i]);
+		bounded_children.push_back(i);
+	}
+
+	if (bounded_children.size() < CHILD_INDEX_MIN_CHILDREN) {
+		memdelete(index);
+		return;
+	}
+
+	// Aim for a handful of children per cell.
+	const Size2 size = index->bounds.size;
+	const real_t cell_count = bounded_children.size() / 4.0;
+	const real_t aspect = size.y > CMP_EPSILON ? size.x / size.y : 1.0;
+	index->width = CLAMP((int)Math::sqrt(cell_count * aspect), 1, CHILD_INDEX_MAX_DIMENSION);
+	index->height = CLAMP((int)(cell_count / index->width), 1, CHILD_INDEX_MAX_DIMENSION);
+	index->cells_per_unit = Vector2(size.x > CMP_EPSILON ? index->width / size.x : 0, size.y > CMP_EPSILON ? index->height / size.y : 0);
+
+	// Count the children of each cell, then fill them in.
+	index->cell_offsets.resize(index->width * index->height + 1);
+	memset(index->cell_offsets.ptr(), 0, index->cell_offsets.size() * sizeof(uint32_t));
+
+	for (uint32_t i = 0; i < bounded_children.size(); i++) {
+		int from_x, from_y, to_x, to_y;
+		index->get_cell_range(child_rects[bounded_children[i]], from_x, from_y, to_x, to_y);
+		if ((to_x - from_x + 1) * (to_y - from_y + 1) > CHILD_INDEX_MAX_CELLS_PER_CHILD) {
+			index->unbounded_children.push_back(bounded_children[i]);
+			bounded_children[i] = UINT32_MAX;
+			continue;
+		}
+		for (int y = from_y; y <= to_y; y++) {
+			for (int x = from_x; x <= to_x; x++) {
+				index->cell_offsets[y * index->width + x + 1]++;
+			}
+		}
+	}
+
+	for (uint32_t i = 1; i < index->cell_offsets.size(); i++) {
+		index->cell_offsets[i] += index->cell_offsets[i - 1];
+	}
+	index->cell_children.resize(index->cell_offsets[index->cell_offsets.size() - 1]);
+
+	LocalVector<uint32_t> cell_fill;
+	cell_fill.resize(index->width * index->height);
+	memcpy(cell_fill.ptr(), index->cell_offsets.ptr(), cell_fill.size() * sizeof(uint32_t));
+
+	for (uint32_t i = 0; i < bounded_children.size(); i++) {
+		if (bounded_children[i] == UINT32_MAX) {
+			continue;
+		}
+		int from_x, from_y, to_x, to_y;
+		index->get_cell_range(child_rects[bounded_children[i]], from_x, from_y, to_x, to_y);
+		for (int y = from_y; y <= to_y; y++) {
+			for (int x = from_x; x <= to_x; x++) {
+				index->cell_children[cell_fill[y * index->width + x]++] = bounded_children[i];
+			}
+		}
+	}
+
+	p_item->child_index = index;
+}
+
+void RendererCanvasCull::_cull_child_index(Item *p_item, const Transform2D &p_xform, const Rect2 &p_clip_rect, LocalVector<Item *> &r_children) {
+	const Item::ChildIndex *index = p_item->child_index;
+	Item **child_items = p_item->child_items.ptrw();
+
+	LocalVector<uint32_t> indices = index->unbounded_children;
+
+	// Items are tested against the clip rect after being offset by its position, see _cull_canvas_item().
+	Rect2 local_clip_rect = p_xform.affine_inverse().xform(Rect2(Point2(), p_clip_rect.size).grow(_get_subtree_snap_margin(p_item)));
+	if (index->bounds.intersects(local_clip_rect, true)) {
+		child_index_pass++;
+
+		int from_x, from_y, to_x, to_y;
+		index->get_cell_range(local_clip_rect, from_x, from_y, to_x, to_y);
+		for (int y = from_y; y <= to_y; y++) {
+			for (int x = from_x; x <= to_x; x++) {
+				const uint32_t cell = y * index->width + x;
+				for (uint32_t i = index->cell_offsets[cell]; i < index->cell_offsets[cell + 1]; i++) {
+					Item *child = child_items[index->cell_children[i]];
+					if (child->child_index_pass != child_index_pass) {
+						child->child_index_pass = child_index_pass;
+						indices.push_back(index->cell_children[i]);
+					}
+				}
+			}
+		}
+	}
+
+	// Keep the draw order.
+	indices.sort();
+
+	r_children.resize(indices.size());
+	for (uint32_t i = 0; i < indices.size(); i++) {
+		r_children[i] = child_items[indices[i]];
+	}
+}
+
 void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *ci, RendererCanvasCull::Item *p_canvas_clip, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, const Transform2D &p_transform, const Rect2 &p_clip_rect, Rect2 p_global_rect, const Color &p_modulate, int p_z, RendererCanvasCull::Item *p_material_owner, bool p_use_canvas_group, RendererCanvasRender::Item *r_canvas_group_from) {
 	if (ci->copy_back_buffer) {
 		ci->copy_back_buffer->screen_rect = p_transform.xform(ci->copy_back_buffer->rect).intersection(p_clip_rect);
@@ -232,7 +433,8 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 				rect_accum = rect_accum.grow(ci->canvas_group->fit_margin);
 
 				//draw it?
-				RendererCanvasRender::Item::CommandRect *crect = ci->alloc_command<RendererCanvasRender::Item::CommandRect>();
+				// Canvas groups are never culled by subtree, so there is no need to dirty the subtree rects every frame.
+				RendererCanvasRender::Item::CommandRect *crect = ci->RendererCanvasRender::Item::alloc_command<RendererCanvasRender::Item::CommandRect>();
 
 				crect->flags = RendererCanvasRender::CANVAS_RECT_IS_GROUP; // so we can recognize it later
 				crect->rect = p_transform.affine_inverse().xform(rect_accum);
@@ -406,6 +608,23 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 	}
 	global_rect.position += p_clip_rect.position;
 
+	// Repeated items are drawn at offsets that the subtree bounds don't account for.
+	const bool repeating = repeat_source_item && (repeat_size.x || repeat_size.y);
+	if (subtree_culling_enabled && !p_is_already_y_sorted && !repeating) {
+		_update_subtree_rect(ci);
+		if (ci->subtree_cullable) {
+			if (ci->subtree_empty) {
+				return;
+			}
+			Rect2 subtree_global_rect = final_xform.xform(ci->subtree_rect).grow(_get_subtree_snap_margin(ci));
+			subtree_global_rect.position += p_clip_rect.position;
+			if (!p_clip_rect.intersects(subtree_global_rect, true)) {
+				// Nothing in the subtree can be visible.
+				return;
+			}
+		}
+	}
+
 	int child_item_count = ci->child_items.size();
 	Item **child_items = ci->child_items.ptrw();
 
@@ -475,6 +694,19 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 			canvas_group_from = r_z_last_list[zidx];
 		}
 
+		// Don't bother indexing the children of items that change every frame.
+		if (subtree_culling_enabled && ci->child_index_pending && !ci->subtree_rect_dirty && RSG::rasterizer->get_frame_number() - ci->subtree_rect_frame > 1) {
+			ci->child_index_pending = false;
+			_build_child_index(ci);
+		}
+
+		LocalVector<Item *> indexed_child_items;
+		if (subtree_culling_enabled && ci->child_index && !ci->subtree_rect_dirty && !use_canvas_group && !repeating && !Math::is_zero_approx(final_xform.determinant())) {
+			_cull_child_index(ci, final_xform, p_clip_rect, indexed_child_items);
+			child_item_count = indexed_child_items.size();
+			child_items = indexed_child_items.ptr();
+		}
+
 		for (int i = 0; i < child_item_count; i++) {
 			if (!child_items[i]->behind && !use_canvas_group) {
 				continue;
@@ -514,6 +746,29 @@ bool RendererCanvasCull::was_sdf_used() {
 	return sdf_used;
 }
 
+void RendererCanvasCull::cull_canvas(RID p_canvas, const Transform2D &p_transform, const Rect2 &p_clip_rect, uint32_t p_canvas_cull_mask, LocalVector<RendererCanvasRender::Item *> &r_items) {
+	Canvas *canvas = canvas_owner.get_or_null(p_canvas);
+	ERR_FAIL_NULL(canvas);
+
+	snapping_2d_transforms_to_pixel = false;
+
+	if (canvas->children_order_dirty) {
+		canvas->child_items.sort();
+		canvas->children_order_dirty = false;
+	}
+
+	r_items.clear();
+	for (RendererCanvasRender::Item *item = _cull_canvas_item_tree(canvas->child_items.ptrw(), canvas->child_items.size(), p_transform, p_clip_rect, p_canvas_cull_mask); item; item = item->next) {
+		r_items.push_back(item);
+	}
+}
+
+bool RendererCanvasCull::canvas_item_has_child_index(RID p_item) {
+	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
+	ERR_FAIL_NULL_V(canvas_item, false);
+	return canvas_item->child_index != nullptr;
+}
+
 RID RendererCanvasCull::canvas_allocate() {
 	return canvas_owner.allocate_rid();
 }
@@ -535,6 +790,7 @@ void RendererCanvasCull::canvas_set_item_mirroring(RID p_canvas, RID p_item, con
 	canvas_item->repeat_source_item = is_repeat_source ? canvas_item : nullptr;
 	canvas_item->repeat_size = p_mirroring;
 	canvas_item->repeat_times = 1;
+	_mark_subtree_rect_dirty(canvas_item);
 }
 
 void RendererCanvasCull::canvas_set_item_repeat(RID p_item, const Point2 &p_repeat_size, int p_repeat_times) {
@@ -547,6 +803,7 @@ void RendererCanvasCull::canvas_set_item_repeat(RID p_item, const Point2 &p_repe
 	canvas_item->repeat_source_item = is_repeat_source ? canvas_item : nullptr;
 	canvas_item->repeat_size = p_repeat_size;
 	canvas_item->repeat_times = p_repeat_times;
+	_mark_subtree_rect_dirty(canvas_item);
 }
 
 void RendererCanvasCull::canvas_set_modulate(RID p_canvas, const Color &p_color) {
@@ -591,6 +848,7 @@ void RendererCanvasCull::canvas_item_set_parent(RID p_item, RID p_parent) {
 			if (item_owner->sort_y) {
 				_mark_ysort_dirty(item_owner);
 			}
+			_mark_subtree_rect_dirty(item_owner);
 		}
 
 		canvas_item->parent = RID();
@@ -611,6 +869,7 @@ void RendererCanvasCull::canvas_item_set_parent(RID p_item, RID p_parent) {
 			if (item_owner->sort_y) {
 				_mark_ysort_dirty(item_owner);
 			}
+			_mark_subtree_rect_dirty(item_owner);
 
 		} else {
 			ERR_FAIL_MSG("Invalid parent.");
@@ -650,6 +909,7 @@ void RendererCanvasCull::canvas_item_set_transform(RID p_item, const Transform2D
 	}
 
 	canvas_item->xform_curr = p_transform;
+	_mark_parent_subtree_rect_dirty(canvas_item);
 }
 
 void RendererCanvasCull::canvas_item_set_visibility_layer(RID p_item, uint32_t p_visibility_layer) {
@@ -687,6 +947,7 @@ void RendererCanvasCull::canvas_item_set_custom_rect(RID p_item, bool p_custom_r
 
 	canvas_item->custom_rect = p_custom_rect;
 	canvas_item->rect = p_rect;
+	_mark_subtree_rect_dirty(canvas_item);
 }
 
 void RendererCanvasCull::canvas_item_set_modulate(RID p_item, const Color &p_color) {
@@ -715,6 +976,7 @@ void RendererCanvasCull::canvas_item_set_use_identity_transform(RID p_item, bool
 	ERR_FAIL_NULL(canvas_item);
 
 	canvas_item->use_identity_transform = p_enable;
+	_mark_subtree_rect_dirty(canvas_item);
 }
 
 void RendererCanvasCull::canvas_item_set_update_when_visible(RID p_item, bool p_update) {
@@ -722,6 +984,7 @@ void RendererCanvasCull::canvas_item_set_update_when_visible(RID p_item, bool p_
 	ERR_FAIL_NULL(canvas_item);
 
 	canvas_item->update_when_visible = p_update;
+	_mark_subtree_rect_dirty(canvas_item);
 }
 
 void RendererCanvasCull::canvas_item_add_line(RID p_item, const Point2 &p_from, const Point2 &p_to, const Color &p_color, float p_width, bool p_antialiased) {
@@ -1835,6 +2098,7 @@ void RendererCanvasCull::canvas_item_set_sort_children_by_y(RID p_item, bool p_e
 	canvas_item->sort_y = p_enable;
 
 	_mark_ysort_dirty(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 }
 
 void RendererCanvasCull::canvas_item_set_z_index(RID p_item, int p_z) {
@@ -1860,6 +2124,7 @@ void RendererCanvasCull::canvas_item_attach_skeleton(RID p_item, RID p_skeleton)
 		return;
 	}
 	canvas_item->skeleton = p_skeleton;
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::Command *c = canvas_item->commands;
 
@@ -1897,6 +2162,7 @@ void RendererCanvasCull::canvas_item_set_copy_to_backbuffer(RID p_item, bool p_e
 		canvas_item->copy_back_buffer->rect = p_rect;
 		canvas_item->copy_back_buffer->full = p_rect == Rect2();
 	}
+	_mark_subtree_rect_dirty(canvas_item);
 }
 
 void RendererCanvasCull::canvas_item_clear(RID p_item) {
@@ -1904,6 +2170,7 @@ void RendererCanvasCull::canvas_item_clear(RID p_item) {
 	ERR_FAIL_NULL(canvas_item);
 
 	canvas_item->clear();
+	_mark_subtree_rect_dirty(canvas_item);
 
 #ifdef DEBUG_ENABLED
 	if (debug_redraw) {
@@ -1921,6 +2188,7 @@ void RendererCanvasCull::canvas_item_set_draw_index(RID p_item, int p_index) {
 	if (canvas_item_owner.owns(canvas_item->parent)) {
 		Item *canvas_item_parent = canvas_item_owner.get_or_null(canvas_item->parent);
 		canvas_item_parent->children_order_dirty = true;
+		_mark_subtree_rect_dirty(canvas_item_parent);
 		return;
 	}
 
@@ -1995,6 +2263,7 @@ void RendererCanvasCull::canvas_item_set_visibility_notifier(RID p_item, bool p_
 			canvas_item->visibility_notifier = nullptr;
 		}
 	}
+	_mark_subtree_rect_dirty(canvas_item);
 }
 
 void RendererCanvasCull::canvas_item_set_debug_redraw(bool p_enabled) {
@@ -2010,6 +2279,7 @@ void RendererCanvasCull::canvas_item_set_interpolated(RID p_item, bool p_interpo
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 	canvas_item->interpolated = p_interpolated;
+	_mark_parent_subtree_rect_dirty(canvas_item);
 }
 
 void RendererCanvasCull::canvas_item_reset_physics_interpolation(RID p_item) {
@@ -2024,6 +2294,7 @@ void RendererCanvasCull::canvas_item_transform_physics_interpolation(RID p_item,
 	ERR_FAIL_NULL(canvas_item);
 	canvas_item->xform_prev = p_transform * canvas_item->xform_prev;
 	canvas_item->xform_curr = p_transform * canvas_item->xform_curr;
+	_mark_parent_subtree_rect_dirty(canvas_item);
 }
 
 void RendererCanvasCull::canvas_item_set_canvas_group_mode(RID p_item, RS::CanvasGroupMode p_mode, float p_clear_margin, bool p_fit_empty, float p_fit_margin, bool p_blur_mipmaps) {
@@ -2045,6 +2316,7 @@ void RendererCanvasCull::canvas_item_set_canvas_group_mode(RID p_item, RS::Canva
 		canvas_item->canvas_group->blur_mipmaps = p_blur_mipmaps;
 		canvas_item->canvas_group->clear_margin = p_clear_margin;
 	}
+	_mark_subtree_rect_dirty(canvas_item);
 }
 
 RID RendererCanvasCull::canvas_light_allocate() {
@@ -2607,6 +2879,7 @@ bool RendererCanvasCull::free(RID p_rid) {
 				if (item_owner->sort_y) {
 					_mark_ysort_dirty(item_owner);
 				}
+				_mark_subtree_rect_dirty(item_owner);
 			}
 		}
 
@@ -81,6 +81,45 @@ public:
 
 		bool update_dependencies = false;
 
+		// Bounds of this item and all its descendants in the item's local space, used to cull whole subtrees.
+		// Recomputed lazily; an item whose bounds are clean always has a clean subtree.
+		Rect2 subtree_rect;
+		int subtree_depth = 0;
+		uint64_t subtree_rect_frame = 0;
+		bool subtree_rect_dirty = true;
+		bool subtree_empty = true; // Nothing in the subtree has commands or a visibility notifier.
+		bool subtree_cullable = false; // Something in the subtree may draw outside of `subtree_rect`.
+		uint32_t child_index_pass = 0;
+
+		// Uniform grid over the subtree rects of `child_items`, in local space. Only built for items with many children.
+		struct ChildIndex {
+			Rect2 bounds;
+			Vector2 cells_per_unit;
+			int width = 0;
+			int height = 0;
+			LocalVector<uint32_t> cell_offsets; // Where each cell starts in `cell_children`, plus the end.
+			LocalVector<uint32_t> cell_children;
+			LocalVector<uint32_t> unbounded_children; // Always visited.
+
+			_FORCE_INLINE_ void get_cell_range(const Rect2 &p_rect, int &r_from_x, int &r_from_y, int &r_to_x, int &r_to_y) const {
+				const Vector2 from = (p_rect.position - bounds.position) * cells_per_unit;
+				const Vector2 to = (p_rect.get_end() - bounds.position) * cells_per_unit;
+				r_from_x = (int)CLAMP(from.x, (real_t)0, (real_t)(width - 1));
+				r_from_y = (int)CLAMP(from.y, (real_t)0, (real_t)(height - 1));
+				r_to_x = (int)CLAMP(to.x, (real_t)0, (real_t)(width - 1));
+				r_to_y = (int)CLAMP(to.y, (real_t)0, (real_t)(height - 1));
+			}
+		};
+
+		ChildIndex *child_index = nullptr;
+		bool child_index_pending = false; // Built once the subtree rect has been clean for a frame.
+
+		template <typename T>
+		T *alloc_command() {
+			RendererCanvasCull::_mark_subtree_rect_dirty(this);
+			return RendererCanvasRender::Item::alloc_command<T>();
+		}
+
 		Item() :
 				update_item(this) {
 			children_order_dirty = true;
@@ -101,6 +140,12 @@ public:
 			dependency_tracker.changed_callback = &RendererCanvasCull::_dependency_changed;
 			dependency_tracker.deleted_callback = &RendererCanvasCull::_dependency_deleted;
 		}
+
+		~Item() {
+			if (child_index) {
+				memdelete(child_index);
+			}
+		}
 	};
 
 	void _item_queue_update(Item *p_item, bool p_update_dependencies);
@@ -204,6 +249,7 @@ public:
 	_FORCE_INLINE_ void _attach_canvas_item_for_draw(Item *ci, Item *p_canvas_clip, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, const Transform2D &p_transform, const Rect2 &p_clip_rect, Rect2 p_global_rect, const Color &modulate, int p_z, RendererCanvasCull::Item *p_material_owner, bool p_use_canvas_group, RendererCanvasRender::Item *r_canvas_group_from);
 
 private:
+	RendererCanvasRender::Item *_cull_canvas_item_tree(Canvas::ChildItem *p_child_items, int p_child_item_count, const Transform2D &p_transform, const Rect2 &p_clip_rect, uint32_t p_canvas_cull_mask);
 	void _render_canvas_item_tree(RID p_to_render_target, Canvas::ChildItem *p_child_items, int p_child_item_count, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, RS::CanvasItemTextureFilter p_default_filter, RS::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_vertices_to_pixel, uint32_t p_canvas_cull_mask, RenderingMethod::RenderInfo *r_render_info = nullptr);
 	void _cull_canvas_item(Item *p_canvas_item, const Transform2D &p_parent_xform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, Item *p_canvas_clip, Item *p_material_owner, bool p_is_already_y_sorted, uint32_t p_canvas_cull_mask, const Point2 &p_repeat_size, int p_repeat_times, RendererCanvasRender::Item *p_repeat_source_item);
 
@@ -211,6 +257,19 @@ private:
 	int _count_ysort_children(RendererCanvasCull::Item *p_canvas_item);
 	void _mark_ysort_dirty(RendererCanvasCull::Item *ysort_owner);
 
+	static void _mark_subtree_rect_dirty(Item *p_item);
+	void _mark_parent_subtree_rect_dirty(Item *p_item);
+	void _update_subtree_rect(Item *p_item);
+	void _build_child_index(Item *p_item);
+	void _cull_child_index(Item *p_item, const Transform2D &p_xform, const Rect2 &p_clip_rect, LocalVector<Item *> &r_children);
+	_FORCE_INLINE_ real_t _get_subtree_snap_margin(const Item *p_item) const {
+		// Snapping moves every level of the subtree by up to half a pixel.
+		return snapping_2d_transforms_to_pixel ? 1.0 + p_item->subtree_depth : 1.0;
+	}
+
+	uint32_t child_index_pass = 0;
+	bool subtree_culling_enabled = true;
+
 	static constexpr int z_range = RS::CANVAS_ITEM_Z_MAX - RS::CANVAS_ITEM_Z_MIN + 1;
 
 	RendererCanvasRender::Item **z_list;
@@ -223,6 +282,12 @@ public:
 
 	bool was_sdf_used();
 
+	// Returns the items render_canvas() would draw, in draw order.
+	void cull_canvas(RID p_canvas, const Transform2D &p_transform, const Rect2 &p_clip_rect, uint32_t p_canvas_cull_mask, LocalVector<RendererCanvasRender::Item *> &r_items);
+	// Without subtree culling every item is visited, which is slower but never skips anything.
+	void set_subtree_culling_enabled(bool p_enabled) { subtree_culling_enabled = p_enabled; }
+	bool canvas_item_has_child_index(RID p_item);
+
 	RID canvas_allocate();
 	void canvas_initialize(RID p_rid);
 
@@ -35,6 +35,7 @@
 
 #include "servers/rendering/renderer_rd/forward_clustered/render_forward_clustered.h"
 #include "servers/rendering/renderer_rd/forward_mobile/render_forward_mobile.h"
+#include "servers/rendering/shader_compiler.h"
 
 void RendererCompositorRD::blit_render_targets_to_screen(DisplayServer::WindowID p_screen, const BlitToScreen *p_render_targets, int p_amount) {
 	Error err = RD::get_singleton()->screen_prepare_for_drawing(p_screen);
@@ -296,6 +297,12 @@ RendererCompositorRD::RendererCompositorRD() {
 			} else {
 				shader_cache_user_dir = shader_cache_user_dir.path_join("shader_cache");
 				ShaderRD::set_shader_cache_user_dir(shader_cache_user_dir);
+
+				// Parsed and generated shader code is cached next to the compiled shaders.
+				String compile_cache_dir = shader_cache_user_dir.path_join("shader_compiler");
+				if (user_da->make_dir_recursive(compile_cache_dir) == OK) {
+					ShaderCompiler::set_compile_cache_dir(compile_cache_dir);
+				}
 			}
 		}
 
@@ -344,4 +351,5 @@ RendererCompositorRD::~RendererCompositorRD() {
 	memdelete(framebuffer_cache);
 	ShaderRD::set_shader_cache_user_dir(String());
 	ShaderRD::set_shader_cache_res_dir(String());
+	ShaderCompiler::set_compile_cache_dir(String());
 }
@@ -32,6 +32,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/object/worker_thread_pool.h"
+#include "raster_occlusion_cull.h"
 #include "rendering_light_culler.h"
 #include "rendering_server_default.h"
 
@@ -486,6 +487,14 @@ RID RendererSceneCull::scenario_get_environment(RID p_scenario) {
 void RendererSceneCull::scenario_remove_viewport_visibility_mask(RID p_scenario, RID p_viewport) {
 	Scenario *scenario = scenario_owner.get_or_null(p_scenario);
 	ERR_FAIL_NULL(scenario);
+
+	// The viewport leaves the scenario, so its frustum plane hint slot can be reused.
+	HashMap<RID, uint32_t>::Iterator hint_slot = scenario->frustum_plane_hint_slots.find(p_viewport);
+	if (hint_slot) {
+		scenario->used_frustum_plane_hint_slots &= ~(1u << hint_slot->value);
+		scenario->frustum_plane_hint_slots.remove(hint_slot);
+	}
+
 	if (!scenario->viewport_visibility_masks.has(p_viewport)) {
 		return;
 	}
@@ -514,6 +523,28 @@ void RendererSceneCull::scenario_add_viewport_visibility_mask(RID p_scenario, RI
 	scenario->used_viewport_visibility_bits |= new_mask;
 }
 
+int32_t RendererSceneCull::_get_frustum_plane_hint_slot(Scenario *p_scenario, RID p_viewport) {
+	if (p_viewport.is_null()) {
+		return -1;
+	}
+
+	const uint32_t *slot = p_scenario->frustum_plane_hint_slots.getptr(p_viewport);
+	if (slot) {
+		return *slot;
+	}
+
+	for (uint32_t i = 0; i < InstanceData::FRUSTUM_PLANE_HINT_SLOTS; i++) {
+		if (!(p_scenario->used_frustum_plane_hint_slots & (1u << i))) {
+			p_scenario->used_frustum_plane_hint_slots |= 1u << i;
+			p_scenario->frustum_plane_hint_slots.insert(p_viewport, i);
+			return i;
+		}
+	}
+
+	// Further viewports cull without hints rather than overwrite the hints of others.
+	return -1;
+}
+
 /* INSTANCING API */
 
 void RendererSceneCull::_instance_queue_update(Instance *p_instance, bool p_update_aabb, bool p_update_dependencies) const {
@@ -839,6 +870,7 @@ void RendererSceneCull::instance_set_scenario(RID p_instance, RID p_scenario) {
 					instance->scenario->directional_lights.erase(light->D);
 					light->D = nullptr;
 				}
+				light->shadow_caster_cache.clear();
 			} break;
 			case RS::INSTANCE_REFLECTION_PROBE: {
 				InstanceReflectionProbeData *reflection_probe = static_cast<InstanceReflectionProbeData *>(instance->base_data);
@@ -1583,6 +1615,10 @@ uint32_t RendererSceneCull::get_pipeline_compilations(RS::PipelineSource p_sourc
 	return scene_render->get_pipeline_compilations(p_source);
 }
 
+uint64_t RendererSceneCull::get_frustum_plane_tests_in_frame() const {
+	return frustum_plane_tests_in_frame.get();
+}
+
 void RendererSceneCull::instance_geometry_get_shader_parameter_list(RID p_instance, List<PropertyInfo> *p_parameters) const {
 	ERR_FAIL_NULL(p_parameters);
 	const Instance *instance = instance_owner.get_or_null(p_instance);
@@ -1593,7 +1629,56 @@ void RendererSceneCull::instance_geometry_get_shader_parameter_list(RID p_instan
 	instance->instance_uniforms.get_property_list(*p_parameters);
 }
 
-void RendererSceneCull::_update_instance(Instance *p_instance) const {
+AABB RendererSceneCull::_get_instance_bvh_aabb(const Instance *p_instance, const AABB &p_transformed_aabb) {
+	//quantize to improve moving object performance
+	AABB bvh_aabb = p_transformed_aabb;
+
+	if (p_instance->indexer_id.is_valid() && bvh_aabb != p_instance->prev_transformed_aabb) {
+		//assume motion, see if bounds need to be quantized
+		AABB motion_aabb = bvh_aabb.merge(p_instance->prev_transformed_aabb);
+		float motion_longest_axis = motion_aabb.get_longest_axis_size();
+		float longest_axis = p_transformed_aabb.get_longest_axis_size();
+
+		if (motion_longest_axis < longest_axis * 2) {
+			//moved but not a lot, use motion aabb quantizing
+			float quantize_size = Math::pow(2.0, Math::ceil(Math::log(motion_longest_axis) / Math::log(2.0))) * 0.5; //one fifth
+			bvh_aabb.quantize(quantize_size);
+		}
+	}
+
+	return bvh_aabb;
+}
+
+void RendererSceneCull::_compute_dirty_instance_bounds(uint32_t p_index, DirtyInstanceBounds *p_bounds) const {
+	DirtyInstanceBounds &bounds = p_bounds[p_index];
+	Instance *instance = bounds.instance;
+	bounds.transformed_aabb = instance->transform.xform(instance->aabb);
+	bounds.bvh_aabb = _get_instance_bvh_aabb(instance, bounds.transformed_aabb);
+
+	if (!((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !instance->aabb.has_surface()) {
+		return;
+	}
+
+	InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(instance->base_data);
+	if (!geom->geometry_instance) {
+		return;
+	}
+
+	// Lightmap SH sampling and the geometry instance transform (LOD scale, motion vectors) only touch this instance.
+	// Applying the capture marks the geometry instance dirty in a shared list, so that part stays in _update_instance().
+	if (!instance->lightmap && geom->lightmap_captures.size()) {
+		_compute_instance_lightmap_captures(instance);
+		bounds.lightmap_captures_computed = true;
+	}
+
+	geom->geometry_instance->set_transform(instance->transform, instance->aabb, bounds.transformed_aabb);
+	if (instance->teleported) {
+		geom->geometry_instance->reset_motion_vectors();
+	}
+	bounds.geometry_transform_set = true;
+}
+
+void RendererSceneCull::_update_instance(Instance *p_instance, const DirtyInstanceBounds *p_bounds) const {
 	p_instance->version++;
 
 	// When not using interpolation the transform is used straight.
@@ -1691,9 +1776,11 @@ void RendererSceneCull::_update_instance(Instance *p_instance) const {
 		}
 	}
 
-	AABB new_aabb;
-	new_aabb = instance_xform->xform(p_instance->aabb);
-	p_instance->transformed_aabb = new_aabb;
+	if (p_bounds) {
+		p_instance->transformed_aabb = p_bounds->transformed_aabb;
+	} else {
+		p_instance->transformed_aabb = instance_xform->xform(p_instance->aabb);
+	}
 
 	if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
 		InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(p_instance->base_data);
@@ -1708,7 +1795,12 @@ void RendererSceneCull::_update_instance(Instance *p_instance) const {
 
 		if (!p_instance->lightmap && geom->lightmap_captures.size()) {
 			//affected by lightmap captures, must update capture info!
-			_update_instance_lightmap_captures(p_instance);
+			if (p_bounds && p_bounds->lightmap_captures_computed) {
+				ERR_FAIL_NULL(geom->geometry_instance);
+				geom->geometry_instance->set_lightmap_capture(p_instance->lightmap_sh.ptr());
+			} else {
+				_update_instance_lightmap_captures(p_instance);
+			}
 		} else {
 			if (!p_instance->lightmap_sh.is_empty()) {
 				p_instance->lightmap_sh.clear(); //don't need SH
@@ -1720,9 +1812,11 @@ void RendererSceneCull::_update_instance(Instance *p_instance) const {
 
 		ERR_FAIL_NULL(geom->geometry_instance);
 
-		geom->geometry_instance->set_transform(*instance_xform, p_instance->aabb, p_instance->transformed_aabb);
-		if (p_instance->teleported) {
-			geom->geometry_instance->reset_motion_vectors();
+		if (!p_bounds || !p_bounds->geometry_transform_set) {
+			geom->geometry_instance->set_transform(*instance_xform, p_instance->aabb, p_instance->transformed_aabb);
+			if (p_instance->teleported) {
+				geom->geometry_instance->reset_motion_vectors();
+			}
 		}
 	}
 
@@ -1732,25 +1826,12 @@ void RendererSceneCull::_update_instance(Instance *p_instance) const {
 		return;
 	}
 
-	//quantize to improve moving object performance
-	AABB bvh_aabb = p_instance->transformed_aabb;
-
-	if (p_instance->indexer_id.is_valid() && bvh_aabb != p_instance->prev_transformed_aabb) {
-		//assume motion, see if bounds need to be quantized
-		AABB motion_aabb = bvh_aabb.merge(p_instance->prev_transformed_aabb);
-		float motion_longest_axis = motion_aabb.get_longest_axis_size();
-		float longest_axis = p_instance->transformed_aabb.get_longest_axis_size();
-
-		if (motion_longest_axis < longest_axis * 2) {
-			//moved but not a lot, use motion aabb quantizing
-			float quantize_size = Math::pow(2.0, Math::ceil(Math::log(motion_longest_axis) / Math::log(2.0))) * 0.5; //one fifth
-			bvh_aabb.quantize(quantize_size);
-		}
-	}
+	const AABB bvh_aabb = p_bounds ? p_bounds->bvh_aabb : _get_instance_bvh_aabb(p_instance, p_instance->transformed_aabb);
 
 	if (!p_instance->indexer_id.is_valid()) {
 		if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
 			p_instance->indexer_id = p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY].insert(bvh_aabb, p_instance);
+			p_instance->scenario->geometry_version++;
 		} else {
 			p_instance->indexer_id = p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES].insert(bvh_aabb, p_instance);
 		}
@@ -1840,7 +1921,9 @@ void RendererSceneCull::_update_instance(Instance *p_instance) const {
 		_update_instance_visibility_dependencies(p_instance);
 	} else {
 		if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
-			p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY].update(p_instance->indexer_id, bvh_aabb);
+			if (p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY].update(p_instance->indexer_id, bvh_aabb)) {
+				p_instance->scenario->geometry_version++;
+			}
 		} else {
 			p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES].update(p_instance->indexer_id, bvh_aabb);
 		}
@@ -1919,6 +2002,7 @@ void RendererSceneCull::_unpair_instance(Instance *p_instance) {
 
 	if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
 		p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY].remove(p_instance->indexer_id);
+		p_instance->scenario->geometry_version++;
 	} else {
 		p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES].remove(p_instance->indexer_id);
 	}
@@ -2050,7 +2134,7 @@ void RendererSceneCull::_update_instance_aabb(Instance *p_instance) const {
 	p_instance->aabb = new_aabb;
 }
 
-void RendererSceneCull::_update_instance_lightmap_captures(Instance *p_instance) const {
+void RendererSceneCull::_compute_instance_lightmap_captures(Instance *p_instance) const {
 	bool first_set = p_instance->lightmap_sh.is_empty();
 	p_instance->lightmap_sh.resize(9); //using SH
 	p_instance->lightmap_target_sh.resize(9); //using SH
@@ -2127,6 +2211,12 @@ void RendererSceneCull::_update_instance_lightmap_captures(Instance *p_instance)
 		}
 	}
 
+}
+
+void RendererSceneCull::_update_instance_lightmap_captures(Instance *p_instance) const {
+	_compute_instance_lightmap_captures(p_instance);
+
+	InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(p_instance->base_data);
 	ERR_FAIL_NULL(geom->geometry_instance);
 	geom->geometry_instance->set_lightmap_capture(p_instance->lightmap_sh.ptr());
 }
@@ -2352,241 +2442,214 @@ void RendererSceneCull::_light_instance_setup_directional_shadow(int p_shadow_in
 	}
 }
 
-bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, const Transform3D p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, RID p_shadow_atlas, Scenario *p_scenario, float p_screen_mesh_lod_threshold, uint32_t p_visible_layers) {
+bool RendererSceneCull::_light_instance_queue_shadow_cull(Instance *p_instance, Scenario *p_scenario) {
 	InstanceLightData *light = static_cast<InstanceLightData *>(p_instance->base_data);
 
 	Transform3D light_transform = p_instance->transform;
 	light_transform.orthonormalize(); //scale does not count on lights
 
-	bool animated_material_found = false;
+	real_t radius = RSG::light_storage->light_get_param(p_instance->base, RS::LIGHT_PARAM_RANGE);
+	real_t spot_angle = 0;
+	uint32_t pass_count = 0;
 
 	switch (RSG::light_storage->light_get_type(p_instance->base)) {
 		case RS::LIGHT_DIRECTIONAL: {
+			// Directional shadows are culled along with the scene.
+			return false;
 		} break;
 		case RS::LIGHT_OMNI: {
 			RS::LightOmniShadowMode shadow_mode = RSG::light_storage->light_omni_get_shadow_mode(p_instance->base);
+			pass_count = (shadow_mode == RS::LIGHT_OMNI_SHADOW_DUAL_PARABOLOID || !RSG::light_storage->light_instances_can_render_shadow_cube()) ? 2 : 6;
+		} break;
+		case RS::LIGHT_SPOT: {
+			spot_angle = RSG::light_storage->light_get_param(p_instance->base, RS::LIGHT_PARAM_SPOT_ANGLE);
+			pass_count = 1;
+		} break;
+	}
 
-			if (shadow_mode == RS::LIGHT_OMNI_SHADOW_DUAL_PARABOLOID || !RSG::light_storage->light_instances_can_render_shadow_cube()) {
-				if (max_shadows_used + 2 > MAX_UPDATE_SHADOWS) {
-					return true;
-				}
-				for (int i = 0; i < 2; i++) {
-					//using this one ensures that raster deferred will have it
-					RENDER_TIMESTAMP("Cull OmniLight3D Shadow Paraboloid, Half " + itos(i));
-
-					real_t radius = RSG::light_storage->light_get_param(p_instance->base, RS::LIGHT_PARAM_RANGE);
-
-					real_t z = i == 0 ? -1 : 1;
-					Vector<Plane> planes;
-					planes.resize(6);
-					planes.write[0] = light_transform.xform(Plane(Vector3(0, 0, z), radius));
-					planes.write[1] = light_transform.xform(Plane(Vector3(1, 0, z).normalized(), radius));
-					planes.write[2] = light_transform.xform(Plane(Vector3(-1, 0, z).normalized(), radius));
-					planes.write[3] = light_transform.xform(Plane(Vector3(0, 1, z).normalized(), radius));
-					planes.write[4] = light_transform.xform(Plane(Vector3(0, -1, z).normalized(), radius));
-					planes.write[5] = light_transform.xform(Plane(Vector3(0, 0, -z), 0));
-
-					instance_shadow_cull_result.clear();
-
-					Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
-
-					struct CullConvex {
-						PagedArray<Instance *> *result;
-						_FORCE_INLINE_ bool operator()(void *p_data) {
-							Instance *p_instance = (Instance *)p_data;
-							result->push_back(p_instance);
-							return false;
-						}
-					};
-
-					CullConvex cull_convex;
-					cull_convex.result = &instance_shadow_cull_result;
-
-					p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(planes.ptr(), planes.size(), points.ptr(), points.size(), cull_convex);
-
-					RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
-
-					if (!light->is_shadow_update_full()) {
-						light_culler->cull_regular_light(instance_shadow_cull_result);
-					}
-
-					for (int j = 0; j < (int)instance_shadow_cull_result.size(); j++) {
-						Instance *instance = instance_shadow_cull_result[j];
-						if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || !(p_visible_layers & instance->layer_mask & RSG::light_storage->light_get_shadow_caster_mask(p_instance->base))) {
-							continue;
-						} else {
-							if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-								animated_material_found = true;
-							}
+	if (max_shadows_used + pass_count > MAX_UPDATE_SHADOWS) {
+		return true;
+	}
 
-							if (instance->mesh_instance.is_valid()) {
-								RSG::mesh_storage->mesh_instance_check_for_update(instance->mesh_instance);
-							}
-						}
+	// The casters found in the geometry indexer only depend on the light volume and the indexer contents,
+	// so they can be reused as long as neither changed.
+	InstanceLightData::ShadowCasterCache &cache = light->shadow_caster_cache;
+	bool cached = cache.pass_count == pass_count && cache.geometry_version == p_scenario->geometry_version && cache.range == radius && cache.spot_angle == spot_angle && cache.transform == light_transform;
+	if (!cached) {
+		cache.pass_count = pass_count;
+		cache.geometry_version = p_scenario->geometry_version;
+		cache.range = radius;
+		cache.spot_angle = spot_angle;
+		cache.transform = light_transform;
+	}
+
+	real_t z_near = MIN(0.025f, radius);
+
+	for (uint32_t i = 0; i < pass_count; i++) {
+		shadow_cull_jobs.resize(shadow_cull_jobs.size() + 1);
+		ShadowCullJob &job = shadow_cull_jobs[shadow_cull_jobs.size() - 1];
+		job.light = p_instance;
+		job.scenario = p_scenario;
+		job.pass = i;
+		job.shadow_index = max_shadows_used++;
+		job.radius = radius;
+		job.cached = cached;
+
+		if (pass_count == 2) {
+			// Dual paraboloid.
+			job.transform = light_transform;
+
+			if (!cached) {
+				real_t z = i == 0 ? -1 : 1;
+				job.planes.resize(6);
+				job.planes.write[0] = light_transform.xform(Plane(Vector3(0, 0, z), radius));
+				job.planes.write[1] = light_transform.xform(Plane(Vector3(1, 0, z).normalized(), radius));
+				job.planes.write[2] = light_transform.xform(Plane(Vector3(-1, 0, z).normalized(), radius));
+				job.planes.write[3] = light_transform.xform(Plane(Vector3(0, 1, z).normalized(), radius));
+				job.planes.write[4] = light_transform.xform(Plane(Vector3(0, -1, z).normalized(), radius));
+				job.planes.write[5] = light_transform.xform(Plane(Vector3(0, 0, -z), 0));
+			}
+		} else if (pass_count == 6) {
+			// Shadow cube.
+			static const Vector3 view_normals[6] = {
+				Vector3(+1, 0, 0),
+				Vector3(-1, 0, 0),
+				Vector3(0, -1, 0),
+				Vector3(0, +1, 0),
+				Vector3(0, 0, +1),
+				Vector3(0, 0, -1)
+			};
+			static const Vector3 view_up[6] = {
+				Vector3(0, -1, 0),
+				Vector3(0, -1, 0),
+				Vector3(0, 0, -1),
+				Vector3(0, 0, +1),
+				Vector3(0, -1, 0),
+				Vector3(0, -1, 0)
+			};
 
-						shadow_data.instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
-					}
+			job.projection.set_perspective(90, 1, z_near, radius);
+			job.transform = light_transform * Transform3D().looking_at(view_normals[i], view_up[i]);
+			if (!cached) {
+				job.planes = job.projection.get_projection_planes(job.transform);
+			}
+		} else {
+			// Spot.
+			job.projection.set_perspective(spot_angle * 2.0, 1.0, z_near, radius);
+			job.transform = light_transform;
+			if (!cached) {
+				job.planes = job.projection.get_projection_planes(light_transform);
+			}
+		}
+	}
 
-					RSG::mesh_storage->update_mesh_instances();
+	return false;
+}
 
-					RSG::light_storage->light_instance_set_shadow_transform(light->instance, Projection(), light_transform, radius, 0, i, 0);
-					shadow_data.light = light->instance;
-					shadow_data.pass = i;
-				}
-			} else { //shadow cube
+void RendererSceneCull::_shadow_cull_job(uint32_t p_index, ShadowCullJob *p_jobs) {
+	ShadowCullJob &job = p_jobs[p_index];
+	if (job.cached) {
+		return;
+	}
 
-				if (max_shadows_used + 6 > MAX_UPDATE_SHADOWS) {
-					return true;
-				}
+	LocalVector<Instance *> &casters = static_cast<InstanceLightData *>(job.light->base_data)->shadow_caster_cache.casters[job.pass];
+	casters.clear();
 
-				real_t radius = RSG::light_storage->light_get_param(p_instance->base, RS::LIGHT_PARAM_RANGE);
-				real_t z_near = MIN(0.025f, radius);
-				Projection cm;
-				cm.set_perspective(90, 1, z_near, radius);
-
-				for (int i = 0; i < 6; i++) {
-					RENDER_TIMESTAMP("Cull OmniLight3D Shadow Cube, Side " + itos(i));
-					//using this one ensures that raster deferred will have it
-
-					static const Vector3 view_normals[6] = {
-						Vector3(+1, 0, 0),
-						Vector3(-1, 0, 0),
-						Vector3(0, -1, 0),
-						Vector3(0, +1, 0),
-						Vector3(0, 0, +1),
-						Vector3(0, 0, -1)
-					};
-					static const Vector3 view_up[6] = {
-						Vector3(0, -1, 0),
-						Vector3(0, -1, 0),
-						Vector3(0, 0, -1),
-						Vector3(0, 0, +1),
-						Vector3(0, -1, 0),
-						Vector3(0, -1, 0)
-					};
-
-					Transform3D xform = light_transform * Transform3D().looking_at(view_normals[i], view_up[i]);
-
-					Vector<Plane> planes = cm.get_projection_planes(xform);
-
-					instance_shadow_cull_result.clear();
-
-					Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
-
-					struct CullConvex {
-						PagedArray<Instance *> *result;
-						_FORCE_INLINE_ bool operator()(void *p_data) {
-							Instance *p_instance = (Instance *)p_data;
-							result->push_back(p_instance);
-							return false;
-						}
-					};
+	Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(job.planes.ptr(), job.planes.size());
 
-					CullConvex cull_convex;
-					cull_convex.result = &instance_shadow_cull_result;
+	struct CullConvex {
+		LocalVector<Instance *> *result;
+		_FORCE_INLINE_ bool operator()(void *p_data) {
+			Instance *p_instance = (Instance *)p_data;
+			result->push_back(p_instance);
+			return false;
+		}
+	};
 
-					p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(planes.ptr(), planes.size(), points.ptr(), points.size(), cull_convex);
+	CullConvex cull_convex;
+	cull_convex.result = &casters;
 
-					RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
+	job.scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(job.planes.ptr(), job.planes.size(), points.ptr(), points.size(), cull_convex);
+}
 
-					if (!light->is_shadow_update_full()) {
-						light_culler->cull_regular_light(instance_shadow_cull_result);
-					}
+void RendererSceneCull::_light_instances_cull_shadows(uint32_t p_visible_layers) {
+	if (shadow_cull_jobs.is_empty()) {
+		return;
+	}
 
-					for (int j = 0; j < (int)instance_shadow_cull_result.size(); j++) {
-						Instance *instance = instance_shadow_cull_result[j];
-						if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || !(p_visible_layers & instance->layer_mask & RSG::light_storage->light_get_shadow_caster_mask(p_instance->base))) {
-							continue;
-						} else {
-							if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-								animated_material_found = true;
-							}
-							if (instance->mesh_instance.is_valid()) {
-								RSG::mesh_storage->mesh_instance_check_for_update(instance->mesh_instance);
-							}
-						}
+	RENDER_TIMESTAMP("Cull Light3D Shadows");
 
-						shadow_data.instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
-					}
+	uint32_t pending_jobs = 0;
+	for (const ShadowCullJob &job : shadow_cull_jobs) {
+		if (!job.cached) {
+			pending_jobs++;
+		}
+	}
 
-					RSG::mesh_storage->update_mesh_instances();
-					RSG::light_storage->light_instance_set_shadow_transform(light->instance, cm, xform, radius, 0, i, 0);
+	// Querying the geometry indexer is read-only, so every light pass can be culled on its own thread.
+	if (pending_jobs > 1 && WorkerThreadPool::get_singleton()->get_thread_count() > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererSceneCull::_shadow_cull_job, shadow_cull_jobs.ptr(), shadow_cull_jobs.size(), -1, true, SNAME("RenderShadowCull"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else if (pending_jobs > 0) {
+		for (uint32_t i = 0; i < shadow_cull_jobs.size(); i++) {
+			_shadow_cull_job(i, shadow_cull_jobs.ptr());
+		}
+	}
 
-					shadow_data.light = light->instance;
-					shadow_data.pass = i;
-				}
+	// Tighter caster culling, filtering and mesh instance updates are not thread safe, finish serially.
+	Instance *prepared_light = nullptr;
 
-				//restore the regular DP matrix
-				//RSG::light_storage->light_instance_set_shadow_transform(light->instance, Projection(), light_transform, radius, 0, 0, 0);
-			}
+	for (ShadowCullJob &job : shadow_cull_jobs) {
+		InstanceLightData *light = static_cast<InstanceLightData *>(job.light->base_data);
 
-		} break;
-		case RS::LIGHT_SPOT: {
-			RENDER_TIMESTAMP("Cull SpotLight3D Shadow");
+		instance_shadow_cull_result.clear();
+		for (Instance *instance : light->shadow_caster_cache.casters[job.pass]) {
+			instance_shadow_cull_result.push_back(instance);
+		}
 
-			if (max_shadows_used + 1 > MAX_UPDATE_SHADOWS) {
-				return true;
+		if (!light->is_shadow_update_full()) {
+			if (prepared_light != job.light) {
+				light_culler->prepare_regular_light(*job.light);
+				prepared_light = job.light;
 			}
+			light_culler->cull_regular_light(instance_shadow_cull_result);
+		}
 
-			real_t radius = RSG::light_storage->light_get_param(p_instance->base, RS::LIGHT_PARAM_RANGE);
-			real_t angle = RSG::light_storage->light_get_param(p_instance->base, RS::LIGHT_PARAM_SPOT_ANGLE);
-			real_t z_near = MIN(0.025f, radius);
-
-			Projection cm;
-			cm.set_perspective(angle * 2.0, 1.0, z_near, radius);
-
-			Vector<Plane> planes = cm.get_projection_planes(light_transform);
-
-			instance_shadow_cull_result.clear();
-
-			Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
+		RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[job.shadow_index];
+		uint32_t caster_mask = RSG::light_storage->light_get_shadow_caster_mask(job.light->base);
 
-			struct CullConvex {
-				PagedArray<Instance *> *result;
-				_FORCE_INLINE_ bool operator()(void *p_data) {
-					Instance *p_instance = (Instance *)p_data;
-					result->push_back(p_instance);
-					return false;
+		for (uint32_t j = 0; j < instance_shadow_cull_result.size(); j++) {
+			Instance *instance = instance_shadow_cull_result[j];
+			if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || !(p_visible_layers & instance->layer_mask & caster_mask)) {
+				continue;
+			} else {
+				if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
+					job.animated_material_found = true;
 				}
-			};
-
-			CullConvex cull_convex;
-			cull_convex.result = &instance_shadow_cull_result;
 
-			p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(planes.ptr(), planes.size(), points.ptr(), points.size(), cull_convex);
-
-			RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
-
-			if (!light->is_shadow_update_full()) {
-				light_culler->cull_regular_light(instance_shadow_cull_result);
-			}
-
-			for (int j = 0; j < (int)instance_shadow_cull_result.size(); j++) {
-				Instance *instance = instance_shadow_cull_result[j];
-				if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || !(p_visible_layers & instance->layer_mask & RSG::light_storage->light_get_shadow_caster_mask(p_instance->base))) {
-					continue;
-				} else {
-					if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-						animated_material_found = true;
-					}
-
-					if (instance->mesh_instance.is_valid()) {
-						RSG::mesh_storage->mesh_instance_check_for_update(instance->mesh_instance);
-					}
+				if (instance->mesh_instance.is_valid()) {
+					RSG::mesh_storage->mesh_instance_check_for_update(instance->mesh_instance);
 				}
-				shadow_data.instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
 			}
 
-			RSG::mesh_storage->update_mesh_instances();
+			shadow_data.instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
+		}
 
-			RSG::light_storage->light_instance_set_shadow_transform(light->instance, cm, light_transform, radius, 0, 0, 0);
-			shadow_data.light = light->instance;
-			shadow_data.pass = 0;
+		RSG::light_storage->light_instance_set_shadow_transform(light->instance, job.projection, job.transform, job.radius, 0, job.pass, 0);
+		shadow_data.light = light->instance;
+		shadow_data.pass = job.pass;
+	}
 
-		} break;
+	RSG::mesh_storage->update_mesh_instances();
+
+	// Done after all passes, so the dirty state doesn't change between passes of the same light.
+	for (const ShadowCullJob &job : shadow_cull_jobs) {
+		if (job.animated_material_found) {
+			static_cast<InstanceLightData *>(job.light->base_data)->make_shadow_dirty();
+		}
 	}
 
-	return animated_material_found;
+	shadow_cull_jobs.clear();
 }
 
 void RendererSceneCull::render_camera(const Ref<RenderSceneBuffers> &p_render_buffers, RID p_camera, RID p_scenario, RID p_viewport, Size2 p_viewport_size, uint32_t p_jitter_phase_count, float p_screen_mesh_lod_threshold, RID p_shadow_atlas, Ref<XRInterface> &p_xr_interface, RenderInfo *r_render_info) {
@@ -2826,6 +2889,8 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 	float z_near = cull_data.camera_matrix->get_z_near();
 	bool is_orthogonal = cull_data.camera_matrix->is_orthogonal();
 
+	uint32_t frustum_plane_tests = 0;
+
 	for (uint64_t i = p_from; i < p_to; i++) {
 		bool mesh_visible = false;
 
@@ -2842,7 +2907,7 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 #define OCCLUSION_CULLED (cull_data.occlusion_buffer != nullptr && (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_OCCLUSION_CULLING) == 0 && cull_data.occlusion_buffer->is_occluded(cull_data.scenario->instance_aabbs[i].bounds, cull_data.cam_transform.origin, inv_cam_transform, *cull_data.camera_matrix, z_near, is_orthogonal, cull_data.scenario->instance_data[i].occlusion_timeout))
 
 		if (!HIDDEN_BY_VISIBILITY_CHECKS) {
-			if ((LAYER_CHECK && IN_FRUSTUM(cull_data.cull->frustum) && VIS_CHECK && !OCCLUSION_CULLED) || (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING)) {
+			if ((LAYER_CHECK && _in_camera_frustum(cull_data, cull_data.scenario->instance_aabbs[i], idata, frustum_plane_tests) && VIS_CHECK && !OCCLUSION_CULLED) || (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING)) {
 				uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
 				if (base_type == RS::INSTANCE_LIGHT) {
 					cull_result.lights.push_back(idata.instance);
@@ -3092,6 +3157,8 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 			cull_result.mesh_instances.push_back(cull_data.scenario->instance_data[i].instance->mesh_instance);
 		}
 	}
+
+	frustum_plane_tests_in_frame.add(frustum_plane_tests);
 }
 
 void RendererSceneCull::_scene_particles_set_view_axis(RID p_particles, const Vector3 &p_axis, const Vector3 &p_up_axis) {
@@ -3235,6 +3302,8 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 		cull_data.occlusion_buffer = RendererSceneOcclusionCull::get_singleton()->buffer_get_ptr(p_viewport);
 		cull_data.camera_matrix = &p_camera_data->main_projection;
 		cull_data.visibility_viewport_mask = scenario->viewport_visibility_masks.has(p_viewport) ? scenario->viewport_visibility_masks[p_viewport] : 0;
+		// Reflection probes render six unrelated faces in a row, which would only thrash the plane hints.
+		cull_data.frustum_plane_hint_slot = (temporal_coherent_culling && render_reflection_probe == nullptr) ? _get_frustum_plane_hint_slot(scenario, p_viewport) : -1;
 //#define DEBUG_CULL_TIME
 #ifdef DEBUG_CULL_TIME
 		uint64_t time_from = OS::get_singleton()->get_ticks_usec();
@@ -3412,17 +3481,17 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 
 			if (redraw && max_shadows_used < MAX_UPDATE_SHADOWS) {
 				//must redraw!
-				RENDER_TIMESTAMP("> Render Light3D " + itos(i));
-				if (_light_instance_update_shadow(ins, p_camera_data->main_transform, p_camera_data->main_projection, p_camera_data->is_orthogonal, p_camera_data->vaspect, p_shadow_atlas, scenario, p_screen_mesh_lod_threshold, p_visible_layers)) {
+				if (_light_instance_queue_shadow_cull(ins, scenario)) {
 					light->make_shadow_dirty();
 				}
-				RENDER_TIMESTAMP("< Render Light3D " + itos(i));
 			} else {
 				if (redraw) {
 					light->make_shadow_dirty();
 				}
 			}
 		}
+
+		_light_instances_cull_shadows(p_visible_layers);
 	}
 
 	//render SDFGI
@@ -3936,7 +4005,7 @@ void RendererSceneCull::render_particle_colliders() {
 	}
 }
 
-void RendererSceneCull::_update_dirty_instance(Instance *p_instance) const {
+void RendererSceneCull::_update_dirty_instance_data(Instance *p_instance) const {
 	if (p_instance->update_aabb) {
 		_update_instance_aabb(p_instance);
 	}
@@ -4132,17 +4201,46 @@ void RendererSceneCull::_update_dirty_instance(Instance *p_instance) const {
 	}
 
 	_instance_update_list.remove(&p_instance->update_item);
+}
 
-	_update_instance(p_instance);
+void RendererSceneCull::_update_dirty_instance_finish(Instance *p_instance, const DirtyInstanceBounds *p_bounds) const {
+	_update_instance(p_instance, p_bounds);
 
 	p_instance->teleported = false;
 	p_instance->update_aabb = false;
 	p_instance->update_dependencies = false;
 }
 
+void RendererSceneCull::_update_dirty_instance(Instance *p_instance) const {
+	_update_dirty_instance_data(p_instance);
+	_update_dirty_instance_finish(p_instance);
+}
+
 void RendererSceneCull::update_dirty_instances() const {
+	// Updating instances can queue others again (e.g. geometry captured by a lightmap that moved), so go in rounds.
 	while (_instance_update_list.first()) {
-		_update_dirty_instance(_instance_update_list.first()->self());
+		dirty_instance_bounds.clear();
+		while (_instance_update_list.first()) {
+			Instance *instance = _instance_update_list.first()->self();
+			_update_dirty_instance_data(instance);
+			dirty_instance_bounds.push_back({ instance });
+		}
+
+		if (dirty_instance_bounds.size() <= thread_cull_threshold) {
+			for (const DirtyInstanceBounds &bounds : dirty_instance_bounds) {
+				_update_dirty_instance_finish(bounds.instance);
+			}
+			continue;
+		}
+
+		// Bounds, lightmap SH sampling and geometry instance transforms only depend on each instance, so they run in parallel.
+		// Everything touching the storages, the scenario arrays, the BVHs and pairing stays serial.
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererSceneCull::_compute_dirty_instance_bounds, dirty_instance_bounds.ptr(), dirty_instance_bounds.size(), -1, true, SNAME("RenderDirtyInstanceBounds"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		for (const DirtyInstanceBounds &bounds : dirty_instance_bounds) {
+			_update_dirty_instance_finish(bounds.instance, &bounds);
+		}
 	}
 
 	// Update dirty resources after dirty instances as instance updates may affect resources.
@@ -4150,6 +4248,8 @@ void RendererSceneCull::update_dirty_instances() const {
 }
 
 void RendererSceneCull::update() {
+	frustum_plane_tests_in_frame.set(0);
+
 	//optimize bvhs
 
 	uint32_t rid_count = scenario_owner.get_rid_count();
@@ -4297,9 +4397,16 @@ RendererSceneCull::RendererSceneCull() {
 	indexer_update_iterations = GLOBAL_GET("rendering/limits/spatial_indexer/update_iterations_per_frame");
 	thread_cull_threshold = GLOBAL_GET("rendering/limits/spatial_indexer/threaded_cull_minimum_instances");
 	thread_cull_threshold = MAX(thread_cull_threshold, (uint32_t)WorkerThreadPool::get_singleton()->get_thread_count()); //make sure there is at least one thread per CPU
+	temporal_coherent_culling = GLOBAL_GET("rendering/limits/spatial_indexer/temporal_coherent_culling");
 	RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled = GLOBAL_GET("rendering/occlusion_culling/jitter_projection");
 
-	dummy_occlusion_culling = memnew(RendererSceneOcclusionCull);
+	// The raster backend is opt-in. Otherwise occlusion culling stays disabled unless a module
+	// registers a backend later on (e.g. the raycast module, when Embree is available).
+	if (int(GLOBAL_GET("rendering/occlusion_culling/backend")) == 1) {
+		default_occlusion_culling = memnew(RasterOcclusionCull);
+	} else {
+		default_occlusion_culling = memnew(RendererSceneOcclusionCull);
+	}
 
 	light_culler = memnew(RenderingLightCuller);
 
@@ -4325,8 +4432,8 @@ RendererSceneCull::~RendererSceneCull() {
 	}
 	scene_cull_result_threads.clear();
 
-	if (dummy_occlusion_culling) {
-		memdelete(dummy_occlusion_culling);
+	if (default_occlusion_culling) {
+		memdelete(default_occlusion_culling);
 	}
 
 	if (light_culler) {
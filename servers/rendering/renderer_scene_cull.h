@@ -125,7 +125,7 @@ public:
 
 	/* VISIBILITY NOTIFIER API */
 
-	RendererSceneOcclusionCull *dummy_occlusion_culling = nullptr;
+	RendererSceneOcclusionCull *default_occlusion_culling = nullptr;
 
 	/* SCENARIO API */
 
@@ -224,6 +224,42 @@ public:
 
 			return true;
 		}
+		// Same as in_frustum(), but tests the plane hint first. The hint is the index plus one of the plane that
+		// rejected the bounds last time (zero if none), and is likely to reject them again while the camera moves coherently.
+		_ALWAYS_INLINE_ bool in_frustum_coherent(const Frustum &p_frustum, uint32_t &r_plane_hint, uint32_t &r_plane_tests) const {
+			if (r_plane_hint > 0 && r_plane_hint <= p_frustum.plane_count) {
+				const uint32_t i = r_plane_hint - 1;
+				Vector3 min(
+						bounds[p_frustum.plane_signs_ptr[i].signs[0]],
+						bounds[p_frustum.plane_signs_ptr[i].signs[1]],
+						bounds[p_frustum.plane_signs_ptr[i].signs[2]]);
+
+				r_plane_tests++;
+				if (p_frustum.planes_ptr[i].distance_to(min) >= 0.0) {
+					return false;
+				}
+			}
+
+			for (uint32_t i = 0; i < p_frustum.plane_count; i++) {
+				if (i + 1 == r_plane_hint) {
+					continue;
+				}
+
+				Vector3 min(
+						bounds[p_frustum.plane_signs_ptr[i].signs[0]],
+						bounds[p_frustum.plane_signs_ptr[i].signs[1]],
+						bounds[p_frustum.plane_signs_ptr[i].signs[2]]);
+
+				r_plane_tests++;
+				if (p_frustum.planes_ptr[i].distance_to(min) >= 0.0) {
+					r_plane_hint = i + 1;
+					return false;
+				}
+			}
+
+			r_plane_hint = 0;
+			return true;
+		}
 		_ALWAYS_INLINE_ bool in_aabb(const AABB &p_aabb) const {
 			Vector3 end = p_aabb.position + p_aabb.size;
 
@@ -277,6 +313,9 @@ public:
 			FLAG_IGNORE_ALL_CULLING = (1 << 24),
 		};
 
+		// Viewports that get their own camera frustum plane hint, 4 bits each in frustum_plane_hints.
+		static constexpr uint32_t FRUSTUM_PLANE_HINT_SLOTS = 8;
+
 		uint32_t flags = 0;
 		uint32_t layer_mask = 0; //for fast layer-mask discard
 		RID base_rid;
@@ -288,6 +327,8 @@ public:
 		Instance *instance = nullptr;
 		int32_t parent_array_index = -1;
 		int32_t visibility_index = -1;
+		// Plane hints for InstanceBounds::in_frustum_coherent(), one per viewport slot (see Scenario::frustum_plane_hint_slots).
+		uint32_t frustum_plane_hints = 0;
 
 		// Each time occlusion culling determines an instance is visible,
 		// set this to occlusion_frame plus some delay.
@@ -343,6 +384,9 @@ public:
 		RID reflection_atlas;
 		uint64_t used_viewport_visibility_bits;
 		HashMap<RID, uint64_t> viewport_visibility_masks;
+		// Viewports rendering this scenario and their slot in InstanceData::frustum_plane_hints, so each camera keeps its own hints.
+		HashMap<RID, uint32_t> frustum_plane_hint_slots;
+		uint32_t used_frustum_plane_hint_slots = 0;
 
 		SelfList<Instance>::List instances;
 
@@ -352,6 +396,8 @@ public:
 		PagedArray<InstanceData> instance_data;
 		VisibilityArray instance_visibility;
 
+		uint64_t geometry_version = 1; // Changes whenever the geometry indexer changes.
+
 		Scenario() {
 			indexers[INDEXER_GEOMETRY].set_index(INDEXER_GEOMETRY);
 			indexers[INDEXER_VOLUMES].set_index(INDEXER_VOLUMES);
@@ -704,6 +750,24 @@ public:
 		uint32_t max_sdfgi_cascade = 2;
 		uint32_t cull_mask = 0xFFFFFFFF;
 
+		// Shadow casters found in the geometry indexer for each pass on the last update,
+		// reused while the light volume and the scenario geometry version stay the same.
+		struct ShadowCasterCache {
+			LocalVector<Instance *> casters[6];
+			Transform3D transform;
+			real_t range = 0;
+			real_t spot_angle = 0;
+			uint32_t pass_count = 0;
+			uint64_t geometry_version = 0;
+
+			void clear() {
+				for (LocalVector<Instance *> &pass_casters : casters) {
+					pass_casters.reset();
+				}
+				pass_count = 0;
+			}
+		} shadow_caster_cache;
+
 	private:
 		// Instead of a single dirty flag, we maintain a count
 		// so that we can detect lights that are being made dirty
@@ -1009,6 +1073,8 @@ public:
 	RendererSceneRender::RenderSDFGIUpdateData sdfgi_update_data;
 
 	uint32_t thread_cull_threshold = 200;
+	bool temporal_coherent_culling = true;
+	SafeNumeric<uint64_t> frustum_plane_tests_in_frame;
 
 	mutable RID_Owner<Instance, true> instance_owner{ 65536, 4194304 };
 
@@ -1068,16 +1134,50 @@ public:
 
 	virtual void mesh_generate_pipelines(RID p_mesh, bool p_background_compilation);
 	virtual uint32_t get_pipeline_compilations(RS::PipelineSource p_source);
+	virtual uint64_t get_frustum_plane_tests_in_frame() const;
+
+	// Bounds of a dirty instance, computed ahead on worker threads when many instances are updated at once.
+	struct DirtyInstanceBounds {
+		Instance *instance = nullptr;
+		AABB transformed_aabb;
+		AABB bvh_aabb;
+		bool lightmap_captures_computed = false;
+		bool geometry_transform_set = false;
+	};
+	mutable LocalVector<DirtyInstanceBounds> dirty_instance_bounds;
+
+	static _FORCE_INLINE_ AABB _get_instance_bvh_aabb(const Instance *p_instance, const AABB &p_transformed_aabb);
+	void _compute_dirty_instance_bounds(uint32_t p_index, DirtyInstanceBounds *p_bounds) const;
 
-	_FORCE_INLINE_ void _update_instance(Instance *p_instance) const;
+	_FORCE_INLINE_ void _update_instance(Instance *p_instance, const DirtyInstanceBounds *p_bounds = nullptr) const;
 	_FORCE_INLINE_ void _update_instance_aabb(Instance *p_instance) const;
+	_FORCE_INLINE_ void _update_dirty_instance_data(Instance *p_instance) const;
+	_FORCE_INLINE_ void _update_dirty_instance_finish(Instance *p_instance, const DirtyInstanceBounds *p_bounds = nullptr) const;
 	_FORCE_INLINE_ void _update_dirty_instance(Instance *p_instance) const;
+	_FORCE_INLINE_ void _compute_instance_lightmap_captures(Instance *p_instance) const;
 	_FORCE_INLINE_ void _update_instance_lightmap_captures(Instance *p_instance) const;
 	void _unpair_instance(Instance *p_instance);
 
 	void _light_instance_setup_directional_shadow(int p_shadow_index, Instance *p_instance, const Transform3D p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect);
 
-	_FORCE_INLINE_ bool _light_instance_update_shadow(Instance *p_instance, const Transform3D p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, RID p_shadow_atlas, Scenario *p_scenario, float p_screen_mesh_lod_threshold, uint32_t p_visible_layers = 0xFFFFFF);
+	struct ShadowCullJob {
+		Instance *light = nullptr;
+		Scenario *scenario = nullptr;
+		uint32_t pass = 0;
+		uint32_t shadow_index = 0;
+		bool cached = false;
+		bool animated_material_found = false;
+		real_t radius = 0;
+		Projection projection;
+		Transform3D transform;
+		Vector<Plane> planes;
+	};
+
+	LocalVector<ShadowCullJob> shadow_cull_jobs;
+
+	bool _light_instance_queue_shadow_cull(Instance *p_instance, Scenario *p_scenario);
+	void _shadow_cull_job(uint32_t p_index, ShadowCullJob *p_jobs);
+	void _light_instances_cull_shadows(uint32_t p_visible_layers);
 
 	RID _render_get_environment(RID p_camera, RID p_scenario);
 	RID _render_get_compositor(RID p_camera, RID p_scenario);
@@ -1144,12 +1244,30 @@ public:
 		const RendererSceneOcclusionCull::HZBuffer *occlusion_buffer;
 		const Projection *camera_matrix;
 		uint64_t visibility_viewport_mask;
+		int32_t frustum_plane_hint_slot = -1; // -1 disables the plane hints for this pass.
 	};
 
 	void _scene_cull_threaded(uint32_t p_thread, CullData *cull_data);
 	void _scene_cull(CullData &cull_data, InstanceCullResult &cull_result, uint64_t p_from, uint64_t p_to);
 	static void _scene_particles_set_view_axis(RID p_particles, const Vector3 &p_axis, const Vector3 &p_up_axis);
 	_FORCE_INLINE_ bool _visibility_parent_check(const CullData &p_cull_data, const InstanceData &p_instance_data);
+	int32_t _get_frustum_plane_hint_slot(Scenario *p_scenario, RID p_viewport);
+	_FORCE_INLINE_ bool _in_camera_frustum(const CullData &p_cull_data, const InstanceBounds &p_bounds, InstanceData &r_instance_data, uint32_t &r_plane_tests) {
+		if (p_cull_data.frustum_plane_hint_slot < 0) {
+			uint32_t plane_hint = 0;
+			return p_bounds.in_frustum_coherent(p_cull_data.cull->frustum, plane_hint, r_plane_tests);
+		}
+
+		const uint32_t shift = p_cull_data.frustum_plane_hint_slot * 4;
+		const uint32_t prev_plane_hint = (r_instance_data.frustum_plane_hints >> shift) & 0xF;
+		uint32_t plane_hint = prev_plane_hint;
+		const bool inside = p_bounds.in_frustum_coherent(p_cull_data.cull->frustum, plane_hint, r_plane_tests);
+		plane_hint = plane_hint <= 0xF ? plane_hint : 0;
+		if (plane_hint != prev_plane_hint) {
+			r_instance_data.frustum_plane_hints = (r_instance_data.frustum_plane_hints & ~(0xFu << shift)) | (plane_hint << shift);
+		}
+		return inside;
+	}
 
 	bool _render_reflection_probe_step(Instance *p_instance, int p_step);
 
@@ -121,6 +121,7 @@ public:
 
 	virtual void mesh_generate_pipelines(RID p_mesh, bool p_background_compilation) = 0;
 	virtual uint32_t get_pipeline_compilations(RS::PipelineSource p_source) = 0;
+	virtual uint64_t get_frustum_plane_tests_in_frame() const = 0;
 
 	/* SKY API */
 
@@ -1813,6 +1813,7 @@ public:
 		RENDERING_INFO_PIPELINE_COMPILATIONS_SURFACE,
 		RENDERING_INFO_PIPELINE_COMPILATIONS_DRAW,
 		RENDERING_INFO_PIPELINE_COMPILATIONS_SPECIALIZATION,
+		RENDERING_INFO_TOTAL_FRUSTUM_PLANE_TESTS_IN_FRAME,
 		RENDERING_INFO_MAX
 	};
 
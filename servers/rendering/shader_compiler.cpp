@@ -30,6 +30,9 @@
 
 #include "shader_compiler.h"
 
+#include "core/config/engine.h"
+#include "core/io/file_access.h"
+#include "core/version.h"
 #include "servers/rendering/rendering_server_globals.h"
 #include "servers/rendering/shader_types.h"
 
@@ -1484,7 +1487,325 @@ ShaderLanguage::DataType ShaderCompiler::_get_global_shader_uniform_type(const S
 	return (ShaderLanguage::DataType)RS::global_shader_uniform_type_get_shader_datatype(gvt);
 }
 
+String ShaderCompiler::compile_cache_dir;
+
+static const char *compile_cache_file_header = "GDCC";
+static const uint32_t compile_cache_file_version = 1;
+
+String ShaderCompiler::_get_compile_cache_path(RS::ShaderMode p_mode, const String &p_code, const IdentifierActions *p_actions) const {
+	String key = compile_cache_config_hash + "\n" + itos(p_mode) + "\n";
+	for (const KeyValue<StringName, Stage> &E : p_actions->entry_point_stages) {
+		key += String(E.key) + ":" + itos(E.value) + "\n";
+	}
+	for (const KeyValue<StringName, bool *> &E : p_actions->usage_flag_pointers) {
+		key += String(E.key) + "\n";
+	}
+	for (const KeyValue<StringName, bool *> &E : p_actions->write_flag_pointers) {
+		key += String(E.key) + "\n";
+	}
+	key += p_code;
+
+	return compile_cache_dir.path_join(key.sha1_text() + ".cache");
+}
+
+static void _store_strings(const Ref<FileAccess> &p_file, const Vector<String> &p_strings) {
+	p_file->store_32(p_strings.size());
+	for (const String &string : p_strings) {
+		p_file->store_pascal_string(string);
+	}
+}
+
+static Vector<String> _get_strings(const Ref<FileAccess> &p_file) {
+	Vector<String> strings;
+	uint32_t count = p_file->get_32();
+	for (uint32_t i = 0; i < count && !p_file->eof_reached(); i++) {
+		strings.push_back(p_file->get_pascal_string());
+	}
+	return strings;
+}
+
+static void _store_string_names(const Ref<FileAccess> &p_file, const Vector<StringName> &p_names) {
+	p_file->store_32(p_names.size());
+	for (const StringName &name : p_names) {
+		p_file->store_pascal_string(name);
+	}
+}
+
+static Vector<StringName> _get_string_names(const Ref<FileAccess> &p_file) {
+	Vector<StringName> names;
+	uint32_t count = p_file->get_32();
+	for (uint32_t i = 0; i < count && !p_file->eof_reached(); i++) {
+		names.push_back(p_file->get_pascal_string());
+	}
+	return names;
+}
+
+void ShaderCompiler::_save_compile_cache_entry(const String &p_path, const CompileCacheEntry &p_entry) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+	ERR_FAIL_COND_MSG(f.is_null(), vformat("Unable to write shader compiler cache file at %s.", p_path));
+
+	f->store_buffer((const uint8_t *)compile_cache_file_header, 4);
+	f->store_32(compile_cache_file_version);
+
+	const GeneratedCode &gen_code = p_entry.gen_code;
+	_store_strings(f, gen_code.defines);
+	f->store_32(gen_code.texture_uniforms.size());
+	for (const GeneratedCode::Texture &texture : gen_code.texture_uniforms) {
+		f->store_pascal_string(texture.name);
+		f->store_32(texture.type);
+		f->store_32(texture.hint);
+		f->store_8(texture.use_color);
+		f->store_32(texture.filter);
+		f->store_32(texture.repeat);
+		f->store_8(texture.global);
+		f->store_32(texture.array_size);
+	}
+	f->store_32(gen_code.uniform_offsets.size());
+	for (uint32_t offset : gen_code.uniform_offsets) {
+		f->store_32(offset);
+	}
+	f->store_32(gen_code.uniform_total_size);
+	f->store_pascal_string(gen_code.uniforms);
+	for (int i = 0; i < STAGE_MAX; i++) {
+		f->store_pascal_string(gen_code.stage_globals[i]);
+	}
+	f->store_32(gen_code.code.size());
+	for (const KeyValue<String, String> &E : gen_code.code) {
+		f->store_pascal_string(E.key);
+		f->store_pascal_string(E.value);
+	}
+	f->store_8(gen_code.uses_global_textures);
+	f->store_8(gen_code.uses_fragment_time);
+	f->store_8(gen_code.uses_vertex_time);
+	f->store_8(gen_code.uses_screen_texture_mipmaps);
+	f->store_8(gen_code.uses_screen_texture);
+	f->store_8(gen_code.uses_depth_texture);
+	f->store_8(gen_code.uses_normal_roughness_texture);
+
+	_store_string_names(f, p_entry.render_modes);
+	_store_string_names(f, p_entry.stencil_modes);
+	f->store_32(p_entry.stencil_reference);
+	_store_string_names(f, p_entry.used_flags);
+	_store_string_names(f, p_entry.written_flags);
+
+	f->store_32(p_entry.uniforms.size());
+	for (const KeyValue<StringName, SL::ShaderNode::Uniform> &E : p_entry.uniforms) {
+		const SL::ShaderNode::Uniform &uniform = E.value;
+		f->store_pascal_string(E.key);
+		f->store_32(uniform.order);
+		f->store_32(uniform.prop_order);
+		f->store_32(uniform.texture_order);
+		f->store_32(uniform.texture_binding);
+		f->store_32(uniform.type);
+		f->store_32(uniform.precision);
+		f->store_32(uniform.array_size);
+		f->store_32(uniform.default_value.size());
+		for (const SL::Scalar &value : uniform.default_value) {
+			f->store_32(value.uint);
+		}
+		f->store_32(uniform.scope);
+		f->store_32(uniform.hint);
+		f->store_8(uniform.use_color);
+		f->store_32(uniform.filter);
+		f->store_32(uniform.repeat);
+		for (int i = 0; i < 3; i++) {
+			f->store_float(uniform.hint_range[i]);
+		}
+		_store_strings(f, uniform.hint_enum_names);
+		f->store_32(uniform.instance_index);
+		f->store_pascal_string(uniform.group);
+		f->store_pascal_string(uniform.subgroup);
+	}
+
+	f->store_32(p_entry.global_uniform_types.size());
+	for (const KeyValue<StringName, SL::DataType> &E : p_entry.global_uniform_types) {
+		f->store_pascal_string(E.key);
+		f->store_32(E.value);
+	}
+}
+
+bool ShaderCompiler::_load_compile_cache_entry(const String &p_path, CompileCacheEntry &r_entry) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ);
+	if (f.is_null()) {
+		return false;
+	}
+
+	char header[5] = { 0, 0, 0, 0, 0 };
+	f->get_buffer((uint8_t *)header, 4);
+	ERR_FAIL_COND_V(header != String(compile_cache_file_header), false);
+
+	if (f->get_32() != compile_cache_file_version) {
+		return false; // Wrong version, compile again and overwrite it.
+	}
+
+	GeneratedCode &gen_code = r_entry.gen_code;
+	gen_code.defines = _get_strings(f);
+	uint32_t texture_count = f->get_32();
+	for (uint32_t i = 0; i < texture_count && !f->eof_reached(); i++) {
+		GeneratedCode::Texture texture;
+		texture.name = f->get_pascal_string();
+		texture.type = SL::DataType(f->get_32());
+		texture.hint = SL::ShaderNode::Uniform::Hint(f->get_32());
+		texture.use_color = f->get_8();
+		texture.filter = SL::TextureFilter(f->get_32());
+		texture.repeat = SL::TextureRepeat(f->get_32());
+		texture.global = f->get_8();
+		texture.array_size = f->get_32();
+		gen_code.texture_uniforms.push_back(texture);
+	}
+	uint32_t offset_count = f->get_32();
+	for (uint32_t i = 0; i < offset_count && !f->eof_reached(); i++) {
+		gen_code.uniform_offsets.push_back(f->get_32());
+	}
+	gen_code.uniform_total_size = f->get_32();
+	gen_code.uniforms = f->get_pascal_string();
+	for (int i = 0; i < STAGE_MAX; i++) {
+		gen_code.stage_globals[i] = f->get_pascal_string();
+	}
+	uint32_t code_count = f->get_32();
+	for (uint32_t i = 0; i < code_count && !f->eof_reached(); i++) {
+		String name = f->get_pascal_string();
+		gen_code.code[name] = f->get_pascal_string();
+	}
+	gen_code.uses_global_textures = f->get_8();
+	gen_code.uses_fragment_time = f->get_8();
+	gen_code.uses_vertex_time = f->get_8();
+	gen_code.uses_screen_texture_mipmaps = f->get_8();
+	gen_code.uses_screen_texture = f->get_8();
+	gen_code.uses_depth_texture = f->get_8();
+	gen_code.uses_normal_roughness_texture = f->get_8();
+
+	r_entry.render_modes = _get_string_names(f);
+	r_entry.stencil_modes = _get_string_names(f);
+	r_entry.stencil_reference = int32_t(f->get_32());
+	r_entry.used_flags = _get_string_names(f);
+	r_entry.written_flags = _get_string_names(f);
+
+	uint32_t uniform_count = f->get_32();
+	for (uint32_t i = 0; i < uniform_count && !f->eof_reached(); i++) {
+		StringName name = f->get_pascal_string();
+		SL::ShaderNode::Uniform uniform;
+		uniform.order = int32_t(f->get_32());
+		uniform.prop_order = int32_t(f->get_32());
+		uniform.texture_order = int32_t(f->get_32());
+		uniform.texture_binding = int32_t(f->get_32());
+		uniform.type = SL::DataType(f->get_32());
+		uniform.precision = SL::DataPrecision(f->get_32());
+		uniform.array_size = f->get_32();
+		uint32_t value_count = f->get_32();
+		for (uint32_t j = 0; j < value_count && !f->eof_reached(); j++) {
+			SL::Scalar value;
+			value.uint = f->get_32();
+			uniform.default_value.push_back(value);
+		}
+		uniform.scope = SL::ShaderNode::Uniform::Scope(f->get_32());
+		uniform.hint = SL::ShaderNode::Uniform::Hint(f->get_32());
+		uniform.use_color = f->get_8();
+		uniform.filter = SL::TextureFilter(f->get_32());
+		uniform.repeat = SL::TextureRepeat(f->get_32());
+		for (int j = 0; j < 3; j++) {
+			uniform.hint_range[j] = f->get_float();
+		}
+		uniform.hint_enum_names = _get_strings(f);
+		uniform.instance_index = f->get_32();
+		uniform.group = f->get_pascal_string();
+		uniform.subgroup = f->get_pascal_string();
+		r_entry.uniforms[name] = uniform;
+	}
+
+	uint32_t global_count = f->get_32();
+	for (uint32_t i = 0; i < global_count && !f->eof_reached(); i++) {
+		StringName name = f->get_pascal_string();
+		r_entry.global_uniform_types[name] = SL::DataType(f->get_32());
+	}
+
+	// A truncated file reads past the end, compile again and overwrite it.
+	return f->get_error() == OK;
+}
+
+bool ShaderCompiler::_are_global_uniform_types_current(const CompileCacheEntry &p_entry) {
+	for (const KeyValue<StringName, SL::DataType> &E : p_entry.global_uniform_types) {
+		if (_get_global_shader_uniform_type(E.key) != E.value) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void ShaderCompiler::_apply_cached_actions(const CompileCacheEntry &p_entry, IdentifierActions *p_actions) const {
+	for (const StringName &mode : p_entry.render_modes) {
+		if (p_actions->render_mode_flags.has(mode)) {
+			*p_actions->render_mode_flags[mode] = true;
+		}
+
+		if (p_actions->render_mode_values.has(mode)) {
+			Pair<int *, int> &p = p_actions->render_mode_values[mode];
+			*p.first = p.second;
+		}
+	}
+
+	for (const StringName &mode : p_entry.stencil_modes) {
+		if (p_actions->stencil_mode_values.has(mode)) {
+			Pair<int *, int> &p = p_actions->stencil_mode_values[mode];
+			*p.first = p.second;
+		}
+	}
+
+	if (p_actions->stencil_reference && p_entry.stencil_reference != -1) {
+		*p_actions->stencil_reference = p_entry.stencil_reference;
+	}
+
+	for (const StringName &flag : p_entry.used_flags) {
+		if (p_actions->usage_flag_pointers.has(flag)) {
+			*p_actions->usage_flag_pointers[flag] = true;
+		}
+	}
+
+	for (const StringName &flag : p_entry.written_flags) {
+		if (p_actions->write_flag_pointers.has(flag)) {
+			*p_actions->write_flag_pointers[flag] = true;
+		}
+	}
+
+	if (p_actions->uniforms) {
+		for (const KeyValue<StringName, SL::ShaderNode::Uniform> &E : p_entry.uniforms) {
+			p_actions->uniforms->insert(E.key, E.value);
+		}
+	}
+}
+
 Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) {
+	CompileCacheKey cache_key;
+	cache_key.mode = p_mode;
+	cache_key.code = p_code;
+
+	const CompileCacheEntry *cached = compile_cache.getptr(cache_key);
+	if (cached) {
+		// The parser only validates global uniform types in the editor, so only check them there.
+		if (!Engine::get_singleton()->is_editor_hint() || _are_global_uniform_types_current(*cached)) {
+			r_gen_code = cached->gen_code;
+			_apply_cached_actions(*cached, p_actions);
+			return OK;
+		}
+
+		// Compile again so the error is reported.
+		compile_cache.erase(cache_key);
+	}
+
+	String cache_path;
+	if (!compile_cache_dir.is_empty()) {
+		cache_path = _get_compile_cache_path(p_mode, p_code, p_actions);
+
+		// Global uniforms may have changed since the file was saved, so always check them.
+		CompileCacheEntry entry;
+		if (_load_compile_cache_entry(cache_path, entry) && _are_global_uniform_types_current(entry)) {
+			r_gen_code = entry.gen_code;
+			_apply_cached_actions(entry, p_actions);
+			compile_cache.insert(cache_key, entry);
+			return OK;
+		}
+	}
+
 	SL::ShaderCompileInfo info;
 	info.functions = ShaderTypes::get_singleton()->get_functions(p_mode);
 	info.render_modes = ShaderTypes::get_singleton()->get_modes(p_mode);
@@ -1575,18 +1896,25 @@ Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, Ident
 		return err;
 	}
 
-	r_gen_code.defines.clear();
-	r_gen_code.code.clear();
-	for (int i = 0; i < STAGE_MAX; i++) {
-		r_gen_code.stage_globals[i] = String();
+	CompileCacheEntry entry;
+
+	// Generate against recording actions rather than the caller's, so that a cache hit
+	// replays exactly the same side effects as a full compilation.
+	IdentifierActions recording_actions;
+	recording_actions.entry_point_stages = p_actions->entry_point_stages;
+	recording_actions.uniforms = &entry.uniforms;
+
+	LocalVector<bool> recorded_flags;
+	recorded_flags.resize(p_actions->usage_flag_pointers.size() + p_actions->write_flag_pointers.size());
+	uint32_t flag_index = 0;
+	for (const KeyValue<StringName, bool *> &E : p_actions->usage_flag_pointers) {
+		recorded_flags[flag_index] = false;
+		recording_actions.usage_flag_pointers[E.key] = &recorded_flags[flag_index++];
+	}
+	for (const KeyValue<StringName, bool *> &E : p_actions->write_flag_pointers) {
+		recorded_flags[flag_index] = false;
+		recording_actions.write_flag_pointers[E.key] = &recorded_flags[flag_index++];
 	}
-	r_gen_code.uses_fragment_time = false;
-	r_gen_code.uses_vertex_time = false;
-	r_gen_code.uses_global_textures = false;
-	r_gen_code.uses_screen_texture_mipmaps = false;
-	r_gen_code.uses_screen_texture = false;
-	r_gen_code.uses_depth_texture = false;
-	r_gen_code.uses_normal_roughness_texture = false;
 
 	used_name_defines.clear();
 	used_rmode_defines.clear();
@@ -1596,13 +1924,73 @@ Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, Ident
 	shader = parser.get_shader();
 	function = nullptr;
 	// Return value only relevant within nested calls.
-	_ALLOW_DISCARD_ _dump_node_code(shader, 1, r_gen_code, *p_actions, actions, false);
+	_ALLOW_DISCARD_ _dump_node_code(shader, 1, entry.gen_code, recording_actions, actions, false);
+
+	flag_index = 0;
+	for (const KeyValue<StringName, bool *> &E : p_actions->usage_flag_pointers) {
+		if (recorded_flags[flag_index++]) {
+			entry.used_flags.push_back(E.key);
+		}
+	}
+	for (const KeyValue<StringName, bool *> &E : p_actions->write_flag_pointers) {
+		if (recorded_flags[flag_index++]) {
+			entry.written_flags.push_back(E.key);
+		}
+	}
+
+	entry.render_modes = shader->render_modes;
+	entry.stencil_modes = shader->stencil_modes;
+	entry.stencil_reference = shader->stencil_reference;
+	for (const KeyValue<StringName, SL::ShaderNode::Uniform> &E : shader->uniforms) {
+		if (E.value.scope == SL::ShaderNode::Uniform::SCOPE_GLOBAL) {
+			entry.global_uniform_types[E.key] = E.value.type;
+		}
+	}
+
+	r_gen_code = entry.gen_code;
+	_apply_cached_actions(entry, p_actions);
+	compile_cache.insert(cache_key, entry);
+	if (!cache_path.is_empty() && !Engine::get_singleton()->is_editor_hint()) {
+		// Shaders being edited compile on every change, don't leave a file for each version.
+		_save_compile_cache_entry(cache_path, entry);
+	}
 
 	return OK;
 }
 
+void ShaderCompiler::clear_compile_cache() {
+	compile_cache.clear();
+}
+
+void ShaderCompiler::set_compile_cache_dir(const String &p_dir) {
+	compile_cache_dir = p_dir;
+}
+
+const String &ShaderCompiler::get_compile_cache_dir() {
+	return compile_cache_dir;
+}
+
 void ShaderCompiler::initialize(DefaultIdentifierActions p_actions) {
 	actions = p_actions;
+	compile_cache.clear();
+
+	// Anything that changes the generated code for the same source goes into the file names.
+	String config = String(GODOT_VERSION_HASH) + "\n" + itos(compile_cache_file_version) + "\n" + itos(RS::get_singleton()->is_low_end()) + "\n";
+	for (const KeyValue<StringName, String> &E : actions.renames) {
+		config += "rename:" + E.key + "=" + E.value + "\n";
+	}
+	for (const KeyValue<StringName, String> &E : actions.render_mode_defines) {
+		config += "render_mode:" + E.key + "=" + E.value + "\n";
+	}
+	for (const KeyValue<StringName, String> &E : actions.usage_defines) {
+		config += "usage:" + E.key + "=" + E.value + "\n";
+	}
+	for (const KeyValue<StringName, String> &E : actions.custom_samplers) {
+		config += "sampler:" + E.key + "=" + E.value + "\n";
+	}
+	config += vformat("%d %d %d %d %d %d %d\n", actions.default_filter, actions.default_repeat, actions.base_texture_binding_index, actions.texture_layout_set, actions.base_varying_index, actions.apply_luminance_multiplier, actions.check_multiview_samplers);
+	config += actions.base_uniform_string + "\n" + actions.global_buffer_array_variable + "\n" + actions.instance_uniform_index_variable;
+	compile_cache_config_hash = config.sha1_text();
 
 	time_name = "TIME";
 
@@ -1626,5 +2014,6 @@ void ShaderCompiler::initialize(DefaultIdentifierActions p_actions) {
 	texture_functions.insert("texelFetch");
 }
 
-ShaderCompiler::ShaderCompiler() {
+ShaderCompiler::ShaderCompiler() :
+		compile_cache(COMPILE_CACHE_CAPACITY) {
 }
@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "core/templates/lru.h"
 #include "core/templates/pair.h"
 #include "servers/rendering/rendering_server.h"
 #include "servers/rendering/shader_language.h"
@@ -128,9 +129,56 @@ private:
 
 	static ShaderLanguage::DataType _get_global_shader_uniform_type(const StringName &p_name);
 
+	// Successful compilations are cached by shader mode and preprocessed code, so the same
+	// shader compiled again (e.g. on every material reload) skips parsing and code generation.
+	// Side effects on the caller's IdentifierActions are recorded by name and replayed on a hit.
+	enum {
+		COMPILE_CACHE_CAPACITY = 128,
+	};
+
+	struct CompileCacheKey {
+		RS::ShaderMode mode = RS::SHADER_MAX;
+		String code;
+
+		static uint32_t hash(const CompileCacheKey &p_key) { return hash_murmur3_one_32(p_key.mode, p_key.code.hash()); }
+		bool operator==(const CompileCacheKey &p_key) const { return mode == p_key.mode && code == p_key.code; }
+	};
+
+	struct CompileCacheEntry {
+		GeneratedCode gen_code;
+		Vector<StringName> render_modes;
+		Vector<StringName> stencil_modes;
+		int stencil_reference = -1;
+		Vector<StringName> used_flags;
+		Vector<StringName> written_flags;
+		HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+		// Generated code depends on the types of the global uniforms it references.
+		HashMap<StringName, ShaderLanguage::DataType> global_uniform_types;
+	};
+
+	LRUCache<CompileCacheKey, CompileCacheEntry, CompileCacheKey> compile_cache;
+
+	// Entries are also saved to disk so shaders compiled in a previous run skip parsing on
+	// first load. Files are named after a hash of the default actions, the caller's entry
+	// points and flags, the shader mode and the preprocessed code. The editor only reads them.
+	static String compile_cache_dir;
+	String compile_cache_config_hash;
+
+	String _get_compile_cache_path(RS::ShaderMode p_mode, const String &p_code, const IdentifierActions *p_actions) const;
+	static bool _load_compile_cache_entry(const String &p_path, CompileCacheEntry &r_entry);
+	static void _save_compile_cache_entry(const String &p_path, const CompileCacheEntry &p_entry);
+	static bool _are_global_uniform_types_current(const CompileCacheEntry &p_entry);
+
+	void _apply_cached_actions(const CompileCacheEntry &p_entry, IdentifierActions *p_actions) const;
+
 public:
 	Error compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code);
 
 	void initialize(DefaultIdentifierActions p_actions);
+	void clear_compile_cache();
+
+	static void set_compile_cache_dir(const String &p_dir);
+	static const String &get_compile_cache_dir();
+
 	ShaderCompiler();
 };
@@ -404,7 +404,80 @@ const ShaderLanguage::KeyWord ShaderLanguage::keyword_list[] = {
 	{ TK_ERROR, nullptr, CF_UNSPECIFIED, {}, {} }
 };
 
+void ShaderLanguage::_set_code(const String &p_code) {
+	if (token_cache.is_empty()) {
+		code = p_code;
+		return;
+	}
+
+	const int old_length = code.length();
+	const int new_length = p_code.length();
+	const char32_t *old_ptr = code.ptr();
+	const char32_t *new_ptr = p_code.ptr();
+	const int min_length = MIN(old_length, new_length);
+
+	int prefix = 0;
+	while (prefix < min_length && old_ptr[prefix] == new_ptr[prefix]) {
+		prefix++;
+	}
+
+	if (prefix == old_length && old_length == new_length) {
+		code = p_code;
+		return;
+	}
+
+	int suffix = 0;
+	while (suffix < min_length - prefix && old_ptr[old_length - 1 - suffix] == new_ptr[new_length - 1 - suffix]) {
+		suffix++;
+	}
+
+	// The tokenizer looks at most one character past the end of a token, so a token is kept
+	// if everything it looked at is in the unchanged head, or if it starts in the unchanged tail.
+	const int shift = new_length - old_length;
+	HashMap<int, CachedToken> kept_tokens;
+	for (const KeyValue<int, CachedToken> &E : token_cache) {
+		if (E.value.end_char_idx + 2 <= prefix) {
+			kept_tokens.insert(E.key, E.value);
+		} else if (E.key >= old_length - suffix) {
+			CachedToken cached = E.value;
+			cached.end_char_idx += shift;
+			kept_tokens.insert(E.key + shift, cached);
+		}
+	}
+
+	token_cache = kept_tokens;
+	code = p_code;
+}
+
 ShaderLanguage::Token ShaderLanguage::_get_token() {
+	const CachedToken *cached = token_cache.getptr(char_idx);
+	if (cached) {
+		char_idx = cached->end_char_idx;
+		tk_line += cached->line_delta;
+		Token tk = cached->token;
+		tk.line = tk_line;
+		return tk;
+	}
+
+	const int start_char_idx = char_idx;
+	const int start_tk_line = tk_line;
+	token_cacheable = true;
+
+	Token tk = _read_token();
+
+	// Errors and include markers have side effects, so they are always read again.
+	if (token_cacheable && tk.type != TK_ERROR) {
+		CachedToken new_cached;
+		new_cached.token = tk;
+		new_cached.end_char_idx = char_idx;
+		new_cached.line_delta = tk_line - start_tk_line;
+		token_cache.insert(start_char_idx, new_cached);
+	}
+
+	return tk;
+}
+
+ShaderLanguage::Token ShaderLanguage::_read_token() {
 #define GETCHAR(m_idx) (((char_idx + m_idx) < code.length()) ? code[char_idx + m_idx] : char32_t(0))
 
 	while (true) {
@@ -656,6 +729,8 @@ ShaderLanguage::Token ShaderLanguage::_get_token() {
 				return _make_token(TK_OP_MOD);
 			} break;
 			case '@': {
+				token_cacheable = false;
+
 				if (GETCHAR(0) == '@' && GETCHAR(1) == '>') {
 					char_idx += 2;
 
@@ -963,7 +1038,7 @@ ShaderLanguage::Token ShaderLanguage::_peek() {
 String ShaderLanguage::token_debug(const String &p_code) {
 	clear();
 
-	code = p_code;
+	_set_code(p_code);
 
 	String output;
 
@@ -11355,7 +11430,7 @@ Error ShaderLanguage::compile(const String &p_code, const ShaderCompileInfo &p_i
 	clear();
 	is_shader_inc = p_info.is_include;
 
-	code = p_code;
+	_set_code(p_code);
 	global_shader_uniform_get_type_func = p_info.global_shader_uniform_type_func;
 
 	varying_function_names = p_info.varying_function_names;
@@ -11382,7 +11457,7 @@ Error ShaderLanguage::complete(const String &p_code, const ShaderCompileInfo &p_
 	clear();
 	is_shader_inc = p_info.is_include;
 
-	code = p_code;
+	_set_code(p_code);
 	varying_function_names = p_info.varying_function_names;
 
 	nodes = nullptr;
@@ -1106,7 +1106,23 @@ private:
 
 	static const char *token_names[TK_MAX];
 
+	// Tokens are cached by the character index they start at, so backtracking (_peek(),
+	// _lookup_next(), _set_tkpos()) does not lex the same text again. The cache outlives a
+	// single parse: when the code changes, tokens in the unchanged head and tail of the
+	// code are kept, so reparsing an edited shader only lexes the edited region.
+	struct CachedToken {
+		Token token;
+		int end_char_idx = 0;
+		int line_delta = 0;
+	};
+
+	HashMap<int, CachedToken> token_cache;
+	bool token_cacheable = true;
+
+	void _set_code(const String &p_code);
+
 	Token _make_token(TokenType p_type, const StringName &p_text = StringName());
+	Token _read_token();
 	Token _get_token();
 	bool _lookup_next(Token &r_tk);
 	Token _peek();
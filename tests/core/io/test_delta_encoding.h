@@ -0,0 +1,205 @@
+/**************************************************************************/
+/*  test_delta_encoding.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/delta_encoding.h"
+#include "core/io/file_access_memory.h"
+#include "core/math/random_pcg.h"
+
+#include "tests/test_macros.h"
+
+namespace TestDeltaEncoding {
+
+static Vector<uint8_t> _make_old_data(int p_size) {
+	RandomPCG rng(1234);
+	Vector<uint8_t> data;
+	data.resize(p_size);
+	for (int i = 0; i < p_size; i++) {
+		data.write[i] = rng.rand() & 0xFF;
+	}
+	return data;
+}
+
+static Vector<uint8_t> _make_new_data(const Vector<uint8_t> &p_old_data) {
+	// A handful of small edits, an insertion and a truncated tail, like a typical resource change.
+	Vector<uint8_t> data = p_old_data;
+	for (int i = 0; i < data.size(); i += 40000) {
+		data.write[i] ^= 0x5A;
+	}
+	for (int i = 0; i < 1000; i++) {
+		data.insert(data.size() / 3, i & 0xFF);
+	}
+	data.resize(data.size() - 5000);
+	return data;
+}
+
+TEST_CASE("[DeltaEncoding] Encode and decode") {
+	const Vector<uint8_t> old_data = _make_old_data(300000);
+	const Vector<uint8_t> new_data = _make_new_data(old_data);
+
+	Vector<uint8_t> delta;
+	REQUIRE(DeltaEncoding::encode_delta(old_data, new_data, delta) == OK);
+	CHECK_MESSAGE(
+			delta.size() < new_data.size() / 10,
+			"The delta of a small change should be much smaller than the new data.");
+
+	Vector<uint8_t> decoded;
+	REQUIRE(DeltaEncoding::decode_delta(old_data, delta, decoded) == OK);
+	CHECK(decoded == new_data);
+
+	Vector<uint8_t> corrupted = delta;
+	corrupted.write[0] = 'X';
+	ERR_PRINT_OFF;
+	CHECK(DeltaEncoding::decode_delta(old_data, corrupted, decoded) == ERR_FILE_CORRUPT);
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[DeltaEncoding] Stream decode") {
+	const Vector<uint8_t> old_data = _make_old_data(300000);
+	const Vector<uint8_t> new_data = _make_new_data(old_data);
+
+	Vector<uint8_t> delta;
+	REQUIRE(DeltaEncoding::encode_delta(old_data, new_data, delta) == OK);
+
+	Ref<FileAccessMemory> delta_file;
+	delta_file.instantiate();
+	REQUIRE(delta_file->open_custom(delta.ptr(), delta.size()) == OK);
+
+	DeltaStreamDecoder decoder;
+	REQUIRE(decoder.open(old_data, delta_file, delta.size()) == OK);
+	CHECK(decoder.get_new_size() == (uint64_t)new_data.size());
+
+	SUBCASE("Read in small chunks") {
+		Vector<uint8_t> decoded;
+		decoded.resize(new_data.size());
+		uint64_t position = 0;
+		while (position < (uint64_t)decoded.size()) {
+			Error err = OK;
+			uint64_t read = decoder.read(decoded.ptrw() + position, MIN((uint64_t)777, decoded.size() - position), &err);
+			REQUIRE(err == OK);
+			REQUIRE(read > 0);
+			position += read;
+		}
+		CHECK(decoded == new_data);
+
+		uint8_t past_end = 0;
+		CHECK_MESSAGE(
+				decoder.read(&past_end, 1) == 0,
+				"Reading past the end of the new data should return nothing.");
+	}
+
+	SUBCASE("Skip and rewind") {
+		const uint64_t skip_to = new_data.size() / 2;
+		REQUIRE(decoder.skip(skip_to) == OK);
+		CHECK(decoder.get_position() == skip_to);
+
+		uint8_t buffer[64];
+		REQUIRE(decoder.read(buffer, sizeof(buffer)) == sizeof(buffer));
+		CHECK(memcmp(buffer, new_data.ptr() + skip_to, sizeof(buffer)) == 0);
+
+		REQUIRE(decoder.rewind() == OK);
+		CHECK(decoder.get_position() == 0);
+		REQUIRE(decoder.read(buffer, sizeof(buffer)) == sizeof(buffer));
+		CHECK(memcmp(buffer, new_data.ptr(), sizeof(buffer)) == 0);
+	}
+}
+
+TEST_CASE("[DeltaEncoding] Stream decode data larger than the window") {
+	const int window_log = 20;
+	const int window_size = 1 << window_log;
+
+	// Repeats of a block half a window long, so later blocks match earlier ones inside the window.
+	const Vector<uint8_t> old_data = _make_old_data(window_size / 2);
+	Vector<uint8_t> new_data;
+	for (int i = 0; i < 6; i++) {
+		new_data.append_array(old_data);
+		new_data.write[new_data.size() - 1 - i * 1000] ^= 0x5A;
+	}
+	REQUIRE(new_data.size() > window_size * 2);
+
+	Vector<uint8_t> delta;
+	REQUIRE(DeltaEncoding::encode_delta(old_data, new_data, delta, 19, window_log) == OK);
+	CHECK_MESSAGE(
+			delta.size() < new_data.size() / 10,
+			"Repeated data within the window should still be matched.");
+
+	Ref<FileAccessMemory> delta_file;
+	delta_file.instantiate();
+	REQUIRE(delta_file->open_custom(delta.ptr(), delta.size()) == OK);
+
+	DeltaStreamDecoder decoder;
+	REQUIRE(decoder.open(old_data, delta_file, delta.size()) == OK);
+	REQUIRE(decoder.get_new_size() == (uint64_t)new_data.size());
+
+	Vector<uint8_t> decoded;
+	decoded.resize(new_data.size());
+	uint64_t position = 0;
+	while (position < (uint64_t)decoded.size()) {
+		Error err = OK;
+		uint64_t read = decoder.read(decoded.ptrw() + position, MIN((uint64_t)100000, decoded.size() - position), &err);
+		REQUIRE(err == OK);
+		REQUIRE(read > 0);
+		position += read;
+	}
+	CHECK(decoded == new_data);
+
+	ERR_PRINT_OFF;
+	CHECK_MESSAGE(
+			DeltaEncoding::encode_delta(old_data, new_data, delta, 19, DeltaEncoding::MAX_WINDOW_LOG + 1) == ERR_INVALID_PARAMETER,
+			"Windows larger than decoders accept should be rejected.");
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[DeltaEncoding] Stream decode detects truncated deltas") {
+	const Vector<uint8_t> old_data = _make_old_data(100000);
+	const Vector<uint8_t> new_data = _make_new_data(old_data);
+
+	Vector<uint8_t> delta;
+	REQUIRE(DeltaEncoding::encode_delta(old_data, new_data, delta) == OK);
+	delta.resize(delta.size() - 16);
+
+	Ref<FileAccessMemory> delta_file;
+	delta_file.instantiate();
+	REQUIRE(delta_file->open_custom(delta.ptr(), delta.size()) == OK);
+
+	DeltaStreamDecoder decoder;
+	REQUIRE(decoder.open(old_data, delta_file, delta.size()) == OK);
+
+	Vector<uint8_t> decoded;
+	decoded.resize(new_data.size());
+	Error err = OK;
+	ERR_PRINT_OFF;
+	decoder.read(decoded.ptrw(), decoded.size(), &err);
+	ERR_PRINT_ON;
+	CHECK(err == ERR_FILE_CORRUPT);
+}
+
+} // namespace TestDeltaEncoding
@@ -31,6 +31,8 @@
 #pragma once
 
 #include "core/io/file_access.h"
+#include "core/io/file_access_async.h"
+#include "core/io/file_access_memory.h"
 #include "tests/test_macros.h"
 #include "tests/test_utils.h"
 
@@ -248,4 +250,134 @@ TEST_CASE("[FileAccess] Get/Store floating point half precision values") {
 	}
 }
 
+TEST_CASE("[FileAccess] Buffer views") {
+	const String file_path = TestUtils::get_data_path("testdata.csv");
+	const Vector<uint8_t> contents = FileAccess::get_file_as_bytes(file_path);
+	REQUIRE(contents.size() > 16);
+
+	SUBCASE("Memory file") {
+		Ref<FileAccessMemory> f;
+		f.instantiate();
+		REQUIRE(f->open_custom(contents.ptr(), contents.size()) == OK);
+
+		f->seek(4);
+		const uint8_t *view = f->get_buffer_view(8);
+		REQUIRE(view != nullptr);
+		CHECK(view == contents.ptr() + 4);
+		CHECK(f->get_position() == 12);
+
+		CHECK(f->get_buffer_view(contents.size()) == nullptr);
+		CHECK_MESSAGE(f->get_position() == 12, "A failed view should not move the position.");
+	}
+
+	SUBCASE("File on disk") {
+		Ref<FileAccess> f = FileAccess::open(file_path, FileAccess::READ);
+		REQUIRE(f.is_valid());
+
+		f->seek(4);
+		const uint8_t *view = f->get_buffer_view(8);
+		if (view == nullptr) {
+			// Not every platform can map files, callers fall back to get_buffer().
+			CHECK(f->get_position() == 4);
+			return;
+		}
+		CHECK(memcmp(view, contents.ptr() + 4, 8) == 0);
+		CHECK(f->get_position() == 12);
+		CHECK(f->get_8() == contents[12]);
+
+		CHECK(f->get_buffer_view(contents.size()) == nullptr);
+		CHECK(f->get_position() == 13);
+
+		// Views stay valid while the file is open, regardless of later seeks.
+		f->seek(0);
+		const uint8_t *whole = f->get_buffer_view(contents.size());
+		REQUIRE(whole != nullptr);
+		CHECK(f->get_position() == (uint64_t)contents.size());
+		f->seek(0);
+		CHECK(memcmp(whole, contents.ptr(), contents.size()) == 0);
+		CHECK(memcmp(view, contents.ptr() + 4, 8) == 0);
+	}
+
+	SUBCASE("View range") {
+		Ref<FileAccess> f = FileAccess::open(file_path, FileAccess::READ);
+		REQUIRE(f.is_valid());
+		f->set_buffer_view_range(4, 8);
+
+		f->seek(4);
+		const uint8_t *view = f->get_buffer_view(8);
+		if (view == nullptr) {
+			return;
+		}
+		CHECK(memcmp(view, contents.ptr() + 4, 8) == 0);
+
+		f->seek(0);
+		CHECK_MESSAGE(f->get_buffer_view(4) == nullptr, "Views before the range should not be given.");
+		f->seek(8);
+		CHECK_MESSAGE(f->get_buffer_view(8) == nullptr, "Views past the range should not be given.");
+		CHECK(f->get_position() == 8);
+	}
+
+	SUBCASE("Truncated file") {
+		const String temp_path = TestUtils::get_temp_path("buffer_view_truncated.bin");
+		{
+			Ref<FileAccess> w = FileAccess::open(temp_path, FileAccess::WRITE);
+			REQUIRE(w.is_valid());
+			w->store_buffer(contents);
+		}
+
+		Ref<FileAccess> f = FileAccess::open(temp_path, FileAccess::READ);
+		REQUIRE(f.is_valid());
+		if (f->get_buffer_view(4) == nullptr) {
+			return;
+		}
+
+		Ref<FileAccess> w = FileAccess::open(temp_path, FileAccess::READ_WRITE);
+		REQUIRE(w.is_valid());
+		REQUIRE(w->resize(8) == OK);
+		w.unref();
+
+		CHECK_MESSAGE(f->get_buffer_view(contents.size() - 4) == nullptr, "Views past the end of a truncated file should not be given.");
+		CHECK(f->get_position() == 4);
+	}
+}
+
+TEST_CASE("[FileAccessAsync] Read requests") {
+	const String file_path = TestUtils::get_data_path("testdata.csv");
+	const Vector<uint8_t> contents = FileAccess::get_file_as_bytes(file_path);
+	REQUIRE(contents.size() > 16);
+
+	Vector<FileAccessAsync::ReadRequest> reads;
+	reads.resize(3);
+	reads.write[0].path = file_path;
+	reads.write[1].path = file_path;
+	reads.write[1].offset = 4;
+	reads.write[1].length = 8;
+	reads.write[2].path = TestUtils::get_data_path("does_not_exist.bin");
+
+	const Vector<FileAccessAsync::RequestID> ids = FileAccessAsync::submit_reads(reads);
+	REQUIRE(ids.size() == 3);
+
+	Error err = FAILED;
+	CHECK(FileAccessAsync::complete_read(ids[0], &err) == contents);
+	CHECK(err == OK);
+
+	const Vector<uint8_t> partial = FileAccessAsync::complete_read(ids[1], &err);
+	CHECK(err == OK);
+	CHECK(partial == contents.slice(4, 12));
+
+	ERR_PRINT_OFF;
+	CHECK(FileAccessAsync::complete_read(ids[2], &err).is_empty());
+	CHECK(err != OK);
+
+	// Completed requests are released.
+	CHECK(FileAccessAsync::complete_read(ids[0], &err).is_empty());
+	CHECK(err == ERR_INVALID_PARAMETER);
+	ERR_PRINT_ON;
+
+	// Prefetching only hints the OS cache, it must not interfere with regular reads.
+	FileAccessAsync::prefetch({ file_path, file_path });
+	const FileAccessAsync::RequestID id = FileAccessAsync::submit_read(file_path, contents.size() - 4);
+	CHECK(FileAccessAsync::complete_read(id) == contents.slice(contents.size() - 4));
+}
+
 } // namespace TestFileAccess
@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "core/io/file_access_compressed.h"
 #include "core/io/file_access_pack.h"
 #include "core/io/pck_packer.h"
 #include "core/os/os.h"
@@ -116,4 +117,82 @@ TEST_CASE("[PCKPacker] Pack a PCK file with some files and directories") {
 			f->get_length() <= 27000,
 			"The generated non-empty PCK file shouldn't be too large.");
 }
+
+TEST_CASE("[PCKPacker] Pack a PCK file with compressed files") {
+	// Highly compressible content, spanning several compression blocks.
+	const String source_path = TestUtils::get_temp_path("pck_compressed_source.txt");
+	String text;
+	for (int i = 0; i < 20000; i++) {
+		text += vformat("Line %d of some very repetitive text.\n", i % 100);
+	}
+	{
+		Ref<FileAccess> f = FileAccess::open(source_path, FileAccess::WRITE);
+		f->store_string(text);
+	}
+
+	const String raw_pck_path = TestUtils::get_temp_path("output_raw.pck");
+	const String compressed_pck_path = TestUtils::get_temp_path("output_compressed.pck");
+	{
+		PCKPacker pck_packer;
+		CHECK(pck_packer.pck_start(raw_pck_path) == OK);
+		CHECK(pck_packer.add_file("text.txt", source_path) == OK);
+		CHECK(pck_packer.flush() == OK);
+	}
+	{
+		PCKPacker pck_packer;
+		CHECK(pck_packer.pck_start(compressed_pck_path) == OK);
+		CHECK_MESSAGE(
+				pck_packer.add_file_compressed("text.txt", source_path, FileAccess::COMPRESSION_ZSTD) == OK,
+				"Adding a compressed file to the PCK should return an OK error code.");
+		ERR_PRINT_OFF;
+		CHECK_MESSAGE(
+				pck_packer.add_file_compressed("text2.txt", source_path, FileAccess::COMPRESSION_BROTLI) != OK,
+				"Brotli can't be used to compress PCK files.");
+		ERR_PRINT_ON;
+		CHECK(pck_packer.flush() == OK);
+	}
+
+	CHECK_MESSAGE(
+			FileAccess::open(compressed_pck_path, FileAccess::READ)->get_length() < FileAccess::open(raw_pck_path, FileAccess::READ)->get_length() / 4,
+			"The PCK with compressed files should be much smaller than the one with raw files.");
+}
+
+TEST_CASE("[PCKPacker] Seek in a compressed PCK entry") {
+	Vector<uint8_t> data;
+	data.resize(PACK_FILE_COMPRESSION_BLOCK_SIZE * 3 + 123);
+	for (int i = 0; i < data.size(); i++) {
+		data.write[i] = (i * 7) % 251;
+	}
+	const Vector<uint8_t> compressed = FileAccessCompressed::compress_buffer(data.ptr(), data.size(), PACK_FILE_COMPRESSED_MAGIC, Compression::MODE_ZSTD, PACK_FILE_COMPRESSION_BLOCK_SIZE);
+	REQUIRE(!compressed.is_empty());
+
+	// Store the entry after some unrelated data, like in a pack.
+	const String path = TestUtils::get_temp_path("compressed_entry.bin");
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		for (int i = 0; i < 100; i++) {
+			f->store_8(0xFF);
+		}
+		f->store_buffer(compressed);
+	}
+
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
+	f->seek(100);
+	uint8_t magic[4];
+	f->get_buffer(magic, 4);
+	CHECK(memcmp(magic, PACK_FILE_COMPRESSED_MAGIC, 4) == 0);
+
+	Ref<FileAccessCompressed> fac;
+	fac.instantiate();
+	REQUIRE(fac->open_after_magic(f) == OK);
+	CHECK(fac->get_length() == (uint64_t)data.size());
+
+	const uint64_t positions[] = { (uint64_t)PACK_FILE_COMPRESSION_BLOCK_SIZE * 2 + 5, 10, (uint64_t)data.size() - 50, (uint64_t)PACK_FILE_COMPRESSION_BLOCK_SIZE - 2 };
+	for (uint64_t position : positions) {
+		uint8_t buffer[40];
+		fac->seek(position);
+		CHECK(fac->get_buffer(buffer, 40) == 40);
+		CHECK_MESSAGE(memcmp(buffer, data.ptr() + position, 40) == 0, vformat("Data read at position %d should match the original data.", position));
+	}
+}
 } // namespace TestPCKPacker
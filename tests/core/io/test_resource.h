@@ -33,6 +33,8 @@
 #include "core/io/resource.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
 #include "scene/main/node.h"
 
 #include "thirdparty/doctest/doctest.h"
@@ -41,6 +43,37 @@
 
 #include <functional>
 
+// Records the threads its property is set from.
+class _TestThreadSafeSettersResource : public Resource {
+	GDCLASS(_TestThreadSafeSettersResource, Resource);
+
+	int value = 0;
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("set_value", "value"), &_TestThreadSafeSettersResource::set_value);
+		ClassDB::bind_method(D_METHOD("get_value"), &_TestThreadSafeSettersResource::get_value);
+		ADD_PROPERTY(PropertyInfo(Variant::INT, "value"), "set_value", "get_value");
+	}
+
+public:
+	static inline bool thread_safe = true;
+	static inline Mutex threads_mutex;
+	static inline HashSet<Thread::ID> setter_threads;
+
+	void set_value(int p_value) {
+		value = p_value;
+		// Long enough for other pool threads to pick up the remaining resources.
+		OS::get_singleton()->delay_usec(2000);
+		MutexLock lock(threads_mutex);
+		setter_threads.insert(Thread::get_caller_id());
+	}
+
+	int get_value() const { return value; }
+
+	virtual bool has_thread_safe_setters() const override { return thread_safe; }
+};
+
 namespace TestResource {
 
 enum TestDuplicateMode {
@@ -627,4 +660,87 @@ TEST_CASE("[Resource] Breaking circular references on save") {
 	// Break circular reference to avoid memory leak
 	resource_c->remove_meta("next");
 }
+
+TEST_CASE("[Resource] Loading binary sub-resources on sub-threads") {
+	Ref<Resource> leaf = memnew(Resource);
+	leaf->set_name("Leaf");
+	Array children;
+	for (int i = 0; i < 8; i++) {
+		Ref<Resource> child = memnew(Resource);
+		child->set_name(vformat("Child %d", i));
+		child->set_meta("leaf", leaf);
+		children.push_back(child);
+	}
+	Ref<Resource> root = memnew(Resource);
+	root->set_name("Root");
+	root->set_meta("children", children);
+
+	const String save_path = TestUtils::get_temp_path("resource_sub_threads.res");
+	REQUIRE(ResourceSaver::save(root, save_path) == OK);
+
+	REQUIRE(ResourceLoader::load_threaded_request(save_path, "", true, ResourceFormatLoader::CACHE_MODE_IGNORE) == OK);
+	const Ref<Resource> loaded_root = ResourceLoader::load_threaded_get(save_path);
+	REQUIRE(loaded_root.is_valid());
+	CHECK(loaded_root->get_name() == "Root");
+
+	const Array loaded_children = loaded_root->get_meta("children");
+	REQUIRE(loaded_children.size() == 8);
+	const Ref<Resource> loaded_leaf = Ref<Resource>(loaded_children[0])->get_meta("leaf");
+	REQUIRE(loaded_leaf.is_valid());
+	CHECK(loaded_leaf->get_name() == "Leaf");
+	for (int i = 0; i < loaded_children.size(); i++) {
+		const Ref<Resource> loaded_child = loaded_children[i];
+		CHECK(loaded_child->get_name() == vformat("Child %d", i));
+		CHECK_MESSAGE(Ref<Resource>(loaded_child->get_meta("leaf")) == loaded_leaf, "Sub-resources shared in the file should stay shared.");
+	}
+}
+
+TEST_CASE("[Resource] Only resources with thread-safe setters are set on several threads") {
+	if (WorkerThreadPool::get_singleton()->get_thread_count() < 2) {
+		return;
+	}
+	GDREGISTER_CLASS(_TestThreadSafeSettersResource);
+
+	Array children;
+	for (int i = 0; i < 16; i++) {
+		Ref<_TestThreadSafeSettersResource> child;
+		child.instantiate();
+		child->set_value(i + 1);
+		children.push_back(child);
+	}
+	Ref<Resource> root = memnew(Resource);
+	root->set_meta("children", children);
+
+	const String save_path = TestUtils::get_temp_path("resource_thread_safe_setters.res");
+	REQUIRE(ResourceSaver::save(root, save_path) == OK);
+
+	const auto load_children = [&save_path]() {
+		_TestThreadSafeSettersResource::setter_threads.clear();
+		REQUIRE(ResourceLoader::load_threaded_request(save_path, "", true, ResourceFormatLoader::CACHE_MODE_IGNORE) == OK);
+		const Ref<Resource> loaded_root = ResourceLoader::load_threaded_get(save_path);
+		REQUIRE(loaded_root.is_valid());
+		const Array loaded_children = loaded_root->get_meta("children");
+		REQUIRE(loaded_children.size() == 16);
+		for (int i = 0; i < loaded_children.size(); i++) {
+			const Ref<_TestThreadSafeSettersResource> loaded_child = loaded_children[i];
+			REQUIRE(loaded_child.is_valid());
+			CHECK(loaded_child->get_value() == i + 1);
+		}
+	};
+
+	SUBCASE("Allowed classes are split across the pool") {
+		_TestThreadSafeSettersResource::thread_safe = true;
+		load_children();
+		CHECK_MESSAGE(_TestThreadSafeSettersResource::setter_threads.size() > 1, "Setting properties should have been split across worker threads.");
+	}
+
+	SUBCASE("Other classes stay on the loading thread") {
+		_TestThreadSafeSettersResource::thread_safe = false;
+		load_children();
+		CHECK(_TestThreadSafeSettersResource::setter_threads.size() == 1);
+	}
+
+	_TestThreadSafeSettersResource::thread_safe = true;
+	_TestThreadSafeSettersResource::setter_threads.clear();
+}
 } // namespace TestResource
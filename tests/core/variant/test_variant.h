@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "core/io/file_access_memory.h"
 #include "core/variant/variant.h"
 #include "core/variant/variant_parser.h"
 
@@ -1784,6 +1785,78 @@ TEST_CASE("[Variant] Writer and parser array") {
 	CHECK_MESSAGE(a_parsed == Variant(a), "Should parse back.");
 }
 
+TEST_CASE("[Variant] Parser packed arrays") {
+	VariantParser::StreamString ss;
+	String errs;
+	int line = 0;
+	Variant parsed;
+
+	ss.s = "PackedVector3Array(1, -2.5, 3e2,\n\t4, 5.0e-1 ; comment\n, -inf, inf, nan, 0)";
+	REQUIRE(VariantParser::parse(&ss, parsed, errs, line) == OK);
+	REQUIRE(parsed.get_type() == Variant::PACKED_VECTOR3_ARRAY);
+	const PackedVector3Array vectors = parsed;
+	REQUIRE(vectors.size() == 3);
+	CHECK(vectors[0] == Vector3(1, -2.5, 300));
+	CHECK(vectors[1] == Vector3(4, 0.5, -Math::INF));
+	CHECK(vectors[2].x == Math::INF);
+	CHECK(Math::is_nan(vectors[2].y));
+	CHECK(vectors[2].z == 0);
+	CHECK_MESSAGE(line == 2, "Newlines inside the array should be counted.");
+
+	ss = VariantParser::StreamString();
+	ss.s = "PackedInt64Array(9223372036854775807, -9223372036854775807, 3)";
+	REQUIRE(VariantParser::parse(&ss, parsed, errs, line) == OK);
+	const PackedInt64Array ints = parsed;
+	REQUIRE(ints.size() == 3);
+	CHECK_MESSAGE(ints[0] == INT64_MAX, "Large integers should not lose precision.");
+	CHECK(ints[1] == -INT64_MAX);
+
+	ss = VariantParser::StreamString();
+	ss.s = "PackedFloat32Array( )";
+	REQUIRE(VariantParser::parse(&ss, parsed, errs, line) == OK);
+	CHECK(PackedFloat32Array(parsed).is_empty());
+
+	ss = VariantParser::StreamString();
+	ss.s = "PackedFloat32Array(1, -)";
+	ERR_PRINT_OFF;
+	CHECK(VariantParser::parse(&ss, parsed, errs, line) == ERR_PARSE_ERROR);
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[Variant] Parser strings") {
+	String long_text;
+	for (int i = 0; i < 1000; i++) {
+		long_text += String::utf8("abcdé");
+	}
+
+	const String source = "[\"" + long_text + "\", \"line\\nbreak \\\"quoted\\\" \\u4e2d\", \"multi\nline\"]";
+	const CharString source_utf8 = source.utf8();
+
+	Ref<FileAccessMemory> file;
+	file.instantiate();
+	REQUIRE(file->open_custom((const uint8_t *)source_utf8.get_data(), source_utf8.length()) == OK);
+
+	VariantParser::StreamFile sf;
+	sf.f = file;
+	String errs;
+	int line = 0;
+	Variant parsed;
+	REQUIRE(VariantParser::parse(&sf, parsed, errs, line) == OK);
+
+	const Array strings = parsed;
+	REQUIRE(strings.size() == 3);
+	CHECK_MESSAGE(strings[0] == long_text, "Strings longer than the read ahead buffer should be decoded as UTF-8.");
+	CHECK_MESSAGE(strings[1] == String::utf8("line\nbreak \"quoted\" 中"), "Escaped code points should be kept.");
+	CHECK(strings[2] == "multi\nline");
+	CHECK(line == 1);
+
+	VariantParser::StreamString ss;
+	ss.s = source;
+	line = 0;
+	REQUIRE(VariantParser::parse(&ss, parsed, errs, line) == OK);
+	CHECK_MESSAGE(parsed == Variant(strings), "String streams should parse the same.");
+}
+
 TEST_CASE("[Variant] Writer recursive array") {
 	// There is no way to accurately represent a recursive array,
 	// the only thing we can do is make sure the writer doesn't blow up
@@ -0,0 +1,103 @@
+/**************************************************************************/
+/*  test_editor_export_platform.h                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/file_access_pack.h"
+#include "editor/editor_node.h"
+#include "editor/export/editor_export_platform.h"
+
+#include "tests/test_utils.h"
+#include "thirdparty/doctest/doctest.h"
+
+namespace TestEditorExportPlatform {
+
+// Exposes the helpers save_pack() writes a PCK with.
+class _TestPackExportPlatform : public EditorExportPlatform {
+public:
+	using EditorExportPlatform::_encrypt_and_store_directory;
+	using EditorExportPlatform::_save_pack_file;
+	using EditorExportPlatform::_store_header;
+	using EditorExportPlatform::PackData;
+};
+
+TEST_CASE("[EditorExportPlatform] Identical files are stored once in a PCK") {
+	Vector<uint8_t> shared_data;
+	Vector<uint8_t> other_data;
+	for (int i = 0; i < 4000; i++) {
+		shared_data.push_back((i * 7) % 251);
+		other_data.push_back((i * 13) % 241);
+	}
+	const String files[] = { "res://pck_dedup/a.bin", "res://pck_dedup/b.bin", "res://pck_dedup/c.bin" };
+	const Vector<uint8_t> *contents[] = { &shared_data, &shared_data, &other_data };
+
+	// Laid out like save_pack() does.
+	const String pck_path = TestUtils::get_temp_path("export_dedup.pck");
+	Ref<FileAccess> f = FileAccess::open(pck_path, FileAccess::WRITE);
+	REQUIRE(f.is_valid());
+	uint64_t file_base_ofs = 0;
+	uint64_t dir_base_ofs = 0;
+	_TestPackExportPlatform::_store_header(f, false, false, file_base_ofs, dir_base_ofs);
+	const uint64_t file_base = f->get_position();
+	f->seek(file_base_ofs);
+	f->store_64(file_base);
+	f->seek(file_base);
+
+	EditorProgress ep("test_pck_dedup", "Packing", 102);
+	_TestPackExportPlatform::PackData pd;
+	pd.ep = &ep;
+	pd.f = f;
+	pd.path = pck_path;
+	for (int i = 0; i < 3; i++) {
+		REQUIRE(_TestPackExportPlatform::_save_pack_file(Ref<EditorExportPreset>(), &pd, files[i], *contents[i], i, 3, Vector<String>(), Vector<String>(), Vector<uint8_t>(), 0, false) == OK);
+	}
+
+	REQUIRE(pd.file_ofs.size() == 3);
+	CHECK_MESSAGE(pd.file_ofs[0].ofs == pd.file_ofs[1].ofs, "Identical files should point to the same payload.");
+	CHECK(pd.file_ofs[2].ofs != pd.file_ofs[0].ofs);
+	CHECK_MESSAGE(
+			f->get_position() - file_base < (uint64_t)(shared_data.size() * 2 + other_data.size()),
+			"The shared payload should only be written once.");
+
+	const uint64_t dir_offset = f->get_position();
+	f->seek(dir_base_ofs);
+	f->store_64(dir_offset);
+	f->seek(dir_offset);
+	pd.file_ofs.sort();
+	REQUIRE(_TestPackExportPlatform::_encrypt_and_store_directory(f, pd, Vector<uint8_t>(), 0, file_base));
+	f->close();
+
+	REQUIRE(PackedData::get_singleton()->add_pack(pck_path, false, 0) == OK);
+	for (int i = 0; i < 3; i++) {
+		CHECK_MESSAGE(FileAccess::get_file_as_bytes(files[i]) == *contents[i], vformat("\"%s\" should read back its own data.", files[i]));
+	}
+}
+
+} // namespace TestEditorExportPlatform
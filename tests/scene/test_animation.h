@@ -308,4 +308,30 @@ TEST_CASE("[Animation] Create Bezier track") {
 	ERR_PRINT_ON;
 }
 
+TEST_CASE("[Animation] Compressed position track spanning several pages") {
+	Ref<Animation> animation = memnew(Animation);
+	const int track_index = animation->add_track(Animation::TYPE_POSITION_3D);
+	animation->track_set_path(track_index, NodePath("Enemy:position"));
+	animation->set_length(10.0);
+	// Zigzag keys can't be simplified away, so a small page size splits them across many pages.
+	for (int i = 0; i <= 100; i++) {
+		animation->position_track_insert_key(track_index, i * 0.1, Vector3(i * 0.1, i % 2, -(i % 3)));
+	}
+	Ref<Animation> reference = animation->duplicate();
+
+	animation->compress(256, 10);
+	CHECK(animation->track_is_compressed(track_index));
+	const Dictionary compression = animation->get("_compression");
+	CHECK(Array(compression["pages"]).size() > 1);
+
+	for (int i = 0; i <= 200; i++) {
+		const double time = i * 0.05;
+		Vector3 expected;
+		Vector3 compressed;
+		CHECK(reference->try_position_track_interpolate(track_index, time, &expected) == OK);
+		CHECK(animation->try_position_track_interpolate(track_index, time, &compressed) == OK);
+		CHECK(compressed.distance_to(expected) < 0.01);
+	}
+}
+
 } // namespace TestAnimation
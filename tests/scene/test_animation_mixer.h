@@ -0,0 +1,166 @@
+/**************************************************************************/
+/*  test_animation_mixer.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/config/project_settings.h"
+#include "core/os/os.h"
+#include "scene/2d/node_2d.h"
+#include "scene/animation/animation_player.h"
+#include "scene/main/window.h"
+
+#include "tests/test_macros.h"
+
+namespace TestAnimationMixer {
+
+static Ref<Animation> create_walk_animation(int p_bone_count) {
+	Ref<Animation> animation;
+	animation.instantiate();
+	animation->set_length(1.0);
+	animation->set_loop_mode(Animation::LOOP_LINEAR);
+
+	for (int i = 0; i < p_bone_count; i++) {
+		int track = animation->add_track(Animation::TYPE_VALUE);
+		animation->track_set_path(track, NodePath(vformat("Bone%d:position", i)));
+		animation->track_insert_key(track, 0.0, Vector2(i, 0));
+		animation->track_insert_key(track, 0.5, Vector2(i, 10 + i));
+		animation->track_insert_key(track, 1.0, Vector2(i, 0));
+
+		track = animation->add_track(Animation::TYPE_VALUE);
+		animation->track_set_path(track, NodePath(vformat("Bone%d:rotation", i)));
+		animation->track_insert_key(track, 0.0, 0.0);
+		animation->track_insert_key(track, 1.0, Math::PI * (i % 3 + 1) * 0.25);
+	}
+
+	return animation;
+}
+
+struct Crowd {
+	LocalVector<Node2D *> characters;
+	LocalVector<Node2D *> bones;
+};
+
+static Crowd create_crowd(int p_character_count, int p_bone_count) {
+	Ref<AnimationLibrary> library;
+	library.instantiate();
+	library->add_animation("walk", create_walk_animation(p_bone_count));
+
+	Crowd crowd;
+	for (int i = 0; i < p_character_count; i++) {
+		Node2D *character = memnew(Node2D);
+		for (int j = 0; j < p_bone_count; j++) {
+			Node2D *bone = memnew(Node2D);
+			bone->set_name(vformat("Bone%d", j));
+			character->add_child(bone);
+			crowd.bones.push_back(bone);
+		}
+
+		AnimationPlayer *player = memnew(AnimationPlayer);
+		character->add_child(player);
+		SceneTree::get_singleton()->get_root()->add_child(character);
+
+		player->add_animation_library("", library);
+		player->set_speed_scale(1.0 + 0.01 * i); // Desynchronize the characters.
+		player->play("walk");
+		crowd.characters.push_back(character);
+	}
+	return crowd;
+}
+
+static void free_crowd(Crowd &p_crowd) {
+	for (Node2D *character : p_crowd.characters) {
+		memdelete(character);
+	}
+	p_crowd.characters.clear();
+	p_crowd.bones.clear();
+}
+
+static LocalVector<Transform2D> run_crowd(bool p_parallel, int p_character_count, int p_bone_count, int p_frame_count, uint64_t *r_usec = nullptr) {
+	ProjectSettings::get_singleton()->set_setting("animation/mixer/parallel_evaluation", p_parallel);
+
+	Crowd crowd = create_crowd(p_character_count, p_bone_count);
+
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < p_frame_count; i++) {
+		SceneTree::get_singleton()->process(1.0 / 60.0);
+	}
+	if (r_usec) {
+		*r_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	}
+
+	LocalVector<Transform2D> poses;
+	for (const Node2D *bone : crowd.bones) {
+		poses.push_back(bone->get_transform());
+	}
+
+	free_crowd(crowd);
+	ProjectSettings::get_singleton()->set_setting("animation/mixer/parallel_evaluation", false);
+	return poses;
+}
+
+TEST_CASE("[SceneTree][AnimationMixer] Parallel evaluation matches serial evaluation") {
+	const LocalVector<Transform2D> serial = run_crowd(false, 16, 8, 20);
+	const LocalVector<Transform2D> parallel = run_crowd(true, 16, 8, 20);
+
+	REQUIRE(serial.size() == parallel.size());
+	bool animated = false;
+	bool matches = true;
+	for (uint32_t i = 0; i < serial.size(); i++) {
+		animated = animated || serial[i] != Transform2D();
+		matches = matches && serial[i] == parallel[i];
+	}
+	CHECK_MESSAGE(animated, "The bones should have been animated.");
+	CHECK_MESSAGE(matches, "Parallel evaluation should give the same poses as serial evaluation.");
+}
+
+TEST_CASE("[SceneTree][AnimationMixer] Clearing caches drops a pending parallel blend") {
+	ProjectSettings::get_singleton()->set_setting("animation/mixer/parallel_evaluation", true);
+
+	Crowd crowd = create_crowd(1, 2);
+	AnimationPlayer *player = Object::cast_to<AnimationPlayer>(crowd.characters[0]->get_child(-1));
+	REQUIRE(player);
+	SceneTree::get_singleton()->process(1.0 / 60.0);
+	const Transform2D pose = crowd.bones[1]->get_transform();
+	CHECK_MESSAGE(pose != Transform2D(), "The bones should have been animated.");
+
+	// Schedule a blend, then rebuild the caches before the deferred batch runs.
+	player->notification(Node::NOTIFICATION_INTERNAL_PROCESS);
+	player->set_root_node(player->get_root_node());
+	MessageQueue::get_singleton()->flush();
+	CHECK_MESSAGE(crowd.bones[1]->get_transform() == pose, "The dropped blend should not be applied.");
+
+	SceneTree::get_singleton()->process(1.0 / 60.0);
+	CHECK_MESSAGE(crowd.bones[1]->get_transform() != pose, "The mixer should keep animating with the new caches.");
+
+	free_crowd(crowd);
+	ProjectSettings::get_singleton()->set_setting("animation/mixer/parallel_evaluation", false);
+}
+
+} // namespace TestAnimationMixer
@@ -0,0 +1,126 @@
+/**************************************************************************/
+/*  test_concave_polygon_shape_3d.h                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/config/project_settings.h"
+#include "core/io/resource_loader.h"
+#include "core/io/resource_saver.h"
+#include "scene/resources/3d/concave_polygon_shape_3d.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestConcavePolygonShape3D {
+
+static Vector<Vector3> _make_faces(int p_triangles) {
+	Vector<Vector3> faces;
+	faces.resize(p_triangles * 3);
+	for (int i = 0; i < p_triangles; i++) {
+		faces.write[i * 3 + 0] = Vector3(i, 0, 0);
+		faces.write[i * 3 + 1] = Vector3(i, 1, 0);
+		faces.write[i * 3 + 2] = Vector3(i, 0, 1);
+	}
+	return faces;
+}
+
+TEST_CASE("[SceneTree][ConcavePolygonShape3D] Lazily loaded faces") {
+	const Vector<Vector3> faces = _make_faces(1000);
+
+	Ref<ConcavePolygonShape3D> shape = memnew(ConcavePolygonShape3D);
+	shape->set_faces(faces);
+	shape->set_backface_collision_enabled(true);
+
+	const String save_path = TestUtils::get_temp_path("lazy_concave_polygon_shape_3d.res");
+	REQUIRE(ResourceSaver::save(shape, save_path) == OK);
+
+	ProjectSettings::get_singleton()->set_setting("resource_loader/lazy_load_min_size", 1024);
+
+	SUBCASE("Read on first use") {
+		Ref<ConcavePolygonShape3D> loaded = ResourceLoader::load(save_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+		REQUIRE(loaded.is_valid());
+		CHECK_MESSAGE(loaded->has_lazy_properties(), "Faces above the size threshold should be left in the file.");
+		CHECK(loaded->is_backface_collision_enabled());
+
+		CHECK(loaded->get_faces() == faces);
+		CHECK_FALSE(loaded->has_lazy_properties());
+		CHECK(loaded->get_faces() == faces);
+	}
+
+	SUBCASE("Read when the physics shape is used") {
+		Ref<ConcavePolygonShape3D> loaded = ResourceLoader::load(save_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+		REQUIRE(loaded.is_valid());
+		REQUIRE(loaded->has_lazy_properties());
+
+		CHECK(loaded->get_rid().is_valid());
+		CHECK_FALSE(loaded->has_lazy_properties());
+		CHECK(loaded->get_faces() == faces);
+	}
+
+	SUBCASE("Toggling backface collision rebuilds the physics shape") {
+		Ref<ConcavePolygonShape3D> loaded = ResourceLoader::load(save_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+		REQUIRE(loaded.is_valid());
+		REQUIRE(loaded->has_lazy_properties());
+
+		Array empty_signal_args = { {} };
+		SIGNAL_WATCH(loaded.ptr(), "changed");
+		loaded->set_backface_collision_enabled(false);
+		SIGNAL_CHECK("changed", empty_signal_args);
+		SIGNAL_UNWATCH(loaded.ptr(), "changed");
+
+		CHECK_FALSE(loaded->has_lazy_properties());
+		CHECK_FALSE(loaded->is_backface_collision_enabled());
+		CHECK(loaded->get_faces() == faces);
+	}
+
+	SUBCASE("Setting the faces discards the lazy value") {
+		Ref<ConcavePolygonShape3D> loaded = ResourceLoader::load(save_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+		REQUIRE(loaded.is_valid());
+		REQUIRE(loaded->has_lazy_properties());
+
+		const Vector<Vector3> new_faces = _make_faces(2);
+		loaded->set_faces(new_faces);
+		CHECK_FALSE(loaded->has_lazy_properties());
+		CHECK(loaded->get_faces() == new_faces);
+	}
+
+	SUBCASE("Small values are loaded right away") {
+		ProjectSettings::get_singleton()->set_setting("resource_loader/lazy_load_min_size", faces.size() * sizeof(Vector3) + 1);
+
+		Ref<ConcavePolygonShape3D> loaded = ResourceLoader::load(save_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+		REQUIRE(loaded.is_valid());
+		CHECK_FALSE(loaded->has_lazy_properties());
+		CHECK(loaded->get_faces() == faces);
+	}
+
+	ProjectSettings::get_singleton()->set_setting("resource_loader/lazy_load_min_size", 0);
+}
+
+} // namespace TestConcavePolygonShape3D
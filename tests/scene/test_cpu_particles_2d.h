@@ -0,0 +1,80 @@
+/**************************************************************************/
+/*  test_cpu_particles_2d.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "scene/2d/cpu_particles_2d.h"
+#include "scene/main/window.h"
+
+#include "tests/test_macros.h"
+
+namespace TestCPUParticles2D {
+
+// Runs a fixed seed emitter for a second and returns the buffer it hands to the multimesh.
+static Vector<float> simulate(int p_amount, bool p_use_threads) {
+	CPUParticles2D *particles = memnew(CPUParticles2D);
+	particles->set_use_threads(p_use_threads);
+	particles->set_amount(p_amount);
+	particles->set_use_fixed_seed(true);
+	particles->set_seed(1234);
+	particles->set_lifetime(0.5);
+	particles->set_emission_shape(CPUParticles2D::EMISSION_SHAPE_RING);
+	particles->set_emission_ring_radius(20.0);
+	particles->set_emission_ring_inner_radius(5.0);
+	particles->set_spread(180.0);
+	particles->set_param_min(CPUParticles2D::PARAM_INITIAL_LINEAR_VELOCITY, 10.0);
+	particles->set_param_max(CPUParticles2D::PARAM_INITIAL_LINEAR_VELOCITY, 40.0);
+	particles->set_param_min(CPUParticles2D::PARAM_ANGULAR_VELOCITY, -90.0);
+	particles->set_param_max(CPUParticles2D::PARAM_ANGULAR_VELOCITY, 90.0);
+	particles->set_param_min(CPUParticles2D::PARAM_SCALE, 0.5);
+	particles->set_param_max(CPUParticles2D::PARAM_SCALE, 2.0);
+	SceneTree::get_singleton()->get_root()->add_child(particles);
+
+	for (int i = 0; i < 60; i++) {
+		SceneTree::get_singleton()->process(1.0 / 60.0);
+	}
+	RS::get_singleton()->emit_signal(SNAME("frame_pre_draw"));
+	Vector<float> buffer = RS::get_singleton()->multimesh_get_buffer(particles->get_multimesh());
+
+	memdelete(particles);
+	return buffer;
+}
+
+TEST_CASE("[SceneTree][CPUParticles2D] Threaded processing matches serial processing") {
+	// Enough particles to take the WorkerThreadPool path, with a partial last batch.
+	const int amount = 4100;
+	const Vector<float> serial = simulate(amount, false);
+	const Vector<float> threaded = simulate(amount, true);
+
+	REQUIRE(serial.size() == amount * (8 + 4 + 4));
+	CHECK_MESSAGE(threaded == serial, "Threaded and serial processing should give the same particles, bit for bit.");
+}
+
+} // namespace TestCPUParticles2D
@@ -30,6 +30,8 @@
 
 #pragma once
 
+#include "scene/2d/node_2d.h"
+#include "scene/gui/control.h"
 #include "scene/resources/packed_scene.h"
 
 #include "tests/test_macros.h"
@@ -280,4 +282,120 @@ TEST_CASE("[PackedScene] Recreate State") {
 	memdelete(scene);
 }
 
+static Node *_create_wide_scene(int p_children) {
+	Node *scene = memnew(Node);
+	scene->set_name("TestScene");
+	for (int i = 0; i < p_children; i++) {
+		Node *child = memnew(Node);
+		child->set_name(vformat("Child%d", i));
+		scene->add_child(child);
+		child->set_owner(scene);
+	}
+	return scene;
+}
+
+TEST_CASE("[PackedScene] Instantiate Packed Scene Incrementally") {
+	Node *scene = _create_wide_scene(10);
+	Ref<PackedScene> packed_scene;
+	packed_scene.instantiate();
+	packed_scene->pack(scene);
+
+	Ref<PackedSceneInstantiation> instantiation = packed_scene->instantiate_incremental();
+	REQUIRE(instantiation.is_valid());
+	CHECK(instantiation->get_progress() == 0.0);
+
+	// With no time budget, a single node is created per step.
+	int steps = 0;
+	while (!instantiation->step(0)) {
+		CHECK(instantiation->get_node() == nullptr);
+		steps++;
+	}
+	CHECK(steps == 10);
+	CHECK(instantiation->is_finished());
+	CHECK(instantiation->get_progress() == 1.0);
+
+	Node *instance = instantiation->get_node();
+	REQUIRE(instance != nullptr);
+	CHECK(instance->get_name() == "TestScene");
+	CHECK(instance->get_child_count() == 10);
+	CHECK(instance->get_child(9)->get_name() == "Child9");
+	CHECK(instance->get_child(9)->get_owner() == instance);
+
+	memdelete(scene);
+	memdelete(instance);
+}
+
+TEST_CASE("[PackedScene] Abandon Incremental Instantiation") {
+	Node *scene = _create_wide_scene(10);
+	Ref<PackedScene> packed_scene;
+	packed_scene.instantiate();
+	packed_scene->pack(scene);
+
+	Ref<PackedSceneInstantiation> instantiation = packed_scene->instantiate_incremental();
+	REQUIRE(instantiation.is_valid());
+	CHECK_FALSE(instantiation->step(0));
+	CHECK_FALSE(instantiation->step(0));
+
+	// The partially built nodes are freed along with the instantiation.
+	instantiation.unref();
+
+	memdelete(scene);
+}
+
+TEST_CASE("[PackedScene] Incremental Instantiation Node Budget") {
+	Node *scene = _create_wide_scene(5000);
+	Ref<PackedScene> packed_scene;
+	packed_scene.instantiate();
+	packed_scene->pack(scene);
+
+	// With a generous time budget, each step stops after the given number of nodes.
+	const int64_t time_budget = 60 * 1000 * 1000;
+	const int node_count = 5001;
+	Ref<PackedSceneInstantiation> instantiation = packed_scene->instantiate_incremental();
+	REQUIRE(instantiation.is_valid());
+	int steps = 0;
+	while (!instantiation->step(time_budget, 100)) {
+		steps++;
+		CHECK(instantiation->get_progress() == doctest::Approx(float(steps * 100) / node_count));
+	}
+	CHECK(steps == 50);
+
+	Node *instance = instantiation->get_node();
+	REQUIRE(instance != nullptr);
+	CHECK(instance->get_child_count() == 5000);
+
+	memdelete(scene);
+	memdelete(instance);
+}
+
+TEST_CASE("[SceneTree][PackedScene] Instantiate Packed Scene Properties Repeatedly") {
+	Node2D *scene = memnew(Node2D);
+	scene->set_name("TestScene");
+	scene->set_position(Vector2(1, 2));
+	Control *control = memnew(Control);
+	control->set_name("Control");
+	control->set_offset(SIDE_LEFT, 5);
+	control->set_tooltip_text("Tooltip");
+	scene->add_child(control);
+	control->set_owner(scene);
+
+	Ref<PackedScene> packed_scene;
+	packed_scene.instantiate();
+	packed_scene->pack(scene);
+
+	// The first instantiation builds the cached plan, the following ones reuse it.
+	for (int i = 0; i < 3; i++) {
+		Node2D *instance = Object::cast_to<Node2D>(packed_scene->instantiate());
+		REQUIRE(instance != nullptr);
+		CHECK(instance->get_position() == Vector2(1, 2));
+		Control *instance_control = Object::cast_to<Control>(instance->get_child(0));
+		REQUIRE(instance_control != nullptr);
+		CHECK(instance_control->get_offset(SIDE_LEFT) == 5);
+		CHECK(instance_control->get_tooltip_text() == "Tooltip");
+		memdelete(instance);
+	}
+
+	memdelete(scene);
+}
+
 } // namespace TestPackedScene
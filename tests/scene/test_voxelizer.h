@@ -0,0 +1,119 @@
+/**************************************************************************/
+/*  test_voxelizer.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "scene/3d/voxelizer.h"
+#include "scene/resources/3d/primitive_meshes.h"
+
+#include "tests/test_macros.h"
+
+namespace TestVoxelizer {
+
+struct BakeOutput {
+	Vector<uint8_t> octree_cells;
+	Vector<uint8_t> data_cells;
+	Vector<int> level_cell_count;
+	uint64_t plotted_faces = 0;
+	uint64_t usec = 0;
+};
+
+// Bakes every mesh at every transform. The voxelizer runs on the CPU only.
+static BakeOutput bake(int p_subdiv, const AABB &p_bounds, const Vector<Ref<Mesh>> &p_meshes, const Vector<Transform3D> &p_xforms, bool p_use_threads = true) {
+	BakeOutput output;
+	Voxelizer baker;
+	baker.set_use_threads(p_use_threads);
+	const Vector<Ref<Material>> no_materials;
+
+	const uint64_t from = OS::get_singleton()->get_ticks_usec();
+	baker.begin_bake(p_subdiv, p_bounds, 1.0);
+	for (Ref<Mesh> mesh : p_meshes) {
+		for (const Transform3D &xform : p_xforms) {
+			CHECK(baker.plot_mesh(xform, mesh, no_materials, Ref<Material>(), nullptr) == Voxelizer::BAKE_RESULT_OK);
+			output.plotted_faces += baker.get_bake_steps(mesh);
+		}
+	}
+	baker.end_bake();
+	output.usec = OS::get_singleton()->get_ticks_usec() - from;
+
+	output.octree_cells = baker.get_voxel_gi_octree_cells();
+	output.data_cells = baker.get_voxel_gi_data_cells();
+	output.level_cell_count = baker.get_voxel_gi_level_cell_count();
+	return output;
+}
+
+static Ref<SphereMesh> create_sphere(int p_radial_segments, int p_rings) {
+	Ref<SphereMesh> sphere;
+	sphere.instantiate();
+	sphere->set_radius(1.0);
+	sphere->set_height(2.0);
+	sphere->set_radial_segments(p_radial_segments);
+	sphere->set_rings(p_rings);
+	return sphere;
+}
+
+TEST_CASE("[SceneTree][Voxelizer] Threaded bake matches serial bake") {
+	// Enough faces to plot on worker threads, in two meshes so faces are gathered across calls.
+	Vector<Ref<Mesh>> meshes;
+	meshes.push_back(create_sphere(64, 32));
+	meshes.push_back(create_sphere(16, 8));
+
+	Vector<Transform3D> xforms;
+	xforms.push_back(Transform3D());
+	xforms.push_back(Transform3D(Basis().scaled(Vector3(0.5, 0.5, 0.5)), Vector3(1.5, 0.0, 0.0)));
+
+	const AABB bounds(Vector3(-2, -2, -2), Vector3(4, 4, 4));
+	const BakeOutput serial = bake(6, bounds, meshes, xforms, false);
+	const BakeOutput threaded = bake(6, bounds, meshes, xforms, true);
+
+	REQUIRE(serial.level_cell_count.size() == 7);
+	CHECK_MESSAGE(serial.level_cell_count[0] == 1, "There should be a single root cell.");
+	CHECK_MESSAGE(serial.level_cell_count[6] > 0, "Surfaces should be plotted to leaf cells.");
+	CHECK_MESSAGE(threaded.plotted_faces >= 1024, "The threaded bake should have enough faces to plot on worker threads.");
+
+	CHECK(threaded.level_cell_count == serial.level_cell_count);
+	CHECK_MESSAGE(threaded.octree_cells == serial.octree_cells, "Threaded and serial bakes should build the same octree.");
+	CHECK_MESSAGE(threaded.data_cells == serial.data_cells, "Threaded and serial bakes should give the same voxel data, bit for bit.");
+}
+
+TEST_CASE("[SceneTree][Voxelizer] Faces outside the bounds are not plotted") {
+	Vector<Ref<Mesh>> meshes;
+	meshes.push_back(create_sphere(16, 8));
+
+	Vector<Transform3D> xforms;
+	xforms.push_back(Transform3D(Basis(), Vector3(10, 0, 0)));
+
+	const BakeOutput output = bake(6, AABB(Vector3(-2, -2, -2), Vector3(4, 4, 4)), meshes, xforms);
+	REQUIRE(output.level_cell_count.size() == 7);
+	CHECK(output.level_cell_count[0] == 1);
+	CHECK(output.level_cell_count[6] == 0);
+}
+
+} // namespace TestVoxelizer
@@ -0,0 +1,110 @@
+/**************************************************************************/
+/*  test_raster_occlusion_cull.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "servers/rendering/raster_occlusion_cull.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRasterOcclusionCull {
+
+static bool is_box_occluded(const RasterOcclusionCull::RasterHZBuffer &p_buffer, const AABB &p_box, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_orthogonal) {
+	const real_t bounds[6] = {
+		p_box.position.x, p_box.position.y, p_box.position.z,
+		p_box.position.x + p_box.size.x, p_box.position.y + p_box.size.y, p_box.position.z + p_box.size.z
+	};
+	uint64_t occlusion_timeout = 0;
+	return p_buffer.is_occluded(bounds, p_cam_transform.origin, p_cam_transform.affine_inverse(), p_cam_projection, p_cam_projection.get_z_near(), p_orthogonal, occlusion_timeout);
+}
+
+static void add_quad(RasterOcclusionCull::RasterHZBuffer &p_buffer, const Vector3 &p_a, const Vector3 &p_b, const Vector3 &p_c, const Vector3 &p_d) {
+	const Vector3 vertices[4] = { p_a, p_b, p_c, p_d };
+	const uint32_t indices[6] = { 0, 1, 2, 0, 2, 3 };
+	p_buffer.add_occluder(vertices, 4, indices, 6);
+}
+
+TEST_CASE("[RasterOcclusionCull] Perspective occlusion") {
+	RasterOcclusionCull::RasterHZBuffer buffer;
+	buffer.resize(Size2i(64, 64));
+
+	Transform3D cam_transform;
+	Projection cam_projection;
+	cam_projection.set_perspective(60, 1, 0.05, 100);
+
+	buffer.begin(cam_transform, cam_projection, false);
+	// Wall in front of the camera.
+	add_quad(buffer, Vector3(-2, -2, -5), Vector3(2, -2, -5), Vector3(2, 2, -5), Vector3(-2, 2, -5));
+	// Floor going behind the camera, which must be clipped by the near plane.
+	add_quad(buffer, Vector3(-10, -1, 10), Vector3(10, -1, 10), Vector3(10, -1, -10), Vector3(-10, -1, -10));
+	buffer.end();
+
+	CHECK_MESSAGE(is_box_occluded(buffer, AABB(Vector3(-0.5, -0.5, -11), Vector3(1, 1, 1)), cam_transform, cam_projection, false),
+			"A box behind the wall should be occluded.");
+	CHECK_MESSAGE(!is_box_occluded(buffer, AABB(Vector3(-0.5, -0.5, -3), Vector3(1, 1, 1)), cam_transform, cam_projection, false),
+			"A box in front of the wall should not be occluded.");
+	CHECK_MESSAGE(!is_box_occluded(buffer, AABB(Vector3(4, 0, -11), Vector3(1, 1, 1)), cam_transform, cam_projection, false),
+			"A box beside the wall should not be occluded.");
+	CHECK_MESSAGE(is_box_occluded(buffer, AABB(Vector3(-0.5, -3, -4), Vector3(1, 1, 1)), cam_transform, cam_projection, false),
+			"A box below the floor should be occluded.");
+}
+
+TEST_CASE("[RasterOcclusionCull] Orthogonal occlusion") {
+	RasterOcclusionCull::RasterHZBuffer buffer;
+	buffer.resize(Size2i(64, 64));
+
+	Transform3D cam_transform;
+	Projection cam_projection;
+	cam_projection.set_orthogonal(10, 1, 0.05, 100);
+
+	buffer.begin(cam_transform, cam_projection, true);
+	add_quad(buffer, Vector3(-2, -2, -5), Vector3(-2, 2, -5), Vector3(2, 2, -5), Vector3(2, -2, -5));
+	buffer.end();
+
+	CHECK(is_box_occluded(buffer, AABB(Vector3(-0.5, -0.5, -11), Vector3(1, 1, 1)), cam_transform, cam_projection, true));
+	CHECK(!is_box_occluded(buffer, AABB(Vector3(-0.5, -0.5, -3), Vector3(1, 1, 1)), cam_transform, cam_projection, true));
+	CHECK(!is_box_occluded(buffer, AABB(Vector3(3, 3, -11), Vector3(1, 1, 1)), cam_transform, cam_projection, true));
+}
+
+TEST_CASE("[RasterOcclusionCull] Empty buffer") {
+	RasterOcclusionCull::RasterHZBuffer buffer;
+	buffer.resize(Size2i(32, 32));
+
+	Transform3D cam_transform;
+	Projection cam_projection;
+	cam_projection.set_perspective(60, 1, 0.05, 100);
+
+	buffer.begin(cam_transform, cam_projection, false);
+	buffer.end();
+
+	CHECK(!is_box_occluded(buffer, AABB(Vector3(-0.5, -0.5, -11), Vector3(1, 1, 1)), cam_transform, cam_projection, false));
+}
+
+} // namespace TestRasterOcclusionCull
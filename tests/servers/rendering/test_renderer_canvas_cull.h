@@ -0,0 +1,178 @@
+/**************************************************************************/
+/*  test_renderer_canvas_cull.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "servers/rendering/renderer_canvas_cull.h"
+#include "servers/rendering/rendering_server_globals.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRendererCanvasCull {
+
+// Enough children for the parent to get a grid index over them.
+static const int GRID_SIZE = 16;
+static const real_t CELL_SIZE = 64;
+static const Rect2 CLIP_RECT = Rect2(100, 100, 300, 300);
+
+struct CanvasCullScene {
+	RID canvas;
+	RID parent;
+	RID other_parent;
+	LocalVector<RID> children;
+
+	CanvasCullScene() {
+		RenderingServer *rs = RenderingServer::get_singleton();
+		canvas = rs->canvas_create();
+		parent = rs->canvas_item_create();
+		rs->canvas_item_set_parent(parent, canvas);
+		other_parent = rs->canvas_item_create();
+		rs->canvas_item_set_parent(other_parent, canvas);
+		rs->canvas_item_add_rect(other_parent, Rect2(200, 200, 8, 8), Color(1, 0, 0));
+
+		for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+			RID child = rs->canvas_item_create();
+			rs->canvas_item_set_parent(child, parent);
+			rs->canvas_item_set_transform(child, Transform2D(0, Vector2(i % GRID_SIZE, i / GRID_SIZE) * CELL_SIZE));
+			rs->canvas_item_add_rect(child, Rect2(0, 0, CELL_SIZE / 2, CELL_SIZE / 2), Color(1, 1, 1));
+			children.push_back(child);
+		}
+	}
+
+	~CanvasCullScene() {
+		RenderingServer *rs = RenderingServer::get_singleton();
+		for (const RID &child : children) {
+			rs->free(child);
+		}
+		rs->free(other_parent);
+		rs->free(parent);
+		rs->free(canvas);
+	}
+};
+
+// Bounds are only indexed once they have been unchanged for a frame.
+static void advance_frames() {
+	for (int i = 0; i < 2; i++) {
+		RSG::rasterizer->begin_frame(0.0);
+		RSG::rasterizer->end_frame(false);
+	}
+}
+
+static void check_same_items_as_unculled(const CanvasCullScene &p_scene) {
+	LocalVector<RendererCanvasRender::Item *> culled_items;
+	RSG::canvas->cull_canvas(p_scene.canvas, Transform2D(), CLIP_RECT, UINT32_MAX, culled_items);
+
+	LocalVector<RendererCanvasRender::Item *> all_items;
+	RSG::canvas->set_subtree_culling_enabled(false);
+	RSG::canvas->cull_canvas(p_scene.canvas, Transform2D(), CLIP_RECT, UINT32_MAX, all_items);
+	RSG::canvas->set_subtree_culling_enabled(true);
+
+	REQUIRE(culled_items.size() == all_items.size());
+	for (uint32_t i = 0; i < all_items.size(); i++) {
+		CHECK_MESSAGE(culled_items[i] == all_items[i], vformat("Item %d should be drawn in the same order with culling.", i));
+	}
+}
+
+// Checks right after a change, when the index is stale, and again once it has been rebuilt.
+static void check_after_change(const CanvasCullScene &p_scene) {
+	check_same_items_as_unculled(p_scene);
+	advance_frames();
+	check_same_items_as_unculled(p_scene);
+	advance_frames();
+	check_same_items_as_unculled(p_scene);
+	CHECK(RSG::canvas->canvas_item_has_child_index(p_scene.parent));
+}
+
+TEST_CASE("[SceneTree][RendererCanvasCull] Indexed children are drawn like unculled ones") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	CanvasCullScene scene;
+
+	advance_frames();
+	check_same_items_as_unculled(scene);
+	advance_frames();
+	check_same_items_as_unculled(scene);
+	REQUIRE(RSG::canvas->canvas_item_has_child_index(scene.parent));
+
+	LocalVector<RendererCanvasRender::Item *> items;
+	RSG::canvas->cull_canvas(scene.canvas, Transform2D(), CLIP_RECT, UINT32_MAX, items);
+	CHECK_MESSAGE(items.size() < scene.children.size() / 4, "Most children are outside the clip rect.");
+
+	SUBCASE("Moving children") {
+		// Outside to inside, inside to outside, and far away.
+		rs->canvas_item_set_transform(scene.children[GRID_SIZE * GRID_SIZE - 1], Transform2D(0, Vector2(150, 150)));
+		rs->canvas_item_set_transform(scene.children[GRID_SIZE * 3 + 3], Transform2D(0, Vector2(900, 900)));
+		rs->canvas_item_set_transform(scene.children[GRID_SIZE * 2 + 2], Transform2D(0, Vector2(-5000, 5000)));
+		check_after_change(scene);
+
+		// Moving the parent moves everything.
+		rs->canvas_item_set_transform(scene.parent, Transform2D(0, Vector2(-300, -200)));
+		check_after_change(scene);
+	}
+
+	SUBCASE("Reparenting children") {
+		// Leaves an indexed parent while in view, then joins it again out of view.
+		rs->canvas_item_set_parent(scene.children[GRID_SIZE * 3 + 3], scene.other_parent);
+		check_after_change(scene);
+		rs->canvas_item_set_parent(scene.children[GRID_SIZE * 3 + 3], scene.parent);
+		rs->canvas_item_set_transform(scene.children[GRID_SIZE * 3 + 3], Transform2D(0, Vector2(800, 40)));
+		check_after_change(scene);
+
+		// Joins an indexed parent inside the view.
+		RID child = rs->canvas_item_create();
+		rs->canvas_item_add_rect(child, Rect2(0, 0, 10, 10), Color(0, 1, 0));
+		rs->canvas_item_set_transform(child, Transform2D(0, Vector2(250, 250)));
+		rs->canvas_item_set_parent(child, scene.parent);
+		check_after_change(scene);
+		rs->free(child);
+		check_after_change(scene);
+	}
+
+	SUBCASE("Toggling visibility") {
+		rs->canvas_item_set_visible(scene.children[GRID_SIZE * 3 + 3], false);
+		rs->canvas_item_set_visible(scene.children[GRID_SIZE * 10 + 10], false);
+		check_after_change(scene);
+		rs->canvas_item_set_visible(scene.children[GRID_SIZE * 3 + 3], true);
+		rs->canvas_item_set_visible(scene.children[GRID_SIZE * 10 + 10], true);
+		check_after_change(scene);
+	}
+
+	SUBCASE("Changing commands") {
+		// A child far outside the view starts drawing into it, and one in view stops drawing.
+		rs->canvas_item_clear(scene.children[GRID_SIZE * GRID_SIZE - 1]);
+		rs->canvas_item_add_rect(scene.children[GRID_SIZE * GRID_SIZE - 1], Rect2(-800, -800, 50, 50), Color(0, 0, 1));
+		rs->canvas_item_clear(scene.children[GRID_SIZE * 3 + 3]);
+		check_after_change(scene);
+
+		rs->canvas_item_add_rect(scene.children[GRID_SIZE * 3 + 3], Rect2(0, 0, 4, 4), Color(0, 0, 1));
+		check_after_change(scene);
+	}
+}
+
+} // namespace TestRendererCanvasCull
@@ -0,0 +1,405 @@
+/**************************************************************************/
+/*  test_rendering_benchmark.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/random_pcg.h"
+#include "modules/modules_enabled.gen.h" // For raycast.
+#include "servers/rendering/dummy/storage/light_storage.h"
+#include "servers/rendering/raster_occlusion_cull.h"
+#include "servers/rendering/rendering_server_globals.h"
+
+#ifdef MODULE_RAYCAST_ENABLED
+#include "modules/raycast/register_types.h"
+#endif
+
+#include "tests/test_macros.h"
+
+// Measures the CPU side of the rendering server: instance updates, light pairing,
+// scene culling and canvas culling. Runs with the dummy rasterizer, so no GPU is needed.
+// The stress run lives in tests/test_benchmarks.h.
+
+namespace TestRenderingBenchmark {
+
+// Values of rendering/occlusion_culling/backend.
+enum OcclusionBackend {
+	OCCLUSION_BACKEND_RAYCAST,
+	OCCLUSION_BACKEND_RASTER,
+};
+
+struct BenchmarkConfig {
+	int mesh_count = 0;
+	int light_count = 0;
+	// The first lights cast shadows, so their shadow casters get culled every frame.
+	int shadowed_light_count = 0;
+	int canvas_item_count = 0;
+	// Occluders are culled against through a viewport using occlusion_backend.
+	int occluder_count = 0;
+	OcclusionBackend occlusion_backend = OCCLUSION_BACKEND_RASTER;
+	int frame_count = 0;
+	// Fraction of the meshes and canvas items moved each frame.
+	real_t moving_ratio = 0.1;
+};
+
+// Only reaches the protected singleton, so that a run can switch occlusion culling backends.
+class OcclusionCullSingleton : public RendererSceneOcclusionCull {
+public:
+	static void set(RendererSceneOcclusionCull *p_backend) { singleton = p_backend; }
+};
+
+static RendererSceneOcclusionCull *get_raycast_occlusion_backend() {
+#ifdef MODULE_RAYCAST_ENABLED
+	return get_raycast_occlusion_cull();
+#else
+	return nullptr;
+#endif
+}
+
+static String get_occlusion_backend_name(OcclusionBackend p_backend) {
+	return p_backend == OCCLUSION_BACKEND_RAYCAST ? "Raycast" : "Raster";
+}
+
+struct StageTiming {
+	uint64_t total_usec = 0;
+	uint64_t min_usec = UINT64_MAX;
+	uint64_t max_usec = 0;
+	uint32_t samples = 0;
+
+	void add(uint64_t p_usec) {
+		total_usec += p_usec;
+		min_usec = MIN(min_usec, p_usec);
+		max_usec = MAX(max_usec, p_usec);
+		samples++;
+	}
+
+	Dictionary to_dictionary() const {
+		Dictionary result;
+		result["samples"] = samples;
+		result["avg_msec"] = samples ? double(total_usec) / double(samples) / 1000.0 : 0.0;
+		result["min_msec"] = samples ? double(min_usec) / 1000.0 : 0.0;
+		result["max_msec"] = double(max_usec) / 1000.0;
+		return result;
+	}
+};
+
+#define BENCHMARK_STAGE(m_timing, m_code)                                   \
+	{                                                                       \
+		const uint64_t stage_begin = OS::get_singleton()->get_ticks_usec(); \
+		m_code;                                                             \
+		m_timing.add(OS::get_singleton()->get_ticks_usec() - stage_begin);  \
+	}
+
+static Vector3 random_position(RandomPCG &p_rng, real_t p_extent) {
+	return Vector3(p_rng.random(-p_extent, p_extent), p_rng.random(-p_extent * 0.1, p_extent * 0.1), p_rng.random(-p_extent, p_extent));
+}
+
+static Dictionary run_benchmark(const BenchmarkConfig &p_config) {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RandomPCG rng(1234);
+
+	// The rendering server creates its own backend in tests, so install the requested one for this run.
+	// Everything using it is freed before the previous one is restored.
+	RendererSceneOcclusionCull *previous_occlusion_cull = RendererSceneOcclusionCull::get_singleton();
+	RendererSceneOcclusionCull *raster_occlusion_cull = nullptr;
+	if (p_config.occluder_count > 0) {
+		if (p_config.occlusion_backend == OCCLUSION_BACKEND_RASTER) {
+			raster_occlusion_cull = memnew(RasterOcclusionCull);
+			OcclusionCullSingleton::set(raster_occlusion_cull);
+		} else {
+			RendererSceneOcclusionCull *raycast_occlusion_cull = get_raycast_occlusion_backend();
+			ERR_FAIL_NULL_V_MSG(raycast_occlusion_cull, Dictionary(), "The raycast occlusion culling backend is not available.");
+			OcclusionCullSingleton::set(raycast_occlusion_cull);
+		}
+	}
+
+	// Spread everything so that roughly a constant number of meshes ends up in each light.
+	const real_t extent = Math::sqrt((real_t)MAX(p_config.mesh_count, 1)) * 2.0;
+	const Size2 viewport_size(1920, 1080);
+
+	/* 3D scene */
+
+	RID scenario = rs->scenario_create();
+
+	RID camera = rs->camera_create();
+	rs->camera_set_perspective(camera, 70, 0.05, extent);
+
+	Array arrays;
+	arrays.resize(RS::ARRAY_MAX);
+	arrays[RS::ARRAY_VERTEX] = PackedVector3Array({ Vector3(-1, -1, 0), Vector3(1, -1, 0), Vector3(0, 1, 0) });
+	RID mesh = rs->mesh_create();
+	rs->mesh_add_surface_from_arrays(mesh, RS::PRIMITIVE_TRIANGLES, arrays);
+
+	LocalVector<RID> mesh_instances;
+	for (int i = 0; i < p_config.mesh_count; i++) {
+		RID instance = rs->instance_create2(mesh, scenario);
+		// The dummy mesh storage doesn't compute bounds.
+		rs->instance_set_custom_aabb(instance, AABB(Vector3(-1, -1, -1), Vector3(2, 2, 2)));
+		rs->instance_set_transform(instance, Transform3D(Basis(), random_position(rng, extent)));
+		if (i % 4 == 0) {
+			// Exercise visibility range (HLOD) selection.
+			rs->instance_geometry_set_visibility_range(instance, 0, extent * 0.25, 0, 0, RS::VISIBILITY_RANGE_FADE_DISABLED);
+		}
+		mesh_instances.push_back(instance);
+	}
+
+	// The dummy light storage keeps lights inert unless asked to track them.
+	RendererDummy::LightStorage *dummy_light_storage = RendererDummy::LightStorage::get_singleton();
+	if (dummy_light_storage) {
+		dummy_light_storage->set_lights_enabled(true);
+	}
+
+	LocalVector<RID> lights;
+	LocalVector<RID> light_instances;
+	for (int i = 0; i < p_config.light_count; i++) {
+		RID light = i % 2 ? rs->spot_light_create() : rs->omni_light_create();
+		rs->light_set_param(light, RS::LIGHT_PARAM_RANGE, 8.0);
+		rs->light_set_shadow(light, i < p_config.shadowed_light_count);
+		RID instance = rs->instance_create2(light, scenario);
+		rs->instance_set_transform(instance, Transform3D(Basis(), random_position(rng, extent)));
+		lights.push_back(light);
+		light_instances.push_back(instance);
+	}
+
+	// Upright walls scattered among the meshes, so that the camera looking around has some of them hidden.
+	const Vector3 wall_extents(3, 2, 0.25);
+	PackedVector3Array wall_vertices;
+	for (int i = 0; i < 8; i++) {
+		wall_vertices.push_back(Vector3(i & 1 ? wall_extents.x : -wall_extents.x, i & 2 ? wall_extents.y : -wall_extents.y, i & 4 ? wall_extents.z : -wall_extents.z));
+	}
+	const PackedInt32Array wall_indices = {
+		0, 2, 1, 1, 2, 3, // -Z
+		4, 5, 6, 5, 7, 6, // +Z
+		0, 1, 4, 1, 5, 4, // -Y
+		2, 6, 3, 3, 6, 7, // +Y
+		0, 4, 2, 2, 4, 6, // -X
+		1, 3, 5, 3, 7, 5, // +X
+	};
+
+	LocalVector<RID> occluders;
+	LocalVector<RID> occluder_instances;
+	if (p_config.occluder_count > 0) {
+		RID occluder = rs->occluder_create();
+		rs->occluder_set_mesh(occluder, wall_vertices, wall_indices);
+		occluders.push_back(occluder);
+		for (int i = 0; i < p_config.occluder_count; i++) {
+			RID instance = rs->instance_create2(occluder, scenario);
+			rs->instance_set_transform(instance, Transform3D(Basis(Vector3(0, 1, 0), rng.random((real_t)0, (real_t)Math::TAU)), random_position(rng, extent)));
+			occluder_instances.push_back(instance);
+		}
+	}
+
+	// Occlusion culling buffers belong to viewports, so cull through one when there are occluders.
+	RID viewport;
+	if (p_config.occluder_count > 0) {
+		viewport = rs->viewport_create();
+		rs->viewport_set_size(viewport, viewport_size.width, viewport_size.height);
+		rs->viewport_set_scenario(viewport, scenario);
+		rs->viewport_set_use_occlusion_culling(viewport, true);
+		// Normally done by the viewport when it's drawn, use a fixed size so that the backends are comparable.
+		RendererSceneOcclusionCull::get_singleton()->buffer_set_size(viewport, Size2i(320, 180));
+	}
+
+	// Positional lights only get their shadow casters culled with a shadow atlas.
+	const RID shadow_atlas = p_config.shadowed_light_count > 0 ? RSG::light_storage->shadow_atlas_create() : RID();
+
+	/* 2D canvas */
+
+	RID canvas = rs->canvas_create();
+	LocalVector<RID> canvas_groups;
+	LocalVector<RID> canvas_items;
+	const real_t canvas_extent = Math::sqrt((real_t)MAX(p_config.canvas_item_count, 1)) * 32.0;
+	for (int i = 0; i < p_config.canvas_item_count; i++) {
+		if (i % 64 == 0) {
+			// Group items the way scenes usually do, each group covering a region of the canvas.
+			RID group = rs->canvas_item_create();
+			rs->canvas_item_set_parent(group, canvas);
+			rs->canvas_item_set_transform(group, Transform2D(0, Vector2(rng.random((real_t)0, canvas_extent), rng.random((real_t)0, canvas_extent))));
+			canvas_groups.push_back(group);
+		}
+		RID item = rs->canvas_item_create();
+		rs->canvas_item_set_parent(item, canvas_groups[canvas_groups.size() - 1]);
+		rs->canvas_item_set_transform(item, Transform2D(0, Vector2(rng.random(0, 256), rng.random(0, 256))));
+		rs->canvas_item_add_rect(item, Rect2(0, 0, 16, 16), Color(1, 1, 1));
+		canvas_items.push_back(item);
+	}
+
+	RendererCanvasCull::Canvas *canvas_data = RSG::canvas->canvas_owner.get_or_null(canvas);
+
+	/* Frames */
+
+	Ref<RenderSceneBuffersExtension> render_buffers;
+	render_buffers.instantiate();
+	Ref<XRInterface> xr_interface;
+
+	StageTiming instance_update_timing;
+	StageTiming light_update_timing;
+	StageTiming scene_cull_timing;
+	StageTiming canvas_update_timing;
+	StageTiming canvas_cull_timing;
+
+	// Settle the initial state so that the first frame doesn't skew the results.
+	RSG::scene->update();
+	RSG::canvas->update();
+
+	const int moving_meshes = p_config.mesh_count * p_config.moving_ratio;
+	const int moving_canvas_items = p_config.canvas_item_count * p_config.moving_ratio;
+
+	for (int frame = 0; frame < p_config.frame_count; frame++) {
+		RSG::rasterizer->begin_frame(1.0 / 60.0);
+
+		for (int i = 0; i < moving_meshes; i++) {
+			rs->instance_set_transform(mesh_instances[rng.rand() % mesh_instances.size()], Transform3D(Basis(), random_position(rng, extent)));
+		}
+		BENCHMARK_STAGE(instance_update_timing, RSG::scene->update());
+
+		for (uint32_t i = 0; i < light_instances.size(); i++) {
+			rs->instance_set_transform(light_instances[i], Transform3D(Basis(), random_position(rng, extent)));
+		}
+		BENCHMARK_STAGE(light_update_timing, RSG::scene->update());
+
+		const real_t angle = Math::TAU * frame / MAX(p_config.frame_count, 1);
+		rs->camera_set_transform(camera, Transform3D(Basis(Vector3(0, 1, 0), angle), Vector3(0, 2, 0)));
+		BENCHMARK_STAGE(scene_cull_timing, RSG::scene->render_camera(render_buffers, camera, scenario, viewport, viewport_size, 0, 1.0, shadow_atlas, xr_interface));
+
+		for (int i = 0; i < moving_canvas_items; i++) {
+			rs->canvas_item_set_transform(canvas_items[rng.rand() % canvas_items.size()], Transform2D(0, Vector2(rng.random(0, 256), rng.random(0, 256))));
+		}
+		BENCHMARK_STAGE(canvas_update_timing, RSG::canvas->update());
+
+		const Transform2D canvas_transform(0, -Vector2(canvas_extent, canvas_extent) * 0.5 * frame / MAX(p_config.frame_count, 1));
+		BENCHMARK_STAGE(canvas_cull_timing, RSG::canvas->render_canvas(RID(), canvas_data, canvas_transform, nullptr, nullptr, Rect2(Point2(), viewport_size), RS::CANVAS_ITEM_TEXTURE_FILTER_LINEAR, RS::CANVAS_ITEM_TEXTURE_REPEAT_DISABLED, false, false, 0xFFFFFFFF));
+
+		RSG::rasterizer->end_frame(false);
+	}
+
+	/* Cleanup */
+
+	for (const RID &rid : canvas_items) {
+		rs->free(rid);
+	}
+	for (const RID &rid : canvas_groups) {
+		rs->free(rid);
+	}
+	rs->free(canvas);
+	if (shadow_atlas.is_valid()) {
+		RSG::light_storage->shadow_atlas_free(shadow_atlas);
+	}
+	if (viewport.is_valid()) {
+		rs->free(viewport);
+	}
+	for (const RID &rid : occluder_instances) {
+		rs->free(rid);
+	}
+	for (const RID &rid : occluders) {
+		rs->free(rid);
+	}
+	for (const RID &rid : light_instances) {
+		rs->free(rid);
+	}
+	for (const RID &rid : lights) {
+		rs->free(rid);
+	}
+	if (dummy_light_storage) {
+		dummy_light_storage->set_lights_enabled(false);
+	}
+	for (const RID &rid : mesh_instances) {
+		rs->free(rid);
+	}
+	rs->free(mesh);
+	rs->free(camera);
+	rs->free(scenario);
+
+	if (p_config.occluder_count > 0) {
+		if (raster_occlusion_cull) {
+			memdelete(raster_occlusion_cull);
+		}
+		OcclusionCullSingleton::set(previous_occlusion_cull);
+	}
+
+	Dictionary config;
+	config["meshes"] = p_config.mesh_count;
+	config["lights"] = p_config.light_count;
+	config["shadowed_lights"] = p_config.shadowed_light_count;
+	config["canvas_items"] = p_config.canvas_item_count;
+	config["occluders"] = p_config.occluder_count;
+	if (p_config.occluder_count > 0) {
+		config["occlusion_backend"] = get_occlusion_backend_name(p_config.occlusion_backend);
+	}
+	config["frames"] = p_config.frame_count;
+	config["moving_ratio"] = p_config.moving_ratio;
+
+	Dictionary stages;
+	stages["instance_update"] = instance_update_timing.to_dictionary();
+	stages["light_pairing"] = light_update_timing.to_dictionary();
+	stages["scene_cull"] = scene_cull_timing.to_dictionary();
+	stages["canvas_update"] = canvas_update_timing.to_dictionary();
+	stages["canvas_cull"] = canvas_cull_timing.to_dictionary();
+
+	Dictionary result;
+	result["config"] = config;
+	result["stages"] = stages;
+	return result;
+}
+
+#undef BENCHMARK_STAGE
+
+TEST_CASE("[SceneTree][RenderingBenchmark] Small scene") {
+	BenchmarkConfig config;
+	config.mesh_count = 256;
+	config.light_count = 8;
+	config.shadowed_light_count = 4;
+	config.canvas_item_count = 256;
+	config.occluder_count = 16;
+	config.frame_count = 4;
+
+	SUBCASE("Raster occlusion culling") {
+		config.occlusion_backend = OCCLUSION_BACKEND_RASTER;
+	}
+	SUBCASE("Raycast occlusion culling") {
+		if (!get_raycast_occlusion_backend()) {
+			MESSAGE("The raycast occlusion culling backend is not available, skipping.");
+			return;
+		}
+		config.occlusion_backend = OCCLUSION_BACKEND_RAYCAST;
+	}
+
+	Dictionary result = run_benchmark(config);
+	CHECK(Dictionary(result["config"])["occlusion_backend"] == get_occlusion_backend_name(config.occlusion_backend));
+	Dictionary stages = result["stages"];
+
+	CHECK(stages.size() == 5);
+	for (const Variant &stage : stages.values()) {
+		const Dictionary timing = stage;
+		CHECK_MESSAGE(int(timing["samples"]) == config.frame_count, "Every stage should be measured once per frame.");
+		CHECK(double(timing["min_msec"]) <= double(timing["max_msec"]));
+	}
+}
+
+} // namespace TestRenderingBenchmark
@@ -0,0 +1,229 @@
+/**************************************************************************/
+/*  test_shader_compiler.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "servers/rendering/shader_compiler.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestShaderCompiler {
+
+struct CompileResult {
+	Error err = FAILED;
+	ShaderCompiler::GeneratedCode gen_code;
+	HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+	bool unshaded = false;
+	int cull_mode = 0;
+	bool uses_time = false;
+	bool writes_alpha = false;
+};
+
+static CompileResult compile_shader(ShaderCompiler &p_compiler, const String &p_code) {
+	CompileResult result;
+
+	ShaderCompiler::IdentifierActions actions;
+	actions.entry_point_stages["vertex"] = ShaderCompiler::STAGE_VERTEX;
+	actions.entry_point_stages["fragment"] = ShaderCompiler::STAGE_FRAGMENT;
+	actions.render_mode_flags["unshaded"] = &result.unshaded;
+	actions.render_mode_values["cull_disabled"] = Pair<int *, int>(&result.cull_mode, 2);
+	actions.usage_flag_pointers["TIME"] = &result.uses_time;
+	actions.write_flag_pointers["ALPHA"] = &result.writes_alpha;
+	actions.uniforms = &result.uniforms;
+
+	result.err = p_compiler.compile(RS::SHADER_SPATIAL, p_code, &actions, "", result.gen_code);
+	return result;
+}
+
+static void check_same_result(const CompileResult &p_result, const CompileResult &p_expected) {
+	CHECK(p_result.unshaded == p_expected.unshaded);
+	CHECK(p_result.cull_mode == p_expected.cull_mode);
+	CHECK(p_result.uses_time == p_expected.uses_time);
+	CHECK(p_result.writes_alpha == p_expected.writes_alpha);
+	CHECK(p_result.uniforms.size() == p_expected.uniforms.size());
+	for (const KeyValue<StringName, ShaderLanguage::ShaderNode::Uniform> &E : p_expected.uniforms) {
+		REQUIRE(p_result.uniforms.has(E.key));
+		const ShaderLanguage::ShaderNode::Uniform &uniform = p_result.uniforms[E.key];
+		CHECK(uniform.order == E.value.order);
+		CHECK(uniform.type == E.value.type);
+		CHECK(uniform.hint == E.value.hint);
+		CHECK(uniform.default_value.size() == E.value.default_value.size());
+	}
+	CHECK(p_result.gen_code.uniforms == p_expected.gen_code.uniforms);
+	CHECK(p_result.gen_code.uniform_offsets == p_expected.gen_code.uniform_offsets);
+	CHECK(p_result.gen_code.uniform_total_size == p_expected.gen_code.uniform_total_size);
+	CHECK(p_result.gen_code.defines == p_expected.gen_code.defines);
+	CHECK(p_result.gen_code.uses_fragment_time == p_expected.gen_code.uses_fragment_time);
+	CHECK(p_result.gen_code.code.size() == p_expected.gen_code.code.size());
+	for (const KeyValue<String, String> &E : p_expected.gen_code.code) {
+		CHECK(p_result.gen_code.code.has(E.key));
+		CHECK(p_result.gen_code.code.get(E.key) == E.value);
+	}
+}
+
+static const String cached_shader_code = R"(
+shader_type spatial;
+render_mode unshaded, cull_disabled;
+
+uniform vec4 tint : source_color = vec4(1.0);
+uniform float strength = 0.5;
+
+void fragment() {
+	ALBEDO = tint.rgb * sin(TIME);
+	ALPHA = strength;
+}
+)";
+
+TEST_CASE("[SceneTree][ShaderCompiler] Cached compilation replays the same result") {
+	ShaderCompiler compiler;
+	compiler.initialize(ShaderCompiler::DefaultIdentifierActions());
+
+	CompileResult first = compile_shader(compiler, cached_shader_code);
+	REQUIRE(first.err == OK);
+	CHECK(first.unshaded);
+	CHECK(first.cull_mode == 2);
+	CHECK(first.uses_time);
+	CHECK(first.writes_alpha);
+	CHECK(first.uniforms.has("tint"));
+	CHECK(first.uniforms.has("strength"));
+
+	CompileResult second = compile_shader(compiler, cached_shader_code);
+	REQUIRE(second.err == OK);
+	check_same_result(second, first);
+}
+
+TEST_CASE("[SceneTree][ShaderCompiler] Compilations are saved to disk for later runs") {
+	const String cache_dir = TestUtils::get_temp_path("shader_compiler_cache");
+	REQUIRE(DirAccess::make_dir_recursive_absolute(cache_dir) == OK);
+	for (const String &file : DirAccess::get_files_at(cache_dir)) {
+		DirAccess::remove_absolute(cache_dir.path_join(file));
+	}
+	ShaderCompiler::set_compile_cache_dir(cache_dir);
+
+	CompileResult first;
+	{
+		ShaderCompiler compiler;
+		compiler.initialize(ShaderCompiler::DefaultIdentifierActions());
+		first = compile_shader(compiler, cached_shader_code);
+	}
+	REQUIRE(first.err == OK);
+	const PackedStringArray files = DirAccess::get_files_at(cache_dir);
+	REQUIRE_MESSAGE(files.size() == 1, "The compilation should be saved to a single file.");
+
+	SUBCASE("A new compiler loads the saved compilation") {
+		ShaderCompiler compiler;
+		compiler.initialize(ShaderCompiler::DefaultIdentifierActions());
+		CompileResult loaded = compile_shader(compiler, cached_shader_code);
+		REQUIRE(loaded.err == OK);
+		check_same_result(loaded, first);
+		CHECK(DirAccess::get_files_at(cache_dir).size() == 1);
+	}
+
+	SUBCASE("Loading the file skips compilation") {
+		// Rename the uniform in the saved file only, the parser would never produce this.
+		const String path = cache_dir.path_join(files[0]);
+		Vector<uint8_t> bytes = FileAccess::get_file_as_bytes(path);
+		const CharString from = String("strength").utf8();
+		int replaced = 0;
+		for (int i = 0; i + from.length() <= bytes.size(); i++) {
+			if (memcmp(bytes.ptr() + i, from.get_data(), from.length()) == 0) {
+				bytes.write[i + from.length() - 1] = 'x';
+				replaced++;
+			}
+		}
+		REQUIRE(replaced > 0);
+		{
+			Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+			REQUIRE(f.is_valid());
+			f->store_buffer(bytes);
+		}
+
+		ShaderCompiler compiler;
+		compiler.initialize(ShaderCompiler::DefaultIdentifierActions());
+		CompileResult loaded = compile_shader(compiler, cached_shader_code);
+		REQUIRE(loaded.err == OK);
+		CHECK(loaded.uniforms.has("strengtx"));
+		CHECK_FALSE(loaded.uniforms.has("strength"));
+	}
+
+	SUBCASE("Different default actions don't share files") {
+		ShaderCompiler::DefaultIdentifierActions actions;
+		actions.renames["TIME"] = "global_time";
+		ShaderCompiler compiler;
+		compiler.initialize(actions);
+		REQUIRE(compile_shader(compiler, cached_shader_code).err == OK);
+		CHECK(DirAccess::get_files_at(cache_dir).size() == 2);
+	}
+
+	SUBCASE("A truncated file is compiled again") {
+		const String path = cache_dir.path_join(files[0]);
+		Vector<uint8_t> bytes = FileAccess::get_file_as_bytes(path);
+		{
+			Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+			REQUIRE(f.is_valid());
+			f->store_buffer(bytes.ptr(), bytes.size() / 2);
+		}
+
+		ShaderCompiler compiler;
+		compiler.initialize(ShaderCompiler::DefaultIdentifierActions());
+		CompileResult recompiled = compile_shader(compiler, cached_shader_code);
+		REQUIRE(recompiled.err == OK);
+		check_same_result(recompiled, first);
+		CHECK(FileAccess::get_file_as_bytes(path) == bytes);
+	}
+
+	ShaderCompiler::set_compile_cache_dir(String());
+}
+
+TEST_CASE("[SceneTree][ShaderCompiler] Only successful compilations are cached") {
+	ShaderCompiler compiler;
+	compiler.initialize(ShaderCompiler::DefaultIdentifierActions());
+
+	const String code = R"(
+shader_type spatial;
+
+void fragment() {
+	ALBEDO = undefined_identifier;
+}
+)";
+
+	ERR_PRINT_OFF;
+	CompileResult first = compile_shader(compiler, code);
+	CompileResult second = compile_shader(compiler, code);
+	ERR_PRINT_ON;
+
+	CHECK(first.err != OK);
+	CHECK(second.err != OK);
+}
+
+} // namespace TestShaderCompiler
@@ -0,0 +1,105 @@
+/**************************************************************************/
+/*  test_shader_language.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "servers/rendering/shader_language.h"
+#include "servers/rendering/shader_types.h"
+
+#include "tests/test_macros.h"
+
+namespace TestShaderLanguage {
+
+static String make_long_shader(int p_function_count, int p_edited_function = -1, const String &p_edit = String()) {
+	String code = "shader_type spatial;\n\nuniform float scale = 1.0;\n\n";
+	for (int i = 0; i < p_function_count; i++) {
+		code += vformat("float func_%d(float x) {\n", i);
+		code += vformat("\tfloat y = x * 1.5e0 + float(%d) * scale; // Step %d.\n", i, i);
+		if (i == p_edited_function) {
+			code += "\t" + p_edit + "\n";
+		}
+		code += "\treturn y;\n";
+		code += "}\n\n";
+	}
+	code += "void fragment() {\n\tALBEDO = vec3(func_0(1.0));\n}\n";
+	return code;
+}
+
+static ShaderLanguage::ShaderCompileInfo get_spatial_compile_info() {
+	ShaderLanguage::ShaderCompileInfo info;
+	info.functions = ShaderTypes::get_singleton()->get_functions(RS::SHADER_SPATIAL);
+	info.render_modes = ShaderTypes::get_singleton()->get_modes(RS::SHADER_SPATIAL);
+	info.stencil_modes = ShaderTypes::get_singleton()->get_stencil_modes(RS::SHADER_SPATIAL);
+	info.shader_types = ShaderTypes::get_singleton()->get_types();
+	return info;
+}
+
+TEST_CASE("[ShaderLanguage] Tokens are reused across edits") {
+	ShaderLanguage warm_parser;
+
+	const String original = make_long_shader(20);
+	CHECK(warm_parser.token_debug(original) == ShaderLanguage().token_debug(original));
+
+	Vector<String> edits;
+	edits.push_back(make_long_shader(20, 10, "y += 2.0;")); // Edit in the middle.
+	edits.push_back(make_long_shader(20, 10, "y += 2.0;\n\ty *= 0.5;\n\n")); // Add lines.
+	edits.push_back(make_long_shader(20, 0, "/* A block\ncomment. */")); // Comment near the start.
+	edits.push_back("// Header.\n" + make_long_shader(20)); // Everything shifted.
+	edits.push_back(make_long_shader(20).replace("1.5e0", "1.5e")); // Invalid constant.
+	edits.push_back(make_long_shader(19)); // Removed code.
+	edits.push_back(make_long_shader(19));
+
+	for (const String &edit : edits) {
+		CHECK(warm_parser.token_debug(edit) == ShaderLanguage().token_debug(edit));
+	}
+}
+
+TEST_CASE("[SceneTree][ShaderLanguage] Reparsing an edited shader gives the same result") {
+	const ShaderLanguage::ShaderCompileInfo info = get_spatial_compile_info();
+	ShaderLanguage warm_parser;
+
+	REQUIRE(warm_parser.compile(make_long_shader(20), info) == OK);
+
+	// An error in an edited function must be reported at the same line as a fresh parse.
+	const String broken = make_long_shader(20, 12, "y += undefined_identifier;");
+	ShaderLanguage fresh_parser;
+	CHECK(warm_parser.compile(broken, info) != OK);
+	CHECK(fresh_parser.compile(broken, info) != OK);
+	CHECK(warm_parser.get_error_line() == fresh_parser.get_error_line());
+	CHECK(warm_parser.get_error_text() == fresh_parser.get_error_text());
+
+	const String fixed = make_long_shader(20, 12, "y += scale;");
+	REQUIRE(warm_parser.compile(fixed, info) == OK);
+	REQUIRE(fresh_parser.compile(fixed, info) == OK);
+	CHECK(warm_parser.get_shader()->functions.size() == fresh_parser.get_shader()->functions.size());
+	CHECK(warm_parser.get_shader()->uniforms.size() == fresh_parser.get_shader()->uniforms.size());
+}
+
+} // namespace TestShaderLanguage
@@ -0,0 +1,182 @@
+/**************************************************************************/
+/*  test_benchmarks.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/os/os.h"
+#include "tests/scene/test_animation_mixer.h"
+#include "tests/servers/rendering/test_rendering_benchmark.h"
+#include "tests/servers/rendering/test_shader_language.h"
+
+#ifndef _3D_DISABLED
+#include "tests/scene/test_voxelizer.h"
+#endif // _3D_DISABLED
+
+#include "tests/test_macros.h"
+
+// Benchmarks reuse the scenes of the unit tests they belong to, at a size worth measuring.
+// They are skipped by default. Run them with:
+//   godot --test --test-case="*[Benchmark]*" --no-skip
+// Add a more specific pattern to --test-case to run only some of them.
+// Each benchmark prints its results as JSON. When the GODOT_BENCHMARK_FILE environment
+// variable is set, they are also appended to that file, one JSON object per line.
+
+namespace TestBenchmarks {
+
+static void report_benchmark(const String &p_name, const Variant &p_results) {
+	print_line(vformat("%s:\n%s", p_name, JSON::stringify(p_results, "\t")));
+
+	const String path = OS::get_singleton()->get_environment("GODOT_BENCHMARK_FILE");
+	if (path.is_empty()) {
+		return;
+	}
+
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ_WRITE);
+	if (f.is_null()) {
+		f = FileAccess::open(path, FileAccess::WRITE);
+	}
+	REQUIRE_MESSAGE(f.is_valid(), vformat("Could not write the benchmark results to \"%s\".", path));
+	f->seek_end();
+
+	Dictionary line;
+	line["benchmark"] = p_name;
+	line["results"] = p_results;
+	f->store_line(JSON::stringify(line));
+}
+
+TEST_CASE("[SceneTree][Benchmark] AnimationMixer crowd evaluation" * doctest::skip()) {
+	const int character_count = 500;
+	const int bone_count = 30;
+	const int frame_count = 120;
+
+	uint64_t serial_usec = 0;
+	uint64_t parallel_usec = 0;
+	TestAnimationMixer::run_crowd(false, character_count, bone_count, frame_count, &serial_usec);
+	TestAnimationMixer::run_crowd(true, character_count, bone_count, frame_count, &parallel_usec);
+
+	const double evaluations = double(character_count) * frame_count;
+	Dictionary result;
+	result["characters"] = character_count;
+	result["bones"] = bone_count;
+	result["frames"] = frame_count;
+	result["serial_characters_per_msec"] = serial_usec ? evaluations * 1000.0 / double(serial_usec) : 0.0;
+	result["parallel_characters_per_msec"] = parallel_usec ? evaluations * 1000.0 / double(parallel_usec) : 0.0;
+	report_benchmark("AnimationMixer crowd evaluation", result);
+}
+
+TEST_CASE("[SceneTree][Benchmark] RenderingServer stress scene" * doctest::skip()) {
+	using namespace TestRenderingBenchmark;
+
+	BenchmarkConfig config;
+	config.mesh_count = 50000;
+	config.light_count = 512;
+	config.shadowed_light_count = 64;
+	config.canvas_item_count = 50000;
+	config.occluder_count = 1000;
+	config.frame_count = 120;
+
+	// Same scene under each rendering/occlusion_culling/backend value.
+	Array results;
+	config.occlusion_backend = OCCLUSION_BACKEND_RASTER;
+	results.push_back(run_benchmark(config));
+	if (get_raycast_occlusion_backend()) {
+		config.occlusion_backend = OCCLUSION_BACKEND_RAYCAST;
+		results.push_back(run_benchmark(config));
+	} else {
+		MESSAGE("The raycast occlusion culling backend is not available, only the raster one was measured.");
+	}
+	report_benchmark("RenderingServer stress scene", results);
+}
+
+TEST_CASE("[SceneTree][Benchmark] ShaderLanguage reparse after edits" * doctest::skip()) {
+	using namespace TestShaderLanguage;
+
+	const ShaderLanguage::ShaderCompileInfo info = get_spatial_compile_info();
+	const int function_count = 600; // About 3000 lines.
+	const int edit_count = 50;
+
+	ShaderLanguage warm_parser;
+	REQUIRE(warm_parser.compile(make_long_shader(function_count), info) == OK);
+
+	uint64_t warm_usec = 0;
+	uint64_t cold_usec = 0;
+	for (int i = 0; i < edit_count; i++) {
+		const String edited = make_long_shader(function_count, (i * 37) % function_count, vformat("y += %d.0;", i));
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		CHECK(warm_parser.compile(edited, info) == OK);
+		warm_usec += OS::get_singleton()->get_ticks_usec() - begin;
+
+		ShaderLanguage cold_parser;
+		begin = OS::get_singleton()->get_ticks_usec();
+		CHECK(cold_parser.compile(edited, info) == OK);
+		cold_usec += OS::get_singleton()->get_ticks_usec() - begin;
+	}
+
+	Dictionary result;
+	result["lines"] = make_long_shader(function_count).get_slice_count("\n");
+	result["edits"] = edit_count;
+	result["warm_avg_msec"] = double(warm_usec) / edit_count / 1000.0;
+	result["cold_avg_msec"] = double(cold_usec) / edit_count / 1000.0;
+	report_benchmark("ShaderLanguage reparse after edits", result);
+}
+
+#ifndef _3D_DISABLED
+TEST_CASE("[SceneTree][Benchmark] Voxelizer bake throughput" * doctest::skip()) {
+	using namespace TestVoxelizer;
+
+	Vector<Ref<Mesh>> meshes;
+	meshes.push_back(create_sphere(256, 128));
+
+	// A grid of spheres, like a level made of many mid-sized meshes.
+	Vector<Transform3D> xforms;
+	for (int x = 0; x < 4; x++) {
+		for (int y = 0; y < 4; y++) {
+			for (int z = 0; z < 4; z++) {
+				xforms.push_back(Transform3D(Basis(), Vector3(x, y, z) * 2.5 - Vector3(3.75, 3.75, 3.75)));
+			}
+		}
+	}
+
+	const BakeOutput output = bake(8, AABB(Vector3(-5, -5, -5), Vector3(10, 10, 10)), meshes, xforms);
+	CHECK(output.plotted_faces > 0);
+
+	Dictionary result;
+	result["faces"] = output.plotted_faces;
+	result["cells"] = output.data_cells.size() / 16;
+	result["msec"] = double(output.usec) / 1000.0;
+	result["faces_per_second"] = output.usec ? double(output.plotted_faces) * 1000000.0 / double(output.usec) : 0.0;
+	report_benchmark("Voxelizer bake throughput", result);
+}
+#endif // _3D_DISABLED
+
+} // namespace TestBenchmarks
@@ -45,6 +45,7 @@
 #include "tests/core/input/test_input_event_mouse.h"
 #include "tests/core/input/test_shortcut.h"
 #include "tests/core/io/test_config_file.h"
+#include "tests/core/io/test_delta_encoding.h"
 #include "tests/core/io/test_file_access.h"
 #include "tests/core/io/test_http_client.h"
 #include "tests/core/io/test_image.h"
@@ -122,11 +123,13 @@
 #include "tests/core/variant/test_variant_utility.h"
 #include "tests/scene/test_animation.h"
 #include "tests/scene/test_animation_blend_tree.h"
+#include "tests/scene/test_animation_mixer.h"
 #include "tests/scene/test_audio_stream_wav.h"
 #include "tests/scene/test_bit_map.h"
 #include "tests/scene/test_button.h"
 #include "tests/scene/test_camera_2d.h"
 #include "tests/scene/test_control.h"
+#include "tests/scene/test_cpu_particles_2d.h"
 #include "tests/scene/test_curve.h"
 #include "tests/scene/test_curve_2d.h"
 #include "tests/scene/test_curve_3d.h"
@@ -151,11 +154,21 @@
 #include "tests/scene/test_viewport.h"
 #include "tests/scene/test_visual_shader.h"
 #include "tests/scene/test_window.h"
+#include "tests/servers/rendering/test_raster_occlusion_cull.h"
+#include "tests/servers/rendering/test_renderer_canvas_cull.h"
+#include "tests/servers/rendering/test_rendering_benchmark.h"
+#include "tests/servers/rendering/test_shader_compiler.h"
+#include "tests/servers/rendering/test_shader_language.h"
 #include "tests/servers/rendering/test_shader_preprocessor.h"
 #include "tests/servers/test_nav_heap.h"
 #include "tests/servers/test_text_server.h"
+#include "tests/test_benchmarks.h"
 #include "tests/test_validate_testing.h"
 
+#ifdef TOOLS_ENABLED
+#include "tests/editor/test_editor_export_platform.h"
+#endif // TOOLS_ENABLED
+
 #ifndef ADVANCED_GUI_DISABLED
 #include "tests/scene/test_code_edit.h"
 #include "tests/scene/test_color_picker.h"
@@ -174,6 +187,7 @@
 #include "tests/scene/test_camera_3d.h"
 #include "tests/scene/test_convert_transform_modifier_3d.h"
 #include "tests/scene/test_copy_transform_modifier_3d.h"
+#include "tests/scene/test_cpu_particles_3d.h"
 #include "tests/scene/test_decal.h"
 #include "tests/scene/test_gltf_document.h"
 #include "tests/scene/test_path_3d.h"
@@ -181,9 +195,11 @@
 #include "tests/scene/test_primitives.h"
 #include "tests/scene/test_skeleton_3d.h"
 #include "tests/scene/test_sky.h"
+#include "tests/scene/test_voxelizer.h"
 #endif // _3D_DISABLED
 
 #ifndef PHYSICS_3D_DISABLED
+#include "tests/scene/test_concave_polygon_shape_3d.h"
 #include "tests/scene/test_height_map_shape_3d.h"
 #include "tests/scene/test_physics_material.h"
 #endif // PHYSICS_3D_DISABLED